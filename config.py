@@ -105,9 +105,12 @@ class configuration:
   sources['gcc'] = ['openmoc/openmoc_wrap.cpp',
                     'src/Cell.cpp',
                     'src/Geometry.cpp',
+                    'src/GeometryGenerator.cpp',
+                    'src/InputDeck.cpp',
                     'src/LocalCoords.cpp',
                     'src/log.cpp',
                     'src/Material.cpp',
+                    'src/MemoryTracker.cpp',
                     'src/Point.cpp',
                     'src/PolarQuad.cpp',
                     'src/ExpEvaluator.cpp',
@@ -118,14 +121,19 @@ class configuration:
                     'src/Track.cpp',
                     'src/TrackGenerator.cpp',
                     'src/Universe.cpp',
-                    'src/Cmfd.cpp']
+                    'src/Cmfd.cpp',
+                    'src/Matrix.cpp',
+                    'src/BranchDriver.cpp']
 
   sources['clang'] = ['openmoc/openmoc_wrap.cpp',
                     'src/Cell.cpp',
                     'src/Geometry.cpp',
+                    'src/GeometryGenerator.cpp',
+                    'src/InputDeck.cpp',
                     'src/LocalCoords.cpp',
                     'src/log.cpp',
                     'src/Material.cpp',
+                    'src/MemoryTracker.cpp',
                     'src/Point.cpp',
                     'src/PolarQuad.cpp',
                     'src/ExpEvaluator.cpp',
@@ -136,14 +144,19 @@ class configuration:
                     'src/Track.cpp',
                     'src/TrackGenerator.cpp',
                     'src/Universe.cpp',
-                    'src/Cmfd.cpp']
+                    'src/Cmfd.cpp',
+                    'src/Matrix.cpp',
+                    'src/BranchDriver.cpp']
 
   sources['icpc'] = ['openmoc/openmoc_wrap.cpp',
                      'src/Cell.cpp',
                      'src/Geometry.cpp',
+                     'src/GeometryGenerator.cpp',
+                     'src/InputDeck.cpp',
                      'src/LocalCoords.cpp',
                      'src/log.cpp',
                      'src/Material.cpp',
+                     'src/MemoryTracker.cpp',
                      'src/Point.cpp',
                      'src/PolarQuad.cpp',
                      'src/ExpEvaluator.cpp',
@@ -155,14 +168,19 @@ class configuration:
                      'src/Track.cpp',
                      'src/TrackGenerator.cpp',
                      'src/Universe.cpp',
-                     'src/Cmfd.cpp']
+                     'src/Cmfd.cpp',
+                     'src/Matrix.cpp',
+                     'src/BranchDriver.cpp']
 
   sources['bgxlc'] = ['openmoc/openmoc_wrap.cpp',
                       'src/Cell.cpp',
                       'src/Geometry.cpp',
+                      'src/GeometryGenerator.cpp',
+                      'src/InputDeck.cpp',
                       'src/LocalCoords.cpp',
                       'src/log.cpp',
                       'src/Material.cpp',
+                      'src/MemoryTracker.cpp',
                       'src/Point.cpp',
                       'src/PolarQuad.cpp',
                       'src/ExpEvaluator.cpp',
@@ -173,7 +191,9 @@ class configuration:
                       'src/Track.cpp',
                       'src/TrackGenerator.cpp',
                       'src/Universe.cpp',
-                      'src/Cmfd.cpp']
+                      'src/Cmfd.cpp',
+                      'src/Matrix.cpp',
+                      'src/BranchDriver.cpp']
 
   sources['nvcc'] = ['openmoc/cuda/openmoc_cuda_wrap.cpp',
                      'src/accel/cuda/GPUExpEvaluator.cu',
@@ -181,6 +201,18 @@ class configuration:
                      'src/accel/cuda/clone.cu',
                      'src/accel/cuda/GPUSolver.cu']
 
+  # The name of the OpenMOC core library (libopenmoc), which is built from
+  # the C/C++ sources of the main openmoc module without the SWIG wrapper
+  core_library = 'openmoc'
+
+  # The source code for the openmoc-benchmark executable, which is linked
+  # to the static core library
+  benchmark_sources = ['profile/benchmark.cpp']
+
+  # The source code for the openmoc-driver executable, which runs a
+  # calculation from an input deck and is linked to the static core library
+  driver_sources = ['driver/driver.cpp']
+
 
   #############################################################################
   #                                Compiler Flags
@@ -238,6 +270,34 @@ class configuration:
                            '-Wl,-soname,' + get_openmoc_object_name()]
   linker_flags['nvcc'] = ['-shared', get_openmoc()]
 
+  # A dictionary of the linker flags for the shared core library
+  core_linker_flags = dict()
+
+  if ('macosx' in get_platform()):
+    core_linker_flags['gcc'] = ['-fopenmp', '-dynamiclib',
+                                '-Wl,-install_name,libopenmoc.dylib']
+    core_linker_flags['clang'] = ['-fopenmp', '-dynamiclib',
+                                  '-Wl,-install_name,libopenmoc.dylib']
+  else:
+    core_linker_flags['gcc'] = ['-fopenmp', '-shared',
+                                '-Wl,-soname,libopenmoc.so']
+    core_linker_flags['clang'] = ['-fopenmp', '-shared',
+                                  '-Wl,-soname,libopenmoc.so']
+
+  core_linker_flags['icpc'] = ['-openmp', '-shared',
+                               '-Xlinker', '-soname=libopenmoc.so']
+  core_linker_flags['bgxlc'] = ['-qsmp=omp', '-qmkshrobj', '-shared',
+                                '-Wl,-soname,libopenmoc.so']
+
+  # A dictionary of the linker flags for native executables linked to the
+  # core library, such as openmoc-benchmark
+  executable_linker_flags = dict()
+
+  executable_linker_flags['gcc'] = ['-fopenmp']
+  executable_linker_flags['clang'] = ['-fopenmp']
+  executable_linker_flags['icpc'] = ['-openmp']
+  executable_linker_flags['bgxlc'] = ['-qsmp=omp']
+
 
   #############################################################################
   #                               Shared Libraries
@@ -376,11 +436,11 @@ class configuration:
 
 
 
-  def setup_extension_modules(self):
-    """Sets up the C/C++/CUDA extension modules for this distribution.
+  def setup_build_modes(self):
+    """Appends the compiler flags and macros for the debug and profile modes.
 
-    Create list of extensions for Python modules within the openmoc
-    Python package based on the user-defined flags defined at compile time.
+    This is called before setting up the extension modules or the
+    openmoc-benchmark executable so that both are compiled alike.
     """
 
     # If the user wishes to compile using debug mode, append the debugging
@@ -389,6 +449,12 @@ class configuration:
       for k in self.compiler_flags:
         self.compiler_flags[k].append('-g')
 
+    # Otherwise, compile the DEBUG log messages out of the C++ source
+    else:
+      for cc in self.macros:
+        for fp in self.macros[cc]:
+          self.macros[cc][fp].append(('LOG_MIN_LEVEL', 'INFO'))
+
     # If the user wishes to compile using profile mode, append the profiling
     # flag to all lists of compiler flags for all distribution types
     if self.profile_mode:
@@ -396,6 +462,16 @@ class configuration:
         self.compiler_flags[k].append('-pg')
         self.compiler_flags[k].append('-g')
 
+
+  def setup_extension_modules(self):
+    """Sets up the C/C++/CUDA extension modules for this distribution.
+
+    Create list of extensions for Python modules within the openmoc
+    Python package based on the user-defined flags defined at compile time.
+    """
+
+    self.setup_build_modes()
+
     # If the user passed in the --no-numpy flag, tell SWIG not to embed
     # NumPy typemaps in the source code
     if not self.with_numpy:
@@ -442,3 +518,36 @@ class configuration:
                   define_macros = self.macros['nvcc'][self.fp],
                   swig_opts = self.swig_flags  + ['-DNVCC'],
                   export_symbols = ['init_openmoc']))
+
+
+  def setup_core_library(self):
+    """Sets up the OpenMOC core library for this distribution.
+
+    The library is built from the C/C++ sources of the main openmoc module
+    without the SWIG wrapper, and so has no dependency on Python. It may be
+    linked into native executables such as openmoc-benchmark. Returns a
+    dictionary of the sources, macros, include and library directories,
+    libraries and linker flags for the library and for executables.
+    """
+
+    self.setup_build_modes()
+
+    sources = [source for source in self.sources[self.cc]
+               if not source.startswith('openmoc/')]
+
+    core_linker_flags = copy.deepcopy(self.core_linker_flags[self.cc])
+    executable_linker_flags = \
+      copy.deepcopy(self.executable_linker_flags[self.cc])
+
+    if self.profile_mode:
+      core_linker_flags.append('-pg')
+      executable_linker_flags.append('-pg')
+
+    return {'name' : self.core_library,
+            'sources' : sources,
+            'macros' : self.macros[self.cc][self.fp],
+            'include_dirs' : self.include_directories[self.cc],
+            'library_dirs' : self.library_directories[self.cc],
+            'libraries' : self.shared_libraries[self.cc],
+            'linker_flags' : core_linker_flags,
+            'executable_linker_flags' : executable_linker_flags}
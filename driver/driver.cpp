@@ -0,0 +1,243 @@
+/**
+ * @file driver.cpp
+ * @brief A native driver which runs an OpenMOC calculation from an input
+ *        deck.
+ * @details This program reads the Geometry and calculation settings from an
+ *          input deck (see the InputDeck class), generates the Tracks and
+ *          solves the eigenvalue problem entirely in C++, without the
+ *          Python interpreter. The results are written to a binary file
+ *          which may be read with openmoc.process.read_driver_results(...).
+ *          The program is built with "python setup.py build_driver" and run
+ *          as follows:
+ *
+ * @code
+ *          ./build/openmoc-driver [-t threads] [-m MB] [-o file] input.deck
+ * @endcode
+ *
+ *          The number of threads, memory budget and results file given on
+ *          the command line replace those in the input deck.
+ *
+ * @date October 18, 2026
+ */
+
+#include "../src/CPUSolver.h"
+#include "../src/InputDeck.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+
+/**
+ * @def RESULTS_FILE_MAGIC
+ * @brief The magic string at the start of a driver results file.
+ */
+#define RESULTS_FILE_MAGIC "OMCRSLT"
+
+
+/**
+ * @def RESULTS_FILE_VERSION
+ * @brief The version of the driver results file format.
+ */
+#define RESULTS_FILE_VERSION 1
+
+
+/**
+ * @struct results_file_header
+ * @brief The fixed size header at the start of a driver results file.
+ * @details The header is followed by the FSR volumes and the FSR scalar
+ *          fluxes indexed by FSR and then energy group, each stored as a
+ *          contiguous array of FP_PRECISION values, and by the FSR fission
+ *          rates and the x and y coordinates of a point in each FSR, each
+ *          stored as a contiguous array of doubles.
+ */
+struct results_file_header {
+
+  /** The magic string identifying the file format */
+  char _magic[8];
+
+  /** The version of the file format */
+  uint32_t _version;
+
+  /** The size in bytes of each floating point value (4 or 8) */
+  uint32_t _precision;
+
+  /** The number of FSRs */
+  int32_t _num_FSRs;
+
+  /** The number of energy groups */
+  int32_t _num_groups;
+
+  /** The number of source iterations completed */
+  uint64_t _num_iterations;
+
+  /** The total number of Tracks */
+  uint64_t _num_tracks;
+
+  /** The total number of segments */
+  uint64_t _num_segments;
+
+  /** The eigenvalue */
+  double _k_eff;
+
+  /** The time to generate the Tracks (seconds) */
+  double _track_time;
+
+  /** The time to solve the eigenvalue problem (seconds) */
+  double _solve_time;
+};
+
+
+/**
+ * @brief Writes the results of a calculation to a binary file.
+ * @param filename the name of the results file
+ * @param solver the Solver of the calculation
+ * @param track_time the time to generate the Tracks (seconds)
+ */
+static void write_results(const char* filename, Solver* solver,
+                          double track_time) {
+
+  TrackGenerator* track_generator = solver->getTrackGenerator();
+  Geometry* geometry = solver->getGeometry();
+  int num_FSRs = geometry->getNumFSRs();
+  int num_groups = geometry->getNumEnergyGroups();
+
+  log_printf(NORMAL, "Writing the results to %s...", filename);
+
+  results_file_header header;
+  memset(&header, 0, sizeof(header));
+  strncpy(header._magic, RESULTS_FILE_MAGIC, sizeof(header._magic));
+  header._version = RESULTS_FILE_VERSION;
+  header._precision = sizeof(FP_PRECISION);
+  header._num_FSRs = num_FSRs;
+  header._num_groups = num_groups;
+  header._num_iterations = solver->getNumIterations();
+  header._num_tracks = track_generator->getNumTracks();
+  header._num_segments = track_generator->getNumSegments();
+  header._k_eff = solver->getKeff();
+  header._track_time = track_time;
+  header._solve_time = solver->getTotalTime();
+
+  std::vector<FP_PRECISION> volumes(num_FSRs);
+  std::vector<FP_PRECISION> fluxes(size_t(num_FSRs) * num_groups);
+  std::vector<double> fission_rates(num_FSRs);
+  std::vector<double> points(2 * size_t(num_FSRs));
+
+  for (int r=0; r < num_FSRs; r++) {
+    volumes[r] = track_generator->getFSRVolume(r);
+    Point* point = geometry->getFSRPoint(r);
+    points[r] = point->getX();
+    points[num_FSRs + r] = point->getY();
+  }
+
+  solver->getFluxes(&fluxes[0], fluxes.size());
+  solver->computeFSRFissionRates(&fission_rates[0], num_FSRs);
+
+  FILE* out = fopen(filename, "wb");
+  if (out == NULL)
+    log_printf(ERROR, "Unable to open %s to write the results", filename);
+
+  bool written = (fwrite(&header, sizeof(header), 1, out) == 1) &&
+    (fwrite(&volumes[0], sizeof(FP_PRECISION), volumes.size(), out) ==
+     volumes.size()) &&
+    (fwrite(&fluxes[0], sizeof(FP_PRECISION), fluxes.size(), out) ==
+     fluxes.size()) &&
+    (fwrite(&fission_rates[0], sizeof(double), fission_rates.size(), out) ==
+     fission_rates.size()) &&
+    (fwrite(&points[0], sizeof(double), points.size(), out) ==
+     points.size());
+
+  written = (fclose(out) == 0) && written;
+
+  if (!written)
+    log_printf(ERROR, "Unable to write the results to %s", filename);
+}
+
+
+/**
+ * @brief Prints the command line options of the driver.
+ * @param program the name of the program
+ */
+static void print_usage(const char* program) {
+  printf("Usage: %s [options] input.deck\n"
+         "  -t threads     number of OpenMP threads (default from the deck)\n"
+         "  -m MB          memory budget in MB (default from the deck)\n"
+         "  -o file        write the results to a binary file\n",
+         program);
+}
+
+
+int main(int argc, char** argv) {
+
+  int num_threads = 0;
+  double memory_budget = -1.;
+  std::string output_filename;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "t:m:o:h")) != -1) {
+    switch (opt) {
+    case 't': num_threads = atoi(optarg); break;
+    case 'm': memory_budget = atof(optarg); break;
+    case 'o': output_filename = optarg; break;
+    default:
+      print_usage(argv[0]);
+      return (opt == 'h') ? 0 : 1;
+    }
+  }
+
+  if (optind != argc - 1 || num_threads < 0) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  try {
+
+    InputDeck deck(argv[optind]);
+
+    if (num_threads == 0)
+      num_threads = deck.getNumThreads();
+    if (output_filename.empty())
+      output_filename = deck.getOutputFilename();
+    if (memory_budget >= 0.)
+      MemoryTracker::Get()->setBudget(size_t(memory_budget * 1.E6));
+
+    /* Ray tracing */
+    TrackGenerator track_generator(deck.getGeometry(), deck.getNumAzim(),
+                                   deck.getTrackSpacing());
+    track_generator.setNumThreads(num_threads);
+
+    double start_time = omp_get_wtime();
+    track_generator.generateTracks();
+    double track_time = omp_get_wtime() - start_time;
+
+    /* The eigenvalue calculation */
+    CPUSolver solver(&track_generator);
+    solver.setNumThreads(num_threads);
+    solver.setConvergenceThreshold(deck.getTolerance());
+
+    if (deck.getPolarQuadrature() != NULL)
+      solver.setPolarQuadrature(deck.getPolarQuadrature());
+
+    if (deck.isUsingExponentialInterpolation())
+      solver.useExponentialInterpolation();
+    else
+      solver.useExponentialIntrinsic();
+
+    solver.computeEigenvalue(deck.getMaxIterations());
+    solver.printTimerReport();
+    MemoryTracker::Get()->printReport();
+
+    if (!output_filename.empty())
+      write_results(output_filename.c_str(), &solver, track_time);
+  }
+  catch (std::exception& e) {
+    log_flush();
+    fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+
+  log_flush();
+  return 0;
+}
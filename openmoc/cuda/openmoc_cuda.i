@@ -7,8 +7,6 @@
 %{
   #define SWIG_FILE_WITH_INIT
 
-  #define PySys_WriteStdout printf
-
   #include <cstddef>
   #include "../../src/constants.h"
   #include "../../src/Solver.h"
@@ -55,6 +53,10 @@
  * openmoc.process */
 %apply (double* ARGOUT_ARRAY1, int DIM1) {(double* fission_rates, int num_FSRs)}
 
+/* The typemap used to match the method signature for the Solver's
+ * rebindFSRMaterials method */
+%apply (int* IN_ARRAY1, int DIM1) {(int* fsr_ids, int num_fsr_ids)}
+
 
 #endif
 
@@ -66,8 +68,6 @@
 %include ../../src/accel/cuda/GPUQuery.h
 %include ../../src/accel/cuda/clone.h
 
-#define PySys_WriteStdout printf
-
 #ifdef DOUBLE
 typedef double FP_PRECISION;
 #else
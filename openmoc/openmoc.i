@@ -10,6 +10,8 @@
   #include "../src/constants.h"
   #include "../src/Cell.h"
   #include "../src/Geometry.h"
+  #include "../src/GeometryGenerator.h"
+  #include "../src/InputDeck.h"
   #include "../src/LocalCoords.h"
   #include "../src/log.h"
   #include "../src/Material.h"
@@ -20,16 +22,32 @@
   #include "../src/boundary_type.h"
   #include "../src/Surface.h"
   #include "../src/Timer.h"
+  #include "../src/MemoryTracker.h"
   #include "../src/Track.h"
   #include "../src/TrackGenerator.h"
   #include "../src/Universe.h"
+  #include "../src/Matrix.h"
   #include "../src/Cmfd.h"
+  #include "../src/BranchDriver.h"
 
   #ifdef ICPC
   #include "../src/VectorizedSolver.h"
   #endif
 
-  #define printf PySys_WriteStdout
+  /* Writes the log messages through the interpreter's sys.stdout, one line
+   * at a time since Python truncates long writes */
+  static void write_python_stdout(const char* messages, int length) {
+
+    const char* line = messages;
+    const char* end = messages + length;
+
+    while (line < end) {
+      const char* newline = (const char*)memchr(line, '\n', end - line);
+      int line_length = (newline != NULL) ? newline - line + 1 : end - line;
+      PySys_WriteStdout("%.*s", line_length, line);
+      line += line_length;
+    }
+  }
 
   /* Exception helpers */
   static int swig_c_error_num = 0;
@@ -50,6 +68,11 @@
 
 %}
 
+/* Print the log messages through the interpreter rather than to stdout */
+%init %{
+  set_log_writer(write_python_stdout);
+%}
+
 %warnfilter(506) log_printf(logLevel level, const char *format, ...);
 %warnfilter(511) swig::SwigPyIterator;
 %warnfilter(511) Cell::setFill;
@@ -233,11 +256,21 @@
  * structure using a NumPy array */
 %apply (int* IN_ARRAY1, int DIM1) {(int* group_indices, int length_group_indices)}
 
+/* The typemap used to match the method signature for the TrackGenerator's
+ * and Solver's rebindFSRMaterials methods. This allows users to assign a
+ * Material to FSRs using a NumPy array of FSR IDs */
+%apply (int* IN_ARRAY1, int DIM1) {(int* fsr_ids, int num_fsr_ids)}
+
 /* The typemap used to match the method signature for the Material
  * cross-section setter methods. This allows users to set the cross-sections
  * using NumPy arrays */
 %apply (double* IN_ARRAY1, int DIM1) {(double* xs, int num_groups)}
 
+/* The typemap used to match the method signature for the BranchDriver's
+ * addCase method. This allows users to give each case's state parameters
+ * using NumPy arrays */
+%apply (double* IN_ARRAY1, int DIM1) {(double* parameters, int num_parameters)}
+
 /* The typemap used to match the method signature for the TrackGenerator's
  * getter methods for track start and end coordinates for the plotting
  * routines in openmoc.plotter */
@@ -253,6 +286,28 @@
  * openmoc.process */
 %apply (double* ARGOUT_ARRAY1, int DIM1) {(double* fission_rates, int num_FSRs)}
 
+/* The typemap used to match the method signature for the Solver's
+ * getSweepCounters method. This allows users to retrieve the hardware
+ * counts of the transport sweep in each source iteration as a NumPy array */
+%apply (double* ARGOUT_ARRAY1, int DIM1) {(double* counters, int num_values)}
+
+/* The typemap used to match the method signature for the Solver's
+ * getConvergenceHistory method. This allows users to retrieve the
+ * convergence history of a calculation as a NumPy array */
+%apply (double* ARGOUT_ARRAY1, int DIM1) {(double* history, int num_values)}
+
+/* The typemaps used to match the method signatures for the Solver's
+ * getFluxes, setFluxes, getBoundaryFluxes and setBoundaryFluxes methods.
+ * This allows users to save and restore the fluxes for warm starts using
+ * NumPy arrays of the floating point precision */
+#ifdef DOUBLE
+%apply (double* ARGOUT_ARRAY1, int DIM1) {(FP_PRECISION* out_fluxes, int num_fluxes)}
+%apply (double* IN_ARRAY1, int DIM1) {(FP_PRECISION* in_fluxes, int num_fluxes)}
+#else
+%apply (float* ARGOUT_ARRAY1, int DIM1) {(FP_PRECISION* out_fluxes, int num_fluxes)}
+%apply (float* IN_ARRAY1, int DIM1) {(FP_PRECISION* in_fluxes, int num_fluxes)}
+#endif
+
 /* The typemap used to match the method signature for the Universe's
  * getCellIds method for the data processing routines in openmoc.process */
 %apply (int* ARGOUT_ARRAY1, int DIM1) {(int* cell_ids, int num_cells)}
@@ -410,10 +465,13 @@
 
 
 %include <exception.i>
+%include <stdint.i>
 %include <std_map.i>
 %include ../src/constants.h
 %include ../src/Cell.h
 %include ../src/Geometry.h
+%include ../src/GeometryGenerator.h
+%include ../src/InputDeck.h
 %include ../src/LocalCoords.h
 %include ../src/log.h
 %include ../src/Material.h
@@ -424,17 +482,18 @@
 %include ../src/boundary_type.h
 %include ../src/Surface.h
 %include ../src/Timer.h
+%include ../src/MemoryTracker.h
 %include ../src/Track.h
 %include ../src/TrackGenerator.h
 %include ../src/Universe.h
+%include ../src/Matrix.h
 %include ../src/Cmfd.h
+%include ../src/BranchDriver.h
 
 #ifdef ICPC
 %include ../src/VectorizedSolver.h
 #endif
 
-#define printf PySys_WriteStdout
-
 #ifdef DOUBLE
 typedef double FP_PRECISION;
 #else
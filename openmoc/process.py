@@ -609,6 +609,7 @@ def restore_simulation_state(filename='simulation-state.h5',
 # @param filename the OpenMOC log filename string
 # @param directory the directory where to find the log file
 # @return a Python dictionary of key/value pairs for convergence data
+# @see get_convergence_history to retrieve the data from the Solver instead
 def parse_convergence_data(filename, directory=''):
 
   # If the user specified a directory
@@ -646,3 +647,163 @@ def parse_convergence_data(filename, directory=''):
   convergence_data['eigenvalues'] = eigenvalues
   convergence_data['residuals'] = residuals
   return convergence_data
+
+
+
+##
+# @brief This routine returns the convergence history of the last
+#        calculation recorded by the Solver.
+# @details The history is returned in a Python dictionary of NumPy arrays
+#          indexed by iteration under the keys 'iterations', 'eigenvalues',
+#          'residuals', 'cmfd eigenvalues', 'cmfd iterations', 'sweep times',
+#          'segment rates' and 'integration rates', along with an integer
+#          `# iters`. The keys shared with parse_convergence_data(...) hold
+#          the same data without parsing a log file. The history may also be
+#          streamed to a CSV or JSON lines file during the calculation with
+#          Solver.setHistoryFile(...).
+#
+#          This method may be called from Python as follows:
+# @code
+#          solver.computeEigenvalue()
+#          history = get_convergence_history(solver)
+# @endcode
+#
+# @param solver a pointer to a Solver class object
+# @return a Python dictionary of the quantities recorded for each iteration
+def get_convergence_history(solver):
+
+  num_iters = solver.getNumHistoryIterations()
+  num_quantities = 8
+
+  if num_iters == 0:
+    history = np.zeros((0, num_quantities))
+  else:
+    history = solver.getConvergenceHistory(num_iters * num_quantities)
+    history = history.reshape((num_iters, num_quantities))
+
+  # Store the data in a dictionary to return to the user
+  convergence_data = dict()
+  convergence_data['# iters'] = num_iters
+  convergence_data['iterations'] = \
+      history[:,openmoc.HISTORY_ITERATION].astype(int)
+  convergence_data['eigenvalues'] = history[:,openmoc.HISTORY_K_EFF]
+  convergence_data['residuals'] = history[:,openmoc.HISTORY_RESIDUAL]
+  convergence_data['cmfd eigenvalues'] = history[:,openmoc.HISTORY_CMFD_K_EFF]
+  convergence_data['cmfd iterations'] = \
+      history[:,openmoc.HISTORY_CMFD_ITERATIONS].astype(int)
+  convergence_data['sweep times'] = history[:,openmoc.HISTORY_SWEEP_TIME]
+  convergence_data['segment rates'] = history[:,openmoc.HISTORY_SEGMENT_RATE]
+  convergence_data['integration rates'] = \
+      history[:,openmoc.HISTORY_INTEGRATION_RATE]
+  return convergence_data
+
+##
+# @brief This routine returns the hardware counts of the transport sweep in
+#        each source iteration of the last calculation.
+# @details The counts are recorded when hardware counters have been turned on
+#          before the calculation with openmoc.Timer.setHardwareCounters(True)
+#          on Linux systems which permit perf events. The counts are summed
+#          over all threads and returned in a Python dictionary of NumPy
+#          arrays indexed by source iteration under the keys 'cycles',
+#          'instructions', 'llc misses' and 'vector instructions', along
+#          with the instructions per cycle under the key 'ipc'. Counters
+#          which are unavailable on the processor are zero.
+#
+#          This method may be called from Python as follows:
+# @code
+#          openmoc.Timer.setHardwareCounters(True)
+#          solver.computeEigenvalue()
+#          counters = get_sweep_counters(solver)
+# @endcode
+#
+# @param solver a pointer to a Solver class object
+# @return a Python dictionary of the hardware counts in each iteration
+def get_sweep_counters(solver):
+
+  num_iters = solver.getNumCounterIterations()
+  num_counters = 4
+
+  if num_iters == 0:
+    py_printf('WARNING', 'No hardware counts have been recorded for the ' + \
+              'transport sweep')
+    counters = np.zeros((0, num_counters))
+  else:
+    counters = solver.getSweepCounters(num_iters * num_counters)
+    counters = counters.reshape((num_iters, num_counters))
+
+  # Store the counts in a dictionary to return to the user
+  sweep_counters = dict()
+  sweep_counters['cycles'] = counters[:,openmoc.CYCLES]
+  sweep_counters['instructions'] = counters[:,openmoc.INSTRUCTIONS]
+  sweep_counters['llc misses'] = counters[:,openmoc.LLC_MISSES]
+  sweep_counters['vector instructions'] = \
+      counters[:,openmoc.VECTOR_INSTRUCTIONS]
+
+  cycles = np.maximum(sweep_counters['cycles'], 1)
+  sweep_counters['ipc'] = sweep_counters['instructions'] / cycles
+  return sweep_counters
+
+##
+# @brief This routine reads the results file written by the openmoc-driver
+#        executable.
+# @details The results are returned in a Python dictionary with the keys
+#          'k_eff', '# iters', '# tracks', '# segments', 'track time' and
+#          'solve time', along with NumPy arrays of the 'FSR volumes', the
+#          'fluxes' indexed by FSR and energy group, the 'fission rates' and
+#          the 'FSR points' indexed by FSR and then x or y coordinate. The
+#          arrays may be used to plot the results of a calculation which was
+#          run from an input deck without the Python interface.
+#
+#          This method may be called from Python as follows:
+# @code
+#          results = read_driver_results('results.bin')
+# @endcode
+#
+# @param filename the name of the results file
+# @return a Python dictionary of the results
+def read_driver_results(filename):
+
+  header_type = np.dtype([('magic', 'S8'), ('version', '<u4'),
+                          ('precision', '<u4'), ('num FSRs', '<i4'),
+                          ('num groups', '<i4'), ('num iters', '<u8'),
+                          ('num tracks', '<u8'), ('num segments', '<u8'),
+                          ('k_eff', '<f8'), ('track time', '<f8'),
+                          ('solve time', '<f8')])
+
+  with open(filename, 'rb') as results_file:
+
+    header = np.fromfile(results_file, dtype=header_type, count=1)
+
+    if len(header) != 1 or header['magic'][0] != b'OMCRSLT':
+      py_printf('ERROR', 'Unable to read %s since it is not an ' + \
+                'openmoc-driver results file', filename)
+    if header['version'][0] != 1:
+      py_printf('ERROR', 'Unable to read %s since its version %d is not ' + \
+                'supported', filename, header['version'][0])
+
+    num_FSRs = int(header['num FSRs'][0])
+    num_groups = int(header['num groups'][0])
+    precision = '<f%d' % header['precision'][0]
+
+    volumes = np.fromfile(results_file, dtype=precision, count=num_FSRs)
+    fluxes = np.fromfile(results_file, dtype=precision,
+                         count=num_FSRs*num_groups)
+    fission_rates = np.fromfile(results_file, dtype='<f8', count=num_FSRs)
+    points = np.fromfile(results_file, dtype='<f8', count=2*num_FSRs)
+
+  if len(points) != 2*num_FSRs:
+    py_printf('ERROR', 'Unable to read %s since it is truncated', filename)
+
+  # Store the data in a dictionary to return to the user
+  results = dict()
+  results['k_eff'] = header['k_eff'][0]
+  results['# iters'] = int(header['num iters'][0])
+  results['# tracks'] = int(header['num tracks'][0])
+  results['# segments'] = int(header['num segments'][0])
+  results['track time'] = header['track time'][0]
+  results['solve time'] = header['solve time'][0]
+  results['FSR volumes'] = volumes
+  results['fluxes'] = fluxes.reshape((num_FSRs, num_groups))
+  results['fission rates'] = fission_rates
+  results['FSR points'] = points.reshape((2, num_FSRs)).T
+  return results
@@ -0,0 +1,567 @@
+/**
+ * @file benchmark.cpp
+ * @brief A standalone microbenchmark of OpenMOC's core computational kernels.
+ * @details This program times the kernels which dominate the runtime of an
+ *          MOC calculation on a synthetic lattice of pin cells built by the
+ *          GeometryGenerator and on the 2D LRA benchmark from the sample
+ *          inputs, without going through the Python interface. It reports
+ *          the following rates for each workload so that builds, compilers
+ *          and machines may be compared:
+ *
+ *          - ExpEvaluator::computeExponential in ns per evaluation
+ *          - Geometry::segmentize in Tracks and segments per second
+ *          - The transport sweep (tallyScalarFlux) in ns per segment,
+ *            energy group and polar angle
+ *          - computeFSRSources in ns per FSR and energy group
+ *          - The CMFD eigenvalue solve and Cmfd::linearSolve in iterations
+ *            per second
+ *
+ *          The kernels are timed with the phases of the Timer and with the
+ *          counters kept by the Solver and Cmfd. The program is linked to
+ *          the core library, which does not depend on Python. It is built
+ *          with "python setup.py build_benchmark" and run as follows:
+ *
+ * @code
+ *          ./build/openmoc-benchmark [-t threads] [-i iterations] [-p pins]
+ *                                    [-d depth] [-g groups] [-w workload]
+ *                                    [-o file.csv]
+ * @endcode
+ *
+ * @date October 18, 2026
+ */
+
+#include "../src/CPUSolver.h"
+#include "../src/Cmfd.h"
+#include "../src/GeometryGenerator.h"
+#include <ftw.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+
+/**
+ * @struct benchmarkOptions
+ * @brief The user-defined parameters of a benchmark run.
+ */
+struct benchmarkOptions {
+
+  /** The number of OpenMP threads */
+  int num_threads;
+
+  /** The number of source iterations timed for each workload */
+  int num_iterations;
+
+  /** The number of Lattice cells along each side of each level of the
+   *  synthetic lattice */
+  int num_pins;
+
+  /** The number of levels of Lattices in the synthetic lattice */
+  int nesting_depth;
+
+  /** The number of energy groups in the synthetic lattice */
+  int num_groups;
+
+  /** The workload to run ("pins", "lra" or "all") */
+  std::string workload;
+
+  /** The name of a CSV file for the results (empty if none) */
+  std::string csv_filename;
+};
+
+
+/**
+ * @struct benchmarkWorkload
+ * @brief A Geometry to time the kernels on and the ray tracing parameters.
+ */
+struct benchmarkWorkload {
+
+  /** The name of the workload in the report */
+  const char* name;
+
+  /** The Geometry of the workload */
+  Geometry* geometry;
+
+  /** The number of azimuthal angles */
+  int num_azim;
+
+  /** The Track spacing (cm) */
+  double spacing;
+
+  /** The GeometryGenerator of a synthetic workload (NULL if none) */
+  GeometryGenerator* generator;
+};
+
+
+/** The CSV file for the results (NULL if none) */
+static FILE* csv_file = NULL;
+
+
+/**
+ * @brief A CPUSolver which exposes its kernels to the benchmark.
+ */
+class BenchmarkSolver : public CPUSolver {
+
+public:
+
+  /**
+   * @brief Constructor for a BenchmarkSolver.
+   * @param track_generator an optional pointer to a TrackGenerator
+   */
+  BenchmarkSolver(TrackGenerator* track_generator=NULL)
+    : CPUSolver(track_generator) { }
+
+  /**
+   * @brief Returns the number of energy groups times polar angles swept
+   *        for each segment.
+   * @return the number of energy groups times polar angles
+   */
+  int getPolarTimesGroups() {
+    return _polar_times_groups;
+  }
+};
+
+
+/**
+ * @brief Reports the rate of a kernel and adds it to the CSV file.
+ * @param workload the name of the workload
+ * @param kernel the name of the kernel
+ * @param value the rate of the kernel
+ * @param units the units of the rate
+ */
+static void report(const char* workload, const char* kernel, double value,
+                   const char* units) {
+
+  log_printf(RESULT, "%-8s%-28s%1.4E %s", workload, kernel, value, units);
+
+  if (csv_file != NULL) {
+    fprintf(csv_file, "%s,%s,%.8e,%s\n", workload, kernel, value, units);
+    fflush(csv_file);
+  }
+}
+
+
+/**
+ * @brief Removes a file or directory while walking a directory tree.
+ * @param path the path of the file or directory
+ * @param sb the status of the file (unused)
+ * @param flag the type of the file (unused)
+ * @param ftwbuf the depth of the file (unused)
+ * @return the status of the removal
+ */
+static int remove_path(const char* path, const struct stat* sb, int flag,
+                       struct FTW* ftwbuf) {
+  return remove(path);
+}
+
+
+/**
+ * @brief Creates a synthetic lattice of pin cells with one CMFD cell for
+ *        each pin.
+ * @param generator the GeometryGenerator for the lattice
+ * @return a pointer to the Geometry
+ */
+static Geometry* create_pin_lattice(GeometryGenerator& generator) {
+
+  Geometry* geometry = generator.generateGeometry();
+
+  Cmfd* cmfd = new Cmfd();
+  cmfd->setLatticeStructure(generator.getNumPinsX(), generator.getNumPinsY());
+  geometry->setCmfd(cmfd);
+  geometry->initializeFlatSourceRegions();
+
+  return geometry;
+}
+
+
+/**
+ * @brief Creates the 2D LRA benchmark as in sample-input/benchmarks/LRA.
+ * @return a pointer to the Geometry
+ */
+static Geometry* create_lra() {
+
+  double sigma_t[6][2] = {{0.2656, 1.5798}, {0.2629, 1.7525},
+                          {0.2648, 1.5941}, {0.2648, 1.5941},
+                          {0.2648, 1.5941}, {0.2652, 2.0938}};
+  double sigma_s[6][4] = {{0.231892, 0.02533, 0.0, 1.47948},
+                          {0.22792, 0.02767, 0.0, 1.68201},
+                          {0.230502, 0.02617, 0.0, 1.510639},
+                          {0.230462, 0.02617, 0.0, 1.520789},
+                          {0.230462, 0.02617, 0.0, 1.510672},
+                          {0.216931, 0.04754, 0.0, 2.074676}};
+  double nu_sigma_f[6][2] = {{0.004602, 0.1091}, {0.004609, 0.08675},
+                             {0.004663, 0.1021}, {0.004663, 0.1021},
+                             {0.004663, 0.1021}, {0.0, 0.0}};
+  double sigma_f[6][2] = {{0.002, 0.05}, {0.002, 0.045}, {0.002, 0.045},
+                          {0.002, 0.045}, {0.002, 0.045}, {0.0, 0.0}};
+  double sigma_a[6][2] = {{0.008252, 0.1003}, {0.007181, 0.07047},
+                          {0.008002, 0.08344}, {0.008002, 0.073324},
+                          {0.008002, 0.08344}, {0.0006034, 0.01911}};
+
+  /* Fill each region with a 10x10 lattice of homogeneous 1.5 cm cells */
+  Universe* regions[6];
+
+  for (int r=0; r < 6; r++) {
+
+    Material* material = new Material(r+1);
+    double chi[2] = {(r < 5) ? 1.0 : 0.0, 0.0};
+    material->setNumEnergyGroups(2);
+    material->setSigmaT(sigma_t[r], 2);
+    material->setSigmaA(sigma_a[r], 2);
+    material->setSigmaS(sigma_s[r], 4);
+    material->setSigmaF(sigma_f[r], 2);
+    material->setNuSigmaF(nu_sigma_f[r], 2);
+    material->setChi(chi, 2);
+
+    Cell* cell = new Cell();
+    cell->setFill(material);
+    Universe* universe = new Universe();
+    universe->addCell(cell);
+
+    Universe* universes[100];
+    for (int i=0; i < 100; i++)
+      universes[i] = universe;
+
+    Lattice* assembly = new Lattice();
+    assembly->setWidth(1.5, 1.5);
+    assembly->setUniverses(10, 10, universes);
+
+    Cell* assembly_cell = new Cell();
+    assembly_cell->setFill(assembly);
+    regions[r] = new Universe();
+    regions[r]->addCell(assembly_cell);
+  }
+
+  int core_template[11][11] = {{5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5},
+                               {5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5},
+                               {2, 2, 2, 2, 2, 2, 2, 5, 5, 5, 5},
+                               {2, 2, 2, 2, 2, 2, 2, 3, 5, 5, 5},
+                               {1, 0, 0, 0, 0, 1, 1, 4, 4, 5, 5},
+                               {1, 0, 0, 0, 0, 1, 1, 4, 4, 5, 5},
+                               {0, 0, 0, 0, 0, 0, 0, 2, 2, 5, 5},
+                               {0, 0, 0, 0, 0, 0, 0, 2, 2, 5, 5},
+                               {0, 0, 0, 0, 0, 0, 0, 2, 2, 5, 5},
+                               {0, 0, 0, 0, 0, 0, 0, 2, 2, 5, 5},
+                               {1, 0, 0, 0, 0, 1, 1, 2, 2, 5, 5}};
+
+  Universe* universes[121];
+  for (int i=0; i < 11; i++) {
+    for (int j=0; j < 11; j++)
+      universes[i*11+j] = regions[core_template[i][j]];
+  }
+
+  Lattice* core = new Lattice();
+  core->setWidth(15.0, 15.0);
+  core->setUniverses(11, 11, universes);
+
+  XPlane* left = new XPlane(-82.5);
+  XPlane* right = new XPlane(82.5);
+  YPlane* bottom = new YPlane(-82.5);
+  YPlane* top = new YPlane(82.5);
+  left->setBoundaryType(REFLECTIVE);
+  right->setBoundaryType(VACUUM);
+  bottom->setBoundaryType(REFLECTIVE);
+  top->setBoundaryType(VACUUM);
+
+  Cell* root_cell = new Cell();
+  root_cell->setFill(core);
+  root_cell->addSurface(+1, left);
+  root_cell->addSurface(-1, right);
+  root_cell->addSurface(+1, bottom);
+  root_cell->addSurface(-1, top);
+
+  Universe* root_universe = new Universe();
+  root_universe->addCell(root_cell);
+
+  Cmfd* cmfd = new Cmfd();
+  cmfd->setLatticeStructure(110, 110);
+
+  Geometry* geometry = new Geometry();
+  geometry->setRootUniverse(root_universe);
+  geometry->setCmfd(cmfd);
+  geometry->initializeFlatSourceRegions();
+
+  return geometry;
+}
+
+
+/**
+ * @brief Times ExpEvaluator::computeExponential with the interpolation
+ *        table and with the intrinsic exponential.
+ * @param options the benchmark options
+ */
+static void benchmark_exponential(benchmarkOptions& options) {
+
+  int num_polar = 3;
+  int num_taus = 1 << 20;
+  int num_repeats = 20;
+  FP_PRECISION max_tau = 10.;
+
+  TYPolarQuad* polar_quad = new TYPolarQuad();
+  polar_quad->setNumPolarAngles(num_polar);
+  polar_quad->initialize();
+
+  /* Optical lengths spread over the table with a fixed pseudo-random
+   * sequence so that each build evaluates the same exponentials */
+  std::vector<FP_PRECISION> taus(num_taus);
+  unsigned int seed = 1;
+  for (int i=0; i < num_taus; i++) {
+    seed = 1103515245 * seed + 12345;
+    taus[i] = max_tau * (seed % 1000003) / 1000003.;
+  }
+
+  for (int interpolate=1; interpolate >= 0; interpolate--) {
+
+    ExpEvaluator* exp_evaluator = new ExpEvaluator();
+    exp_evaluator->setPolarQuadrature(polar_quad);
+    exp_evaluator->setMaxOpticalLength(max_tau);
+
+    if (interpolate)
+      exp_evaluator->useInterpolation();
+    else
+      exp_evaluator->useIntrinsic();
+
+    exp_evaluator->initialize();
+
+    double sum = 0.;
+    double start_time = omp_get_wtime();
+
+    for (int r=0; r < num_repeats; r++) {
+      #pragma omp parallel for reduction(+:sum)
+      for (int i=0; i < num_taus; i++) {
+        for (int p=0; p < num_polar; p++)
+          sum += exp_evaluator->computeExponential(taus[i], p);
+      }
+    }
+
+    double time = omp_get_wtime() - start_time;
+    double num_evaluations = double(num_repeats) * num_taus * num_polar;
+
+    log_printf(NORMAL, "Sum of the exponentials: %f", sum);
+    report("exp", interpolate ? "computeExponential (table)" :
+           "computeExponential (exp)", time * 1.E9 / num_evaluations, "ns");
+
+    delete exp_evaluator;
+  }
+
+  delete polar_quad;
+}
+
+
+/**
+ * @brief Times ray tracing, the transport sweep, the FSR sources and the
+ *        CMFD solves for a workload.
+ * @details The Tracks are written to a fresh output directory so that they
+ *          are always segmentized rather than read from an earlier run. The
+ *          eigenvalue calculation is run for a fixed number of source
+ *          iterations with CMFD acceleration.
+ * @param workload the workload to time
+ * @param options the benchmark options
+ */
+static void benchmark_workload(benchmarkWorkload& workload,
+                               benchmarkOptions& options) {
+
+  Timer* timer = Timer::Get();
+  timer->clearPhases();
+
+  char directory[] = "/tmp/openmoc-benchmark-XXXXXX";
+  if (mkdtemp(directory) == NULL)
+    log_printf(ERROR, "Unable to create a temporary output directory for "
+               "the %s workload", workload.name);
+  set_output_directory(directory);
+
+  Geometry* geometry = workload.geometry;
+  log_printf(NORMAL, "Timing the %s workload...", workload.name);
+
+  /* Ray tracing */
+  TrackGenerator* track_generator =
+    new TrackGenerator(geometry, workload.num_azim, workload.spacing);
+  track_generator->setNumThreads(options.num_threads);
+  track_generator->generateTracks();
+
+  double time = timer->getPhaseTime("generateTracks/segmentize");
+  int num_tracks = track_generator->getNumTracks();
+  int num_segments = track_generator->getNumSegments();
+
+  report(workload.name, "segmentize (tracks)", num_tracks / time, "/s");
+  report(workload.name, "segmentize (segments)", num_segments / time, "/s");
+
+  /* Check the sizes of a synthetic Geometry against those expected */
+  if (workload.generator != NULL) {
+    GeometryGenerator* generator = workload.generator;
+
+    if (geometry->getNumFSRs() != generator->getNumFSRs())
+      log_printf(WARNING, "The %s workload has %d FSRs rather than the %ld "
+                 "expected", workload.name, geometry->getNumFSRs(),
+                 generator->getNumFSRs());
+
+    log_printf(INFO, "%s: %d FSRs (%ld expected), %d segments (%ld "
+               "estimated)", workload.name, geometry->getNumFSRs(),
+               generator->getNumFSRs(), num_segments,
+               generator->estimateNumSegments(workload.num_azim,
+                                              workload.spacing));
+  }
+
+  /* Source iterations with CMFD acceleration */
+  BenchmarkSolver* solver = new BenchmarkSolver(track_generator);
+  solver->setNumThreads(options.num_threads);
+  solver->setConvergenceThreshold(1.E-20);
+  solver->computeEigenvalue(options.num_iterations);
+
+  /* Segments may have been split for the exponential interpolation table */
+  num_segments = track_generator->getNumSegments();
+  long num_sweeps = timer->getPhaseNumCalls("computeEigenvalue/transportSweep");
+  time = timer->getPhaseTime("computeEigenvalue/transportSweep");
+  double num_integrations = 2. * num_sweeps * num_segments *
+    solver->getPolarTimesGroups();
+  report(workload.name, "tallyScalarFlux", time * 1.E9 / num_integrations,
+         "ns");
+
+  long num_calls = timer->getPhaseNumCalls("computeEigenvalue/computeFSRSources");
+  time = timer->getPhaseTime("computeEigenvalue/computeFSRSources");
+  double num_sources = double(num_calls) * geometry->getNumFSRs() *
+    geometry->getNumEnergyGroups();
+  report(workload.name, "computeFSRSources", time * 1.E9 / num_sources, "ns");
+
+  /* The CMFD eigenvalue iterations recorded in the convergence history */
+  int num_values = solver->getNumHistoryIterations() * NUM_HISTORY_QUANTITIES;
+  std::vector<double> history(num_values);
+  solver->getConvergenceHistory(&history[0], num_values);
+
+  double num_cmfd_iterations = 0.;
+  for (int i=HISTORY_CMFD_ITERATIONS; i < num_values;
+       i += NUM_HISTORY_QUANTITIES)
+    num_cmfd_iterations += history[i];
+
+  Cmfd* cmfd = geometry->getCmfd();
+  time = timer->getPhaseTime("computeEigenvalue/computeKeff");
+  report(workload.name, "CMFD eigenvalue", num_cmfd_iterations / time,
+         "its/s");
+  report(workload.name, "linearSolve", cmfd->getLinearSolveIterations() /
+         cmfd->getLinearSolveTime(), "its/s");
+
+  log_printf(NORMAL, "%s: %d FSRs, %d Tracks, %d segments, k_eff = %f",
+             workload.name, geometry->getNumFSRs(), num_tracks, num_segments,
+             solver->getKeff());
+
+  delete solver;
+  delete track_generator;
+
+  nftw(directory, remove_path, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+
+/**
+ * @brief Prints the command line options of the benchmark.
+ * @param program the name of the program
+ */
+static void print_usage(const char* program) {
+  printf("Usage: %s [options]\n"
+         "  -t threads     number of OpenMP threads (default 1)\n"
+         "  -i iterations  source iterations per workload (default 10)\n"
+         "  -p pins        pins along each side of the lattice (default 17)\n"
+         "  -d depth       levels of nested lattices of pins (default 1)\n"
+         "  -g groups      energy groups of the lattice (default 7)\n"
+         "  -w workload    exp, pins, lra or all (default all)\n"
+         "  -o file        write the results to a CSV file\n"
+         "  -v             print the progress of each calculation\n",
+         program);
+}
+
+
+int main(int argc, char** argv) {
+
+  benchmarkOptions options;
+  options.num_threads = 1;
+  options.num_iterations = 10;
+  options.num_pins = 17;
+  options.nesting_depth = 1;
+  options.num_groups = 7;
+  options.workload = "all";
+  bool verbose = false;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "t:i:p:d:g:w:o:vh")) != -1) {
+    switch (opt) {
+    case 't': options.num_threads = atoi(optarg); break;
+    case 'i': options.num_iterations = atoi(optarg); break;
+    case 'p': options.num_pins = atoi(optarg); break;
+    case 'd': options.nesting_depth = atoi(optarg); break;
+    case 'g': options.num_groups = atoi(optarg); break;
+    case 'w': options.workload = optarg; break;
+    case 'o': options.csv_filename = optarg; break;
+    case 'v': verbose = true; break;
+    default:
+      print_usage(argv[0]);
+      return (opt == 'h') ? 0 : 1;
+    }
+  }
+
+  if (options.num_threads < 1 || options.num_iterations < 1 ||
+      options.num_pins < 1 || options.nesting_depth < 1 ||
+      options.num_groups < 1) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  set_log_level(verbose ? "INFO" : "RESULT");
+
+  if (!options.csv_filename.empty()) {
+    csv_file = fopen(options.csv_filename.c_str(), "w");
+    if (csv_file == NULL) {
+      fprintf(stderr, "Unable to open %s\n", options.csv_filename.c_str());
+      return 1;
+    }
+    fprintf(csv_file, "workload,kernel,value,units\n");
+  }
+
+  log_printf(RESULT, "OpenMOC benchmark: %s precision, %d threads",
+             (sizeof(FP_PRECISION) == sizeof(double)) ? "double" : "single",
+             options.num_threads);
+
+  try {
+
+    omp_set_num_threads(options.num_threads);
+
+    if (options.workload == "exp" || options.workload == "all")
+      benchmark_exponential(options);
+
+    if (options.workload == "pins" || options.workload == "all") {
+      GeometryGenerator generator(options.num_pins, options.num_pins,
+                                  options.nesting_depth);
+      generator.setNumEnergyGroups(options.num_groups);
+
+      benchmarkWorkload workload;
+      workload.name = "pins";
+      workload.geometry = create_pin_lattice(generator);
+      workload.num_azim = 16;
+      workload.spacing = 0.05;
+      workload.generator = &generator;
+      benchmark_workload(workload, options);
+    }
+
+    if (options.workload == "lra" || options.workload == "all") {
+      benchmarkWorkload workload;
+      workload.name = "lra";
+      workload.geometry = create_lra();
+      workload.num_azim = 4;
+      workload.spacing = 0.1;
+      workload.generator = NULL;
+      benchmark_workload(workload, options);
+    }
+  }
+  catch (std::exception& e) {
+    log_flush();
+    fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+
+  log_flush();
+
+  if (csv_file != NULL)
+    fclose(csv_file);
+
+  return 0;
+}
@@ -0,0 +1,289 @@
+##
+# @file scaling.py
+# @brief A thread scaling harness for the sample-input benchmarks.
+# @details This script runs the benchmarks in sample-input/benchmarks across
+#          a range of OpenMP thread counts and track spacings. Each run is
+#          made in a fresh Python process with an empty Track file directory
+#          so that the Tracks are always generated, and the plots made by the
+#          benchmark scripts are turned off. The track generation and
+#          eigenvalue solve times are taken from the phases of the Timer and
+#          reported separately, with speedups and parallel efficiencies:
+#
+#          - Strong scaling: each benchmark is run with the same track
+#            spacing for each number of threads.
+#          - Weak scaling (--weak): the track spacing is divided by the
+#            number of threads relative to the first thread count, so that
+#            the number of segments (and work) per thread is roughly fixed.
+#
+#          The results of each run may also be written to JSON or CSV files.
+#          An example of how to use this script is as follows:
+#
+# @code
+#          python profile/scaling.py --benchmarks c5g7 LRA --threads 1 2 4 8 \
+#                 --spacings 0.1 0.05 --max-iters 20 --csv scaling.csv
+# @endcode
+#
+# @date October 18, 2026
+
+from __future__ import print_function, division
+import argparse, csv, json, os, shutil, subprocess, sys, tempfile, time
+
+
+## @var BENCHMARKS
+#  @brief The benchmark scripts in sample-input/benchmarks by name.
+BENCHMARKS = {
+  'c5g7' : 'c5g7/c5g7.py',
+  'LRA' : 'LRA/LRA.py',
+  'romano' : 'romano/romano.py',
+  'homogeneous-one-group' :
+    'homogeneous-one-group/homogeneous-one-group.py',
+  'homogeneous-two-group' :
+    'homogeneous-two-group/homogeneous-two-groups.py',
+  'synthetic' : 'synthetic/synthetic.py'
+}
+
+## @var BENCHMARK_DIRECTORY
+#  @brief The directory of the sample-input benchmarks.
+BENCHMARK_DIRECTORY = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                   '..', 'sample-input', 'benchmarks')
+
+## @var FIELDS
+#  @brief The quantities recorded for each run in the order of the CSV file.
+FIELDS = ['benchmark', 'threads', 'spacing', 'num_azim', 'fsrs', 'tracks',
+          'segments', 'iterations', 'k_eff', 'track_time', 'solve_time',
+          'sweep_time', 'wall_time']
+
+
+##
+# @class _NoPlotter
+# @brief A stand-in for the openmoc.plotter module which ignores all plots.
+class _NoPlotter(object):
+
+  def __getattr__(self, name):
+    return lambda *args, **kwargs: None
+
+
+##
+# @brief Runs a benchmark script in this process and writes its timings.
+# @details This is called in a new Python process for each run by
+#          run_benchmark(...). The script is run from its own directory so
+#          that it finds its materials, with the runtime options passed on
+#          its command line as parsed by openmoc.options.
+# @param script the path to the benchmark script
+# @param threads the number of OpenMP threads
+# @param spacing the track spacing (cm)
+# @param num_azim the number of azimuthal angles
+# @param max_iters the number of source iterations
+# @param output_directory the directory for Track files and logs
+# @param filename the JSON file to write the timings to
+def _run_in_process(script, threads, spacing, num_azim, max_iters,
+                    output_directory, filename):
+
+  import runpy
+  import openmoc
+
+  # Turn off the plots made at the end of the benchmark scripts
+  plotter = _NoPlotter()
+  sys.modules['openmoc.plotter'] = plotter
+  openmoc.plotter = plotter
+
+  openmoc.set_output_directory(output_directory)
+
+  # Run a fixed number of source iterations so that each run does the
+  # same work regardless of convergence
+  sys.argv = [script, '--num-omp-threads', str(threads),
+              '--track-spacing', str(spacing), '--num-azim', str(num_azim),
+              '--max-iters', str(max_iters), '--tolerance', '1E-20']
+
+  os.chdir(os.path.dirname(os.path.abspath(script)))
+  start_time = time.time()
+  variables = runpy.run_path(os.path.basename(script), run_name='__main__')
+  wall_time = time.time() - start_time
+
+  geometry = variables['geometry']
+  track_generator = variables['track_generator']
+  solver = variables['solver']
+  timer = openmoc.Timer.Get()
+
+  results = {'fsrs' : geometry.getNumFSRs(),
+             'tracks' : track_generator.getNumTracks(),
+             'segments' : track_generator.getNumSegments(),
+             'iterations' : solver.getNumIterations(),
+             'k_eff' : solver.getKeff(),
+             'track_time' : timer.getPhaseTime('generateTracks'),
+             'solve_time' : timer.getPhaseTime('computeEigenvalue'),
+             'sweep_time' :
+               timer.getPhaseTime('computeEigenvalue/transportSweep'),
+             'wall_time' : wall_time}
+
+  with open(filename, 'w') as output:
+    json.dump(results, output)
+
+
+##
+# @brief Runs a benchmark in a new Python process and returns its timings.
+# @param name the name of the benchmark (a key of BENCHMARKS)
+# @param threads the number of OpenMP threads
+# @param spacing the track spacing (cm)
+# @param num_azim the number of azimuthal angles
+# @param max_iters the number of source iterations
+# @return a dictionary of the quantities in FIELDS for the run
+def run_benchmark(name, threads, spacing, num_azim, max_iters):
+
+  script = os.path.join(BENCHMARK_DIRECTORY, BENCHMARKS[name])
+  directory = tempfile.mkdtemp(prefix='openmoc-scaling-')
+  filename = os.path.join(directory, 'results.json')
+
+  command = [sys.executable, os.path.abspath(__file__), '--run', script,
+             str(threads), repr(spacing), str(num_azim), str(max_iters),
+             directory, filename]
+
+  env = dict(os.environ)
+  env['OMP_NUM_THREADS'] = str(threads)
+
+  try:
+    process = subprocess.Popen(command, stdout=subprocess.PIPE,
+                               stderr=subprocess.STDOUT, env=env)
+    log = process.communicate()[0].decode('utf-8', 'replace')
+
+    if process.returncode != 0 or not os.path.exists(filename):
+      print(log[-4000:], file=sys.stderr)
+      raise RuntimeError('The {0} benchmark failed with {1} threads and a '
+                         'track spacing of {2} cm'.format(name, threads,
+                                                          spacing))
+
+    with open(filename) as results_file:
+      results = json.load(results_file)
+
+  finally:
+    shutil.rmtree(directory, ignore_errors=True)
+
+  results.update({'benchmark' : name, 'threads' : threads,
+                  'spacing' : spacing, 'num_azim' : num_azim})
+  return results
+
+
+##
+# @brief Prints the speedups and parallel efficiencies of a series of runs.
+# @details The speedups are relative to the first run. For strong scaling,
+#          the efficiency is the speedup divided by the increase in the
+#          number of threads. For weak scaling, the efficiency is the
+#          segments integrated per second per thread relative to the first
+#          run, which accounts for the number of segments not scaling
+#          exactly with the track spacing.
+# @param title the title of the table
+# @param runs a list of the results of each run
+# @param weak whether the runs are for weak scaling
+def print_table(title, runs, weak=False):
+
+  print('')
+  print(title)
+  print('{0:>7} {1:>8} {2:>11} {3:>10} {4:>9} {5:>10} {6:>9} {7:>9} '
+        '{8:>9}'.format('threads', 'spacing', 'segments', 'tracks (s)',
+                        'track eff', 'solve (s)', 'speedup', 'solve eff',
+                        'sweep eff'))
+
+  base = runs[0]
+
+  for run in runs:
+
+    ratio = run['threads'] / base['threads']
+
+    if weak:
+      work = run['segments'] / base['segments']
+      track_eff = work * base['track_time'] / (ratio * run['track_time'])
+      solve_eff = work * base['solve_time'] / (ratio * run['solve_time'])
+      sweep_eff = work * base['sweep_time'] / (ratio * run['sweep_time'])
+      speedup = work * base['solve_time'] / run['solve_time']
+    else:
+      track_eff = base['track_time'] / (ratio * run['track_time'])
+      solve_eff = base['solve_time'] / (ratio * run['solve_time'])
+      sweep_eff = base['sweep_time'] / (ratio * run['sweep_time'])
+      speedup = base['solve_time'] / run['solve_time']
+
+    print('{0:>7d} {1:>8.4f} {2:>11d} {3:>10.3f} {4:>9.1%} {5:>10.3f} '
+          '{6:>9.2f} {7:>9.1%} {8:>9.1%}'.format(
+            run['threads'], run['spacing'], run['segments'],
+            run['track_time'], track_eff, run['solve_time'], speedup,
+            solve_eff, sweep_eff))
+
+
+##
+# @brief Parses the command line and runs the scaling study.
+def main():
+
+  if len(sys.argv) > 1 and sys.argv[1] == '--run':
+    script, threads, spacing, num_azim, max_iters, directory, filename = \
+      sys.argv[2:9]
+    _run_in_process(script, int(threads), float(spacing), int(num_azim),
+                    int(max_iters), directory, filename)
+    return
+
+  parser = argparse.ArgumentParser(
+    description='Thread scaling study of the OpenMOC sample-input '
+                'benchmarks')
+  parser.add_argument('--benchmarks', nargs='+', default=['c5g7'],
+                      choices=sorted(BENCHMARKS.keys()),
+                      help='the benchmarks to run (default: c5g7)')
+  parser.add_argument('--threads', nargs='+', type=int, default=[1, 2, 4],
+                      help='the numbers of OpenMP threads (default: 1 2 4)')
+  parser.add_argument('--spacings', nargs='+', type=float, default=[0.1],
+                      help='the track spacings in cm (default: 0.1); for '
+                      'weak scaling, the spacings with the first number '
+                      'of threads')
+  parser.add_argument('--num-azim', type=int, default=4,
+                      help='the number of azimuthal angles (default: 4)')
+  parser.add_argument('--max-iters', type=int, default=20,
+                      help='the number of source iterations (default: 20)')
+  parser.add_argument('--weak', action='store_true',
+                      help='scale the track spacing with the number of '
+                      'threads for weak scaling')
+  parser.add_argument('--json', help='write the results to a JSON file')
+  parser.add_argument('--csv', help='write the results to a CSV file')
+  args = parser.parse_args()
+
+  threads = sorted(set(args.threads))
+  all_runs = list()
+
+  for name in args.benchmarks:
+    for spacing in args.spacings:
+
+      runs = list()
+
+      for num_threads in threads:
+
+        run_spacing = spacing
+        if args.weak:
+          run_spacing = spacing * threads[0] / num_threads
+
+        print('Running {0} with {1} threads and a track spacing of {2:.4f} '
+              'cm...'.format(name, num_threads, run_spacing))
+        sys.stdout.flush()
+
+        runs.append(run_benchmark(name, num_threads, run_spacing,
+                                  args.num_azim, args.max_iters))
+
+      all_runs.extend(runs)
+
+      if args.weak:
+        title = '{0}: weak scaling from a track spacing of {1} cm with {2} ' \
+                'azimuthal angles'.format(name, spacing, args.num_azim)
+      else:
+        title = '{0}: strong scaling with a track spacing of {1} cm and ' \
+                '{2} azimuthal angles'.format(name, spacing, args.num_azim)
+      print_table(title, runs, args.weak)
+
+  if args.json:
+    with open(args.json, 'w') as output:
+      json.dump({'weak' : args.weak, 'runs' : all_runs}, output, indent=2)
+
+  if args.csv:
+    with open(args.csv, 'w') as output:
+      writer = csv.DictWriter(output, fieldnames=FIELDS)
+      writer.writeheader()
+      for run in all_runs:
+        writer.writerow(dict((field, run[field]) for field in FIELDS))
+
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,84 @@
+from openmoc import *
+import openmoc.log as log
+import openmoc.plotter as plotter
+from openmoc.options import Options
+
+
+###############################################################################
+#                          Main Simulation Parameters
+###############################################################################
+
+options = Options()
+
+num_threads = options.getNumThreads()
+track_spacing = options.getTrackSpacing()
+num_azim = options.getNumAzimAngles()
+tolerance = options.getTolerance()
+max_iters = options.getMaxIterations()
+
+log.set_log_level('NORMAL')
+
+log.py_printf('TITLE', 'Simulating a Synthetic Lattice of Pin Cells...')
+
+
+###############################################################################
+#                         Creating the Geometry
+###############################################################################
+
+log.py_printf('NORMAL', 'Creating geometry...')
+
+# A 17 x 17 lattice of pins with 3 fuels and 10% moderator holes
+generator = GeometryGenerator(17, 17)
+generator.setNumRings(3)
+generator.setNumSectors(8)
+generator.setNumFuelMaterials(3)
+generator.setModeratorFraction(0.1)
+generator.setNumEnergyGroups(7)
+generator.setBoundaryType(REFLECTIVE)
+
+geometry = generator.generateGeometry()
+
+cmfd = Cmfd()
+cmfd.setLatticeStructure(generator.getNumPinsX(), generator.getNumPinsY())
+geometry.setCmfd(cmfd)
+
+geometry.initializeFlatSourceRegions()
+
+log.py_printf('NORMAL', 'Expecting %d FSRs and about %d segments',
+              generator.getNumFSRs(),
+              generator.estimateNumSegments(num_azim, track_spacing))
+
+
+###############################################################################
+#                          Creating the TrackGenerator
+###############################################################################
+
+log.py_printf('NORMAL', 'Initializing the track generator...')
+
+track_generator = TrackGenerator(geometry, num_azim, track_spacing)
+track_generator.setNumThreads(num_threads)
+track_generator.generateTracks()
+
+
+###############################################################################
+#                            Running a Simulation
+###############################################################################
+
+solver = CPUSolver(track_generator)
+solver.setConvergenceThreshold(tolerance)
+solver.setNumThreads(num_threads)
+solver.computeEigenvalue(max_iters)
+solver.printTimerReport()
+
+
+###############################################################################
+#                             Generating Plots
+###############################################################################
+
+log.py_printf('NORMAL', 'Plotting data...')
+
+plotter.plot_materials(geometry, gridsize=500)
+plotter.plot_flat_source_regions(geometry, gridsize=500)
+plotter.plot_spatial_fluxes(solver, energy_groups=[1,7])
+
+log.py_printf('TITLE', 'Finished')
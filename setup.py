@@ -5,6 +5,7 @@ The setup script for OpenMOC
 import os, string
 from distutils.errors import DistutilsOptionError
 import distutils.ccompiler
+import distutils.sysconfig
 import multiprocessing
 import multiprocessing.pool as pool
 
@@ -16,12 +17,12 @@ if 'USE_SETUPTOOLS' in os.environ or 'pip' in __file__:
   with_setuptools = True
 
 if with_setuptools:
-  from setuptools import setup
+  from setuptools import setup, Command
   from setuptools.command.build_ext import build_ext
   from setuptools.command.build_py import build_py
   from setuptools.command.install import install
 else:
-  from distutils.core import setup
+  from distutils.core import setup, Command
   from distutils.command.build_ext import build_ext
   from distutils.command.build_py import build_py
   from distutils.command.install import install
@@ -354,6 +355,181 @@ class custom_build_ext(build_ext):
     build_ext.build_extensions(self)
 
 
+class build_core(Command):
+  """Builds the OpenMOC core library
+
+  The core library is compiled from the same C/C++ sources and with the same
+  compiler options as the main openmoc module, but without the SWIG wrapper,
+  so that it has no dependency on Python. It may be embedded in native
+  executables and profiled or optimized without the Python interpreter. The
+  static (libopenmoc.a) and shared (libopenmoc.so) libraries are placed in
+  the build directory:
+
+  python setup.py build_core --cc=gcc --fp=double
+  """
+
+  description = 'build the OpenMOC core library without Python'
+
+  # The user options for a customized core library build
+  user_options = [
+    ('cc=', None, "Compiler (gcc, clang, icpc, or bgxlc)"),
+    ('fp=', None, "Floating point precision (single or double)"),
+    ('debug-mode', None, "Build with debugging symbols"),
+    ('profile-mode', None, "Build with profiling symbols"),
+    ('with-ccache', None, "Build with ccache for rapid recompilation")
+  ]
+
+  boolean_options = ['debug-mode',
+                     'profile-mode',
+                     'with-ccache']
+
+
+  def initialize_options(self):
+    """Set the default core library build options"""
+
+    self.cc = 'gcc'
+    self.fp = 'single'
+    self.debug_mode = False
+    self.profile_mode = False
+    self.with_ccache = False
+    self.build_base = None
+    self.build_temp = None
+
+
+  def finalize_options(self):
+    """Check the options and set up the library in config.configurations"""
+
+    self.set_undefined_options('build',
+                               ('build_base', 'build_base'),
+                               ('build_temp', 'build_temp'))
+
+    if self.cc not in ['gcc', 'clang', 'icpc', 'bgxlc']:
+      raise DistutilsOptionError \
+            ('Must supply the -cc flag with one of the supported ' +
+             'C++ compilers: gcc, clang, icpc, bgxlc')
+
+    if self.fp not in ['single', 'double']:
+      raise DistutilsOptionError \
+          ('Must supply the -fp flag with one of the supported ' +
+           'floating point precision levels: single, double')
+
+    config.cc = self.cc
+    config.fp = self.fp
+    config.debug_mode = self.debug_mode
+    config.profile_mode = self.profile_mode
+    config.with_ccache = self.with_ccache
+
+    self.core = config.setup_core_library()
+
+
+  def new_compiler(self):
+    """Returns a compiler customized for the OpenMOC build options"""
+
+    compiler = distutils.ccompiler.new_compiler(verbose=self.verbose,
+                                                dry_run=self.dry_run)
+    distutils.sysconfig.customize_compiler(compiler)
+    customize_compiler(compiler)
+    customize_linker(compiler)
+
+    return compiler
+
+
+  def run(self):
+    """Compile the sources and create the static and shared libraries"""
+
+    compiler = self.new_compiler()
+
+    objects = compiler.compile(self.core['sources'],
+                               output_dir=self.build_temp,
+                               macros=self.core['macros'],
+                               include_dirs=self.core['include_dirs'])
+
+    compiler.create_static_lib(objects, self.core['name'],
+                               output_dir=self.build_base)
+
+    compiler.link_shared_lib(
+      objects, self.core['name'], output_dir=self.build_base,
+      libraries=self.core['libraries'],
+      library_dirs=self.core['library_dirs'],
+      extra_postargs=self.core['linker_flags'])
+
+    # The path to the static library for linking executables
+    self.static_library = os.path.join(
+      self.build_base,
+      compiler.library_filename(self.core['name'], lib_type='static'))
+
+
+class build_benchmark(build_core):
+  """Builds the openmoc-benchmark executable
+
+  The openmoc-benchmark executable times OpenMOC's core computational
+  kernels without going through the Python interface. It is linked to the
+  static core library built by build_core, and is placed in the build
+  directory:
+
+  python setup.py build_benchmark --cc=gcc --fp=double
+  ./build/openmoc-benchmark -h
+  """
+
+  description = 'build the openmoc-benchmark executable'
+
+
+  def run(self):
+    """Build the core library and link the openmoc-benchmark executable"""
+
+    build_core.run(self)
+
+    compiler = self.new_compiler()
+
+    objects = compiler.compile(config.benchmark_sources,
+                               output_dir=self.build_temp,
+                               macros=self.core['macros'],
+                               include_dirs=self.core['include_dirs'])
+
+    compiler.link_executable(
+      objects + [self.static_library], 'openmoc-benchmark',
+      output_dir=self.build_base,
+      libraries=self.core['libraries'],
+      library_dirs=self.core['library_dirs'],
+      extra_postargs=self.core['executable_linker_flags'])
+
+
+class build_driver(build_core):
+  """Builds the openmoc-driver executable
+
+  The openmoc-driver executable runs an OpenMOC calculation from a text
+  input deck without the Python interpreter, and writes the results to a
+  binary file which may be read with openmoc.process.read_driver_results.
+  It is linked to the static core library built by build_core, and is
+  placed in the build directory:
+
+  python setup.py build_driver --cc=gcc --fp=double
+  ./build/openmoc-driver sample-input/benchmarks/c5g7/c5g7.deck
+  """
+
+  description = 'build the openmoc-driver executable'
+
+
+  def run(self):
+    """Build the core library and link the openmoc-driver executable"""
+
+    build_core.run(self)
+
+    compiler = self.new_compiler()
+
+    objects = compiler.compile(config.driver_sources,
+                               output_dir=self.build_temp,
+                               macros=self.core['macros'],
+                               include_dirs=self.core['include_dirs'])
+
+    compiler.link_executable(
+      objects + [self.static_library], 'openmoc-driver',
+      output_dir=self.build_base,
+      libraries=self.core['libraries'],
+      library_dirs=self.core['library_dirs'],
+      extra_postargs=self.core['executable_linker_flags'])
+
+
 # Run the distutils setup method for the complete build
 dist = setup(name = 'openmoc',
       version = '0.1.4b',
@@ -375,6 +551,9 @@ dist = setup(name = 'openmoc',
 
       # Inject our custom compiler and linker triggers
       cmdclass={ 'build_ext': custom_build_ext,
+                 'build_core': build_core,
+                 'build_benchmark': build_benchmark,
+                 'build_driver': build_driver,
                  'install': custom_install}
 )
 
@@ -0,0 +1,379 @@
+#include "BranchDriver.h"
+
+
+/**
+ * @brief Constructor initializes an empty batch of cases for a Solver.
+ * @details The Solver must already have a TrackGenerator with Tracks.
+ * @param solver a pointer to the Solver used to solve each case
+ */
+BranchDriver::BranchDriver(Solver* solver) {
+
+  if (solver == NULL)
+    log_printf(ERROR, "Unable to create a BranchDriver without a Solver");
+
+  _solver = solver;
+  _warm_start = true;
+}
+
+
+/**
+ * @brief Destructor clears the results for each case.
+ * @details The Materials for each case are owned by the caller and are
+ *          not deleted.
+ */
+BranchDriver::~BranchDriver() {
+  _case_materials.clear();
+  _case_parameters.clear();
+  _fission_rates.clear();
+  _fluxes.clear();
+  _boundary_fluxes.clear();
+}
+
+
+/**
+ * @brief Reports an error if a case ID does not refer to a case.
+ * @param case_id the case ID to check
+ */
+void BranchDriver::checkCase(int case_id) {
+  if (case_id < 0 || case_id >= getNumCases())
+    log_printf(ERROR, "Unable to access branch case %d since there are "
+               "only %d cases", case_id, getNumCases());
+}
+
+
+/**
+ * @brief Returns the number of cases in the batch.
+ * @return the number of cases
+ */
+int BranchDriver::getNumCases() {
+  return _case_materials.size();
+}
+
+
+/**
+ * @brief Returns the eigenvalue computed for a case.
+ * @param case_id the case ID
+ * @return the case's eigenvalue
+ */
+FP_PRECISION BranchDriver::getKeff(int case_id) {
+
+  checkCase(case_id);
+
+  if (!_solved[case_id])
+    log_printf(ERROR, "Unable to return k_eff for branch case %d since it "
+               "has not yet been solved", case_id);
+
+  return _k_effs[case_id];
+}
+
+
+/**
+ * @brief Returns the number of source iterations used to converge a case.
+ * @param case_id the case ID
+ * @return the number of source iterations
+ */
+int BranchDriver::getNumIterations(int case_id) {
+
+  checkCase(case_id);
+
+  if (!_solved[case_id])
+    log_printf(ERROR, "Unable to return the number of iterations for branch "
+               "case %d since it has not yet been solved", case_id);
+
+  return _num_iterations[case_id];
+}
+
+
+/**
+ * @brief Returns the total number of source iterations for all solved cases.
+ * @return the total number of source iterations
+ */
+int BranchDriver::getTotalIterations() {
+
+  int total_iterations = 0;
+
+  for (int i=0; i < getNumCases(); i++) {
+    if (_solved[i])
+      total_iterations += _num_iterations[i];
+  }
+
+  return total_iterations;
+}
+
+
+/**
+ * @brief Returns the case from which a case was warm started.
+ * @param case_id the case ID
+ * @return the ID of the warm start case (-1 if it was solved from scratch)
+ */
+int BranchDriver::getWarmStartCase(int case_id) {
+  checkCase(case_id);
+  return _warm_start_cases[case_id];
+}
+
+
+/**
+ * @brief Returns the fission rates in each FSR computed for a case.
+ * @details This method is intended to be called from Python with the
+ *          number of FSRs as follows:
+ *
+ * @code
+ *          num_FSRs = geometry.getNumFSRs()
+ *          fission_rates = driver.getFissionRates(case_id, num_FSRs)
+ * @endcode
+ *
+ * @param case_id the case ID
+ * @param fission_rates an array to store the fission rates (implicitly
+ *        passed in as a NumPy array from Python)
+ * @param num_FSRs the number of FSRs passed in from Python
+ */
+void BranchDriver::getFissionRates(int case_id, double* fission_rates,
+                                   int num_FSRs) {
+
+  checkCase(case_id);
+
+  if (!_solved[case_id])
+    log_printf(ERROR, "Unable to return fission rates for branch case %d "
+               "since it has not yet been solved", case_id);
+
+  if (num_FSRs != (int)_fission_rates[case_id].size())
+    log_printf(ERROR, "Unable to return fission rates for branch case %d "
+               "for %d FSRs since there are %d FSRs", case_id, num_FSRs,
+               (int)_fission_rates[case_id].size());
+
+  for (int r=0; r < num_FSRs; r++)
+    fission_rates[r] = _fission_rates[case_id][r];
+}
+
+
+/**
+ * @brief Returns whether cases are warm started from the nearest solved case.
+ * @return true if warm starting cases, false otherwise
+ */
+bool BranchDriver::isUsingWarmStart() {
+  return _warm_start;
+}
+
+
+/**
+ * @brief Adds a new case to the batch.
+ * @details The state parameters (e.g., fuel temperature and boron
+ *          concentration) are only used to find the nearest solved case
+ *          to warm start from, and so should be given in comparable units.
+ *          This method may be called from Python as follows:
+ *
+ * @code
+ *          case_id = driver.addCase(numpy.array([900., 1200.]))
+ * @endcode
+ *
+ * @param parameters an array of state parameters for the case
+ * @param num_parameters the number of state parameters
+ * @return the ID of the new case
+ */
+int BranchDriver::addCase(double* parameters, int num_parameters) {
+
+  if (num_parameters < 0 || (num_parameters > 0 && parameters == NULL))
+    log_printf(ERROR, "Unable to add a branch case with %d parameters",
+               num_parameters);
+
+  if (getNumCases() > 0 && num_parameters != 0 &&
+      _case_parameters[0].size() != 0 &&
+      num_parameters != (int)_case_parameters[0].size())
+    log_printf(ERROR, "Unable to add a branch case with %d parameters "
+               "since the other cases have %d parameters", num_parameters,
+               (int)_case_parameters[0].size());
+
+  _case_materials.push_back(std::vector<Material*>());
+  _case_parameters.push_back(std::vector<double>(parameters,
+                                                 parameters+num_parameters));
+  _k_effs.push_back(0.);
+  _num_iterations.push_back(0);
+  _warm_start_cases.push_back(-1);
+  _fission_rates.push_back(std::vector<double>());
+  _fluxes.push_back(std::vector<FP_PRECISION>());
+  _boundary_fluxes.push_back(std::vector<FP_PRECISION>());
+  _solved.push_back(false);
+
+  return getNumCases() - 1;
+}
+
+
+/**
+ * @brief Adds a Material to a case.
+ * @details The Material replaces the Material with the same ID in the
+ *          Geometry for this case. Materials in the Geometry which are not
+ *          replaced by the case are used as is.
+ * @param case_id the case ID
+ * @param material a pointer to the Material
+ */
+void BranchDriver::addCaseMaterial(int case_id, Material* material) {
+
+  checkCase(case_id);
+
+  if (material == NULL)
+    log_printf(ERROR, "Unable to add a NULL Material to branch case %d",
+               case_id);
+
+  std::vector<Material*>& materials = _case_materials[case_id];
+
+  for (size_t i=0; i < materials.size(); i++) {
+    if (materials[i]->getId() == material->getId())
+      log_printf(ERROR, "Unable to add Material %d to branch case %d since "
+                 "the case already contains a Material with that ID",
+                 material->getId(), case_id);
+  }
+
+  materials.push_back(material);
+  _solved[case_id] = false;
+}
+
+
+/**
+ * @brief Sets whether to warm start each case from the nearest solved case.
+ * @param warm_start whether to warm start cases (true by default)
+ */
+void BranchDriver::setWarmStart(bool warm_start) {
+  _warm_start = warm_start;
+}
+
+
+/**
+ * @brief Finds the solved case nearest to a case in parameter space.
+ * @details Ties are broken in favor of the most recently solved case, so
+ *          that cases without parameters are started from the previous case.
+ * @param case_id the case ID
+ * @return the ID of the nearest solved case (-1 if none is solved)
+ */
+int BranchDriver::findNearestCase(int case_id) {
+
+  std::vector<double>& parameters = _case_parameters[case_id];
+  double min_distance = std::numeric_limits<double>::max();
+  int nearest_case = -1;
+
+  for (int i=case_id-1; i >= 0; i--) {
+
+    if (!_solved[i] || _case_parameters[i].size() != parameters.size())
+      continue;
+
+    double distance = 0.;
+    for (size_t p=0; p < parameters.size(); p++)
+      distance += (parameters[p] - _case_parameters[i][p]) *
+                  (parameters[p] - _case_parameters[i][p]);
+
+    if (distance < min_distance) {
+      min_distance = distance;
+      nearest_case = i;
+    }
+  }
+
+  return nearest_case;
+}
+
+
+/**
+ * @brief Binds Materials to the Solver's TrackGenerator by Material ID.
+ * @details Only those Materials which differ from the Materials which are
+ *          currently bound are rebound on the Solver.
+ * @param materials a map of Material IDs to the Materials to bind
+ * @param bound_materials a map of Material IDs to the bound Materials
+ */
+void BranchDriver::bindMaterials(std::map<int, Material*>& materials,
+                                 std::map<int, Material*>& bound_materials) {
+
+  std::map<int, Material*>::iterator iter;
+
+  for (iter = materials.begin(); iter != materials.end(); ++iter) {
+    if (bound_materials[iter->first] != iter->second) {
+      _solver->rebindMaterial(iter->first, iter->second);
+      bound_materials[iter->first] = iter->second;
+    }
+  }
+}
+
+
+/**
+ * @brief Computes the eigenvalue and FSR fission rates for each case.
+ * @details The cases are solved in the order in which they were added. Each
+ *          case is warm started from the scalar and boundary angular fluxes
+ *          and eigenvalue of the nearest solved case in parameter space, so
+ *          that the initial state is consistent, unless warm starting has
+ *          been disabled. The Geometry's original Materials are rebound
+ *          once all cases have been solved.
+ * @param max_iters the maximum number of source iterations for each case
+ * @param res_type the type of residual used for the convergence criterion
+ */
+void BranchDriver::computeEigenvalues(int max_iters, residualType res_type) {
+
+  Geometry* geometry = _solver->getGeometry();
+  int num_FSRs = geometry->getNumFSRs();
+  int num_fluxes = num_FSRs * geometry->getNumEnergyGroups();
+  bool solver_warm_start = _solver->isUsingWarmStart();
+
+  /* Save the Geometry's Materials to restore once all cases are solved */
+  std::map<int, Material*> base_materials = geometry->getAllMaterials();
+  std::map<int, Material*> bound_materials = base_materials;
+  std::map<int, Material*>::iterator iter;
+
+  log_printf(NORMAL, "Computing eigenvalues for %d branch cases...",
+             getNumCases());
+
+  for (int c=0; c < getNumCases(); c++) {
+
+    /* Bind the Geometry's Materials overridden by this case's Materials */
+    std::map<int, Material*> materials = base_materials;
+
+    for (size_t i=0; i < _case_materials[c].size(); i++) {
+      Material* material = _case_materials[c][i];
+
+      if (base_materials.find(material->getId()) == base_materials.end())
+        log_printf(ERROR, "Unable to solve branch case %d since Material %d "
+                   "is not in the Geometry", c, material->getId());
+
+      materials[material->getId()] = material;
+    }
+
+    bindMaterials(materials, bound_materials);
+
+    /* Warm start from the nearest solved case */
+    int nearest_case = -1;
+    if (_warm_start)
+      nearest_case = findNearestCase(c);
+
+    if (nearest_case != -1) {
+      _solver->setFluxes(&_fluxes[nearest_case][0], num_fluxes);
+      _solver->setBoundaryFluxes(&_boundary_fluxes[nearest_case][0],
+                                 _boundary_fluxes[nearest_case].size());
+      _solver->setKeff(_k_effs[nearest_case]);
+      _solver->setWarmStart(true);
+      log_printf(INFO, "Warm starting branch case %d from case %d",
+                 c, nearest_case);
+    }
+    else
+      _solver->setWarmStart(false);
+
+    _solver->computeEigenvalue(max_iters, res_type);
+
+    /* Store the results for this case */
+    _k_effs[c] = _solver->getKeff();
+    _num_iterations[c] = _solver->getNumIterations();
+    _warm_start_cases[c] = nearest_case;
+    _fission_rates[c].resize(num_FSRs);
+    _solver->computeFSRFissionRates(&_fission_rates[c][0], num_FSRs);
+    _fluxes[c].resize(num_fluxes);
+    _solver->getFluxes(&_fluxes[c][0], num_fluxes);
+    _boundary_fluxes[c].resize(_solver->getNumBoundaryFluxes());
+    _solver->getBoundaryFluxes(&_boundary_fluxes[c][0],
+                               _boundary_fluxes[c].size());
+    _solved[c] = true;
+
+    log_printf(NORMAL, "Branch case %d: k_eff = %1.6f in %d iterations",
+               c, _k_effs[c], _num_iterations[c]);
+  }
+
+  /* Restore the Geometry's original Materials */
+  bindMaterials(base_materials, bound_materials);
+  _solver->setWarmStart(solver_warm_start);
+
+  log_printf(NORMAL, "Computed %d branch cases in %d total iterations",
+             getNumCases(), getTotalIterations());
+}
@@ -0,0 +1,96 @@
+/**
+ * @file BranchDriver.h
+ * @brief The BranchDriver class.
+ * @date October 18, 2026
+ */
+
+#ifndef BRANCHDRIVER_H_
+#define BRANCHDRIVER_H_
+
+#ifdef __cplusplus
+#include "Solver.h"
+#include <vector>
+#include <map>
+#include <limits>
+#endif
+
+
+/**
+ * @class BranchDriver BranchDriver.h "src/BranchDriver.h"
+ * @brief Solves a batch of eigenvalue problems ("branch cases") which differ
+ *        only in their cross-sections on a single TrackGenerator.
+ * @details Each case is a set of Materials, each of which replaces the
+ *          Material with the same ID in the Geometry, along with an optional
+ *          vector of state parameters (e.g., fuel temperature, boron
+ *          concentration, moderator density). The cases are solved in turn
+ *          by rebinding the Materials on the Solver's TrackGenerator, without
+ *          any ray tracing. Each case is warm started from the converged
+ *          scalar and boundary angular fluxes and eigenvalue of the nearest
+ *          case solved so far,
+ *          where the distance between cases is the Euclidean distance
+ *          between their state parameters.
+ */
+class BranchDriver {
+
+private:
+
+  /** The Solver used for each case */
+  Solver* _solver;
+
+  /** The Materials for each case */
+  std::vector< std::vector<Material*> > _case_materials;
+
+  /** The state parameters for each case */
+  std::vector< std::vector<double> > _case_parameters;
+
+  /** The eigenvalue computed for each case */
+  std::vector<FP_PRECISION> _k_effs;
+
+  /** The number of source iterations needed to converge each case */
+  std::vector<int> _num_iterations;
+
+  /** The case from which each case was warm started (-1 if cold) */
+  std::vector<int> _warm_start_cases;
+
+  /** The FSR fission rates computed for each case */
+  std::vector< std::vector<double> > _fission_rates;
+
+  /** The converged scalar fluxes for each case indexed by FSR and group */
+  std::vector< std::vector<FP_PRECISION> > _fluxes;
+
+  /** The converged Track boundary angular fluxes for each case */
+  std::vector< std::vector<FP_PRECISION> > _boundary_fluxes;
+
+  /** Whether each case has been solved */
+  std::vector<bool> _solved;
+
+  /** Whether to warm start each case from the nearest solved case */
+  bool _warm_start;
+
+  void checkCase(int case_id);
+  int findNearestCase(int case_id);
+  void bindMaterials(std::map<int, Material*>& materials,
+                     std::map<int, Material*>& bound_materials);
+
+public:
+  BranchDriver(Solver* solver);
+  virtual ~BranchDriver();
+
+  int getNumCases();
+  FP_PRECISION getKeff(int case_id);
+  int getNumIterations(int case_id);
+  int getTotalIterations();
+  int getWarmStartCase(int case_id);
+  void getFissionRates(int case_id, double* fission_rates, int num_FSRs);
+  bool isUsingWarmStart();
+
+  int addCase(double* parameters=NULL, int num_parameters=0);
+  void addCaseMaterial(int case_id, Material* material);
+  void setWarmStart(bool warm_start);
+
+  void computeEigenvalues(int max_iters=1000,
+                          residualType res_type=FISSION_SOURCE);
+};
+
+
+#endif /* BRANCHDRIVER_H_ */
@@ -104,6 +104,38 @@ void CPUSolver::initializeFSRs() {
 }
 
 
+/**
+ * @brief Initializes the Cmfd object with surface currents for each of the
+ *        Solver's OpenMP threads.
+ */
+void CPUSolver::initializeCmfd() {
+
+  if (_cmfd != NULL)
+    _cmfd->setNumThreads(_num_threads);
+
+  Solver::initializeCmfd();
+}
+
+
+/**
+ * @brief Computes the memory used by the Solver's arrays for each subsystem.
+ * @details This adds the OpenMP locks for each FSR to the Solver's arrays,
+ *          and counts the CMFD surface currents for each of the Solver's
+ *          OpenMP threads.
+ * @param num_bytes an array to store the bytes for each memorySubsystem
+ * @param newton_krylov whether to count the Newton-Krylov vectors rather
+ *        than Anderson acceleration or Chebyshev extrapolation
+ */
+void CPUSolver::countMemoryUsage(size_t* num_bytes, bool newton_krylov) {
+
+  if (_cmfd != NULL)
+    _cmfd->setNumThreads(_num_threads);
+
+  Solver::countMemoryUsage(num_bytes, newton_krylov);
+  num_bytes[SOLVER_MEMORY] += _num_FSRs * sizeof(omp_lock_t);
+}
+
+
 /**
  * @brief Allocates memory for Track boundary angular flux and leakage
  *        and FSR scalar flux arrays.
@@ -581,49 +613,63 @@ void CPUSolver::transportSweep() {
     min_track = i * (_tot_num_tracks / 2);
     max_track = (i + 1) * (_tot_num_tracks / 2);
 
-    /* Loop over each thread within this azimuthal angle halfspace */
-    #pragma omp parallel for private(curr_track, azim_index, num_segments, \
-      curr_segment, segments, track_flux, tid) schedule(guided)
-    for (int track_id=min_track; track_id < max_track; track_id++) {
-
-      tid = omp_get_thread_num();
-
-      /* Use local array accumulator to prevent false sharing*/
-      FP_PRECISION* thread_fsr_flux;
-      thread_fsr_flux = new FP_PRECISION[_num_groups];
-
-      /* Initialize local pointers to important data structures */
-      curr_track = _tracks[track_id];
-      azim_index = curr_track->getAzimAngleIndex();
-      num_segments = curr_track->getNumSegments();
-      segments = curr_track->getSegments();
-      track_flux = &_boundary_flux(track_id,0,0,0);
-
-      /* Loop over each Track segment in forward direction */
-      for (int s=0; s < num_segments; s++) {
-        curr_segment = &segments[s];
-        tallyScalarFlux(curr_segment, azim_index, track_flux, thread_fsr_flux);
-        tallySurfaceCurrent(curr_segment, azim_index, track_flux, true);
-      }
+    /* Loop over each thread within this azimuthal angle halfspace. The
+     * thread count is fixed to that of the per-thread CMFD surface
+     * currents, since the global OpenMP thread count may have changed. */
+    #pragma omp parallel num_threads(_num_threads)
+    {
+      /* Time the Tracks swept by each thread to expose load imbalance */
+      ScopedTimer timer("sweepTracks");
+
+      #pragma omp for private(curr_track, azim_index, num_segments, \
+        curr_segment, segments, track_flux, tid) schedule(guided) nowait
+      for (int track_id=min_track; track_id < max_track; track_id++) {
+
+        tid = omp_get_thread_num();
+
+        /* Use local array accumulator to prevent false sharing*/
+        FP_PRECISION* thread_fsr_flux;
+        thread_fsr_flux = new FP_PRECISION[_num_groups];
+
+        /* Initialize local pointers to important data structures */
+        curr_track = _tracks[track_id];
+        azim_index = curr_track->getAzimAngleIndex();
+        num_segments = curr_track->getNumSegments();
+        segments = curr_track->getSegments();
+        track_flux = &_boundary_flux(track_id,0,0,0);
+
+        /* Loop over each Track segment in forward direction */
+        for (int s=0; s < num_segments; s++) {
+          curr_segment = &segments[s];
+          tallyScalarFlux(curr_segment, azim_index, track_flux,
+                          thread_fsr_flux);
+          tallySurfaceCurrent(curr_segment, azim_index, track_flux, true);
+        }
 
-      /* Transfer boundary angular flux to outgoing Track */
-      transferBoundaryFlux(track_id, azim_index, true, track_flux);
+        /* Transfer boundary angular flux to outgoing Track */
+        transferBoundaryFlux(track_id, azim_index, true, track_flux);
 
-      /* Loop over each Track segment in reverse direction */
-      track_flux += _polar_times_groups;
+        /* Loop over each Track segment in reverse direction */
+        track_flux += _polar_times_groups;
 
-      for (int s=num_segments-1; s > -1; s--) {
-        curr_segment = &segments[s];
-        tallyScalarFlux(curr_segment, azim_index, track_flux, thread_fsr_flux);
-        tallySurfaceCurrent(curr_segment, azim_index, track_flux, false);
-      }
-      delete thread_fsr_flux;
+        for (int s=num_segments-1; s > -1; s--) {
+          curr_segment = &segments[s];
+          tallyScalarFlux(curr_segment, azim_index, track_flux,
+                          thread_fsr_flux);
+          tallySurfaceCurrent(curr_segment, azim_index, track_flux, false);
+        }
+        delete thread_fsr_flux;
 
-      /* Transfer boundary angular flux to outgoing Track */
-      transferBoundaryFlux(track_id, azim_index, false, track_flux);
+        /* Transfer boundary angular flux to outgoing Track */
+        transferBoundaryFlux(track_id, azim_index, false, track_flux);
+      }
     }
   }
 
+  /* Add the surface currents tallied by each thread */
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
+    _cmfd->reduceSurfaceCurrents();
+
   return;
 }
 
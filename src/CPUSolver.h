@@ -51,6 +51,8 @@ protected:
   void initializeFluxArrays();
   void initializeSourceArrays();
   void initializeFSRs();
+  void initializeCmfd();
+  void countMemoryUsage(size_t* num_bytes, bool newton_krylov=false);
 
   void zeroTrackFluxes();
   void flattenFSRFluxes(FP_PRECISION value);
@@ -10,7 +10,6 @@
 #define CELL_H_
 
 #ifdef __cplusplus
-#include "Python.h"
 #include "Material.h"
 #include "Surface.h"
 #include "Point.h"
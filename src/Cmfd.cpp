@@ -29,6 +29,36 @@ Cmfd::Cmfd() {
   _SOR_factor = 1.0;
   _num_FSRs = 0;
   _relax_factor = 0.6;
+  _k_eff = 1.0;
+
+  /* Eigenvalue acceleration parameters */
+  _wielandt_shift = 0.;
+  _wielandt_inverse = 0.;
+  _chebyshev_order = 0;
+  _chebyshev_step = 0;
+  _chebyshev_num_power_iterations = 0;
+  _chebyshev_cycle_residual = 0.;
+  _chebyshev_residual = 0.;
+  _dominance_ratio = 0.;
+  _num_iterations = 0;
+
+  /* Linear solver parameters */
+  _linear_solver_type = GAUSS_SEIDEL;
+  _num_linear_solves = 0;
+  _linear_solve_iterations = 0;
+  _linear_solve_time = 0.;
+
+  /* Multilevel parameters */
+  _multilevel = false;
+  _one_group_A = NULL;
+  _one_group_M = NULL;
+  _collapsed_flux = NULL;
+  _one_group_flux = NULL;
+  _one_group_old_source = NULL;
+  _one_group_new_source = NULL;
+  _num_one_group_iterations = 0;
+  _multigroup_solve_time = 0.;
+  _one_group_solve_time = 0.;
 
   /* Energy group and polar angle problem parameters */
   _num_moc_groups = 0;
@@ -38,15 +68,23 @@ Cmfd::Cmfd() {
   /* Set matrices and arrays to NULL */
   _A = NULL;
   _M = NULL;
+  _red_black_cells = NULL;
+  _num_red_cells = 0;
   _old_flux = NULL;
   _new_flux = NULL;
   _flux_temp = NULL;
   _old_source = NULL;
   _new_source = NULL;
+  _previous_source = NULL;
+  _block_inverses = NULL;
+  _krylov_vectors = NULL;
   _group_indices = NULL;
   _group_indices_map = NULL;
   _surface_currents = NULL;
-  _surface_locks = NULL;
+  _thread_surface_currents = NULL;
+  _num_threads = 1;
+  _flux_ratios = NULL;
+  _materials = NULL;
 
   /* Initialize boundaries to be reflective */
   _boundaries = new boundaryType[4];
@@ -64,19 +102,14 @@ Cmfd::~Cmfd() {
 
   /* Delete matrix and vector objects */
 
-  if (_M != NULL){
-    for (int i = 0; i < _num_x*_num_y; i++)
-      delete [] _M[i];
+  if (_M != NULL)
+    delete _M;
 
-    delete [] _M;
-  }
-
-  if (_A != NULL){
-    for (int i = 0; i < _num_x*_num_y; i++)
-      delete [] _A[i];
+  if (_A != NULL)
+    delete _A;
 
-    delete [] _A;
-  }
+  if (_red_black_cells != NULL)
+    delete [] _red_black_cells;
 
   if (_old_flux != NULL)
     delete [] _old_flux;
@@ -93,12 +126,32 @@ Cmfd::~Cmfd() {
   if (_new_source != NULL)
     delete [] _new_source;
 
-  if (_surface_locks != NULL)
-    delete [] _surface_locks;
+  if (_previous_source != NULL)
+    delete [] _previous_source;
+
+  if (_block_inverses != NULL)
+    delete [] _block_inverses;
+
+  if (_krylov_vectors != NULL)
+    delete [] _krylov_vectors;
+
+  if (_thread_surface_currents != NULL)
+    delete [] _thread_surface_currents;
 
   if (_surface_currents != NULL)
     delete [] _surface_currents;
 
+  if (_flux_ratios != NULL)
+    delete [] _flux_ratios;
+
+  if (_one_group_A != NULL){
+    delete _one_group_A;
+    delete _one_group_M;
+    delete [] _collapsed_flux;
+    delete [] _one_group_flux;
+    delete [] _one_group_old_source;
+    delete [] _one_group_new_source;
+  }
 }
 
 
@@ -181,6 +234,8 @@ void Cmfd::setHeight(double height){
  */
 void Cmfd::computeXS(){
 
+  ScopedTimer timer("computeXS");
+
   log_printf(INFO, "Computing CMFD cross-sections...");
 
   /* Split corner currents to side surfaces */
@@ -337,6 +392,8 @@ void Cmfd::computeXS(){
  */
 void Cmfd::computeDs(int moc_iteration){
 
+  ScopedTimer timer("computeDs");
+
   log_printf(INFO, "Computing CMFD diffusion coefficients...");
 
   FP_PRECISION d, d_next, d_hat, d_tilde;
@@ -527,20 +584,31 @@ FP_PRECISION Cmfd::computeKeff(int moc_iteration){
     try{
 
       /* Allocate memory for matrix and vector objects */
-      _M = new FP_PRECISION*[_num_x*_num_y];
-      _A = new FP_PRECISION*[_num_x*_num_y];
+      _M = new Matrix(_num_x*_num_y, _num_cmfd_groups);
+      _A = new Matrix(_num_x*_num_y, _num_cmfd_groups);
+      _red_black_cells = new int[_num_x*_num_y];
       _old_source = new FP_PRECISION[_num_x*_num_y*_num_cmfd_groups];
       _new_source = new FP_PRECISION[_num_x*_num_y*_num_cmfd_groups];
+      _previous_source = new FP_PRECISION[_num_x*_num_y*_num_cmfd_groups];
       _volumes = new FP_PRECISION[_num_x*_num_y];
 
-      for (int i = 0; i < _num_x*_num_y; i++){
-        _M[i] = new FP_PRECISION[_num_cmfd_groups*_num_cmfd_groups];
-        _A[i] = new FP_PRECISION[_num_cmfd_groups*(_num_cmfd_groups+4)];
+      /* Order the red cells before the black cells for Gauss-Seidel */
+      int num_cells = 0;
+      for (int color = 0; color < 2; color++){
+        for (int y = 0; y < _num_y; y++){
+          for (int x = (y + color) % 2; x < _num_x; x += 2)
+            _red_black_cells[num_cells++] = y*_num_x+x;
+        }
+
+        if (color == 0)
+          _num_red_cells = num_cells;
       }
 
-      /* Initialize flux and materials */
+      /* Initialize flux and materials (which may have been restored by
+       * setDifTildes(...) from a checkpoint) */
       initializeFlux();
-      initializeMaterials();
+      if (_materials == NULL)
+        initializeMaterials();
     }
     catch(std::exception &e){
       log_printf(ERROR, "Could not allocate memory for the CMFD mesh objects. "
@@ -549,8 +617,10 @@ FP_PRECISION Cmfd::computeKeff(int moc_iteration){
   }
 
   /* Initialize variables */
-  FP_PRECISION sum_new, sum_old, val, residual, scale_val;
+  FP_PRECISION sum_new, sum_old, val, residual, scale_val, ratio;
   int row;
+  int size = _num_x*_num_y*_num_cmfd_groups;
+  std::vector<FP_PRECISION> residuals;
 
   /* Convergence criteria on L2 norm of flux for linear solve */
   FP_PRECISION linear_solve_convergence_criteria = 1E-7;
@@ -561,48 +631,94 @@ FP_PRECISION Cmfd::computeKeff(int moc_iteration){
 
   /* Construct matrices */
   constructMatrices();
+  _wielandt_inverse = 0.;
+  _chebyshev_step = 0;
+  _chebyshev_num_power_iterations = 0;
+  _dominance_ratio = 0.;
+  _num_one_group_iterations = 0;
+  _one_group_solve_time = 0.;
+  double start_time = omp_get_wtime();
+  bool one_group_on = _multilevel;
+  bool use_shift = _wielandt_shift > 0. && !_multilevel;
 
   /* Compute and normalize the initial source */
-  matrix_multiplication(_M, _old_flux, _old_source, _num_x*_num_y, 
-      _num_cmfd_groups);
-  sum_old = pairwise_sum(_old_source, _num_x*_num_y*_num_cmfd_groups);
-  scale_val = (_num_x * _num_y * _num_cmfd_groups) / sum_old;
-  vector_scale(_old_source, scale_val, _num_x*_num_y*_num_cmfd_groups);
-  vector_copy(_old_flux, _new_flux, _num_x*_num_y*_num_cmfd_groups);
-  vector_scale(_new_flux, scale_val, _num_x*_num_y*_num_cmfd_groups);
-  sum_old = _num_x * _num_y * _num_cmfd_groups;
+  _M->multiply(_old_flux, _old_source);
+  sum_old = pairwise_sum(_old_source, size);
+  scale_val = size / sum_old;
+  vector_scale(_old_source, scale_val, size);
+  vector_copy(_old_flux, _new_flux, size);
+  vector_scale(_new_flux, scale_val, size);
+  sum_old = size;
   
   /* Power iteration diffusion solver */
   for (int iter = 0; iter < 25000; iter++){
-      
+
+    /* Shift the eigenvalue by the current estimate of keff */
+    if (use_shift)
+      shiftMatrix(_k_eff);
+
     /* Solve phi = A^-1 * old_source */
     linearSolve(_A, _new_flux, _old_source, linear_solve_convergence_criteria);
-      
+
+    /* Correct the spatial shape of the flux with the one-group problem
+     * until the shape has converged */
+    bool one_group_used = one_group_on;
+    FP_PRECISION one_group_k_eff = 0.;
+    if (one_group_on){
+      int num_one_group_iterations = _num_one_group_iterations;
+      one_group_k_eff = solveOneGroup(_new_flux);
+      if (_num_one_group_iterations - num_one_group_iterations == 1)
+        one_group_on = false;
+    }
+
     /* Compute the new source */
-    matrix_multiplication(_M, _new_flux, _new_source, _num_x*_num_y,
-        _num_cmfd_groups);
-    sum_new = pairwise_sum(_new_source, _num_x*_num_y*_num_cmfd_groups);
+    _M->multiply(_new_flux, _new_source);
+    sum_new = pairwise_sum(_new_source, size);
     
-    /* Compute and set keff */
-    _k_eff = sum_new / sum_old;
-    
-    /* Scale the old source by keff */
-    vector_scale(_old_source, _k_eff, _num_x*_num_y*_num_cmfd_groups);
+    /* Compute the eigenvalue of the (shifted) iteration and keff, which is
+     * 1 / ratio + 1 / (keff + shift) = 1 / keff with a Wielandt shift */
+    ratio = sum_new / sum_old;
+
+    if (one_group_used)
+      _k_eff = one_group_k_eff;
+    else if (_wielandt_inverse == 0.)
+      _k_eff = ratio;
+    else if (ratio > 0.)
+      _k_eff = 1. / (1. / ratio + _wielandt_inverse);
+    else {
+      log_printf(WARNING, "Turning off the CMFD Wielandt shift for this "
+                 "solve since the shifted eigenvalue %f is negative", ratio);
+      shiftMatrix(0.);
+      use_shift = false;
+      continue;
+    }
     
     /* Compute the L2 norm of source error */
     residual = 0.0;    
-    for (int i = 0; i < _num_x*_num_y*_num_cmfd_groups; i++){
+    for (int i = 0; i < size; i++){
       if (_new_source[i] != 0.0)
-        residual += pow((_new_source[i] - _old_source[i]) / _new_source[i], 2);
+        residual += pow((_new_source[i] - ratio * _old_source[i]) /
+                        _new_source[i], 2);
     }
 
     /* Compute the source RMS error */
-    residual = sqrt(residual / (_num_x*_num_y*_num_cmfd_groups));
+    residual = sqrt(residual / size);
 
     /* Normalize the new source to have an average value of 1.0 */
-    scale_val = (_num_x * _num_y * _num_cmfd_groups) / sum_new;
-    vector_scale(_new_source, scale_val, _num_x*_num_y*_num_cmfd_groups);
-    vector_copy(_new_source, _old_source, _num_x*_num_y*_num_cmfd_groups);
+    scale_val = size / sum_new;
+    vector_scale(_new_source, scale_val, size);
+
+    if (_chebyshev_order == 0 || _multilevel ||
+        !extrapolateSource(residual))
+      vector_copy(_new_source, _old_source, size);
+
+    /* Estimate the dominance ratio from the last few residuals */
+    residuals.push_back(residual);
+    if (_chebyshev_order == 0 || _multilevel)
+      _dominance_ratio = residual_dominance_ratio(&residuals[0],
+                                                  residuals.size());
+
+    _num_iterations = iter + 1;
     
     log_printf(INFO, "CMFD iter: %i, keff: %f, error: %f", 
                iter, _k_eff, residual);
@@ -612,16 +728,328 @@ FP_PRECISION Cmfd::computeKeff(int moc_iteration){
       break;
   }
 
+  _multigroup_solve_time = omp_get_wtime() - start_time -
+      _one_group_solve_time;
+
+  log_printf(INFO, "CMFD converged in %d iterations with an estimated "
+             "dominance ratio of %f", _num_iterations, _dominance_ratio);
+
+  if (_multilevel)
+    log_printf(INFO, "CMFD multigroup level: %d iterations in %1.4E sec, "
+               "one-group level: %d iterations in %1.4E sec",
+               _num_iterations, _multigroup_solve_time,
+               _num_one_group_iterations, _one_group_solve_time);
+
   /* Rescale the old and new flux */
   rescaleFlux();
 
   /* Update the MOC flux */
+  computeFluxRatios();
   updateMOCFlux();
 
   return _k_eff;
 }
 
 
+/**
+ * @brief Collapses a multigroup CMFD matrix to one group.
+ * @details Each one-group entry coupling cell j to cell i is the sum of the
+ *          multigroup entries coupling the groups of cell j to the groups of
+ *          cell i, weighted by the flux spectrum of cell j. The product of
+ *          the collapsed matrix with the collapsed flux is then the sum over
+ *          groups of the product of the multigroup matrix with the flux.
+ * @param mat the multigroup matrix
+ * @param one_group_mat the one-group matrix to fill
+ * @param flux the multigroup flux weighting the collapse
+ */
+void Cmfd::collapseMatrix(Matrix* mat, Matrix* one_group_mat,
+                          FP_PRECISION* flux){
+
+  int ng = mat->getNumGroups();
+  int* row_pointers = mat->getRowPointers();
+  int* columns = mat->getColumns();
+  FP_PRECISION* values = mat->getValues();
+
+  one_group_mat->clear();
+
+  /* Each thread fills the row of distinct cells */
+  #pragma omp parallel for
+  for (int cell = 0; cell < _num_x*_num_y; cell++){
+    for (int g = 0; g < ng; g++){
+
+      int row = cell*ng + g;
+
+      for (int i = row_pointers[row]; i < row_pointers[row+1]; i++){
+        int cell_from = columns[i] / ng;
+        FP_PRECISION weight = 0.;
+
+        if (_collapsed_flux[cell_from] != 0.)
+          weight = flux[columns[i]] / _collapsed_flux[cell_from];
+
+        one_group_mat->incrementValue(cell_from, 0, cell, 0,
+                                      values[i] * weight);
+      }
+    }
+  }
+
+  one_group_mat->assemble();
+}
+
+
+/**
+ * @brief Solves the one-group CMFD eigenvalue problem collapsed from the
+ *        multigroup problem and prolongs its solution to a multigroup flux.
+ * @details The A and M matrices are collapsed to one group with the flux
+ *          spectrum in each cell and the one-group problem is converged by
+ *          power iteration, starting from the collapsed flux. The flux in
+ *          each cell is then scaled by the ratio of the one-group flux to
+ *          the collapsed flux, which keeps the spectrum in each cell and
+ *          takes the spatial shape from the one-group solution. The flux is
+ *          left unchanged if the collapsed flux already converges the
+ *          one-group problem in a single power iteration.
+ * @param flux the multigroup flux, updated in place
+ * @return the eigenvalue of the one-group problem
+ */
+FP_PRECISION Cmfd::solveOneGroup(FP_PRECISION* flux){
+
+  ScopedTimer timer("solveOneGroup");
+
+  double start_time = omp_get_wtime();
+  int num_cells = _num_x*_num_y;
+  int ng = _num_cmfd_groups;
+
+  if (_one_group_A == NULL){
+    _one_group_A = new Matrix(num_cells, 1);
+    _one_group_M = new Matrix(num_cells, 1);
+    _collapsed_flux = new FP_PRECISION[num_cells];
+    _one_group_flux = new FP_PRECISION[num_cells];
+    _one_group_old_source = new FP_PRECISION[num_cells];
+    _one_group_new_source = new FP_PRECISION[num_cells];
+  }
+
+  /* Collapse the flux and matrices */
+  #pragma omp parallel for
+  for (int i = 0; i < num_cells; i++){
+    _collapsed_flux[i] = 0.;
+    for (int g = 0; g < ng; g++)
+      _collapsed_flux[i] += flux[i*ng+g];
+  }
+
+  collapseMatrix(_A, _one_group_A, flux);
+  collapseMatrix(_M, _one_group_M, flux);
+
+  /* Compute and normalize the initial source */
+  FP_PRECISION sum_new, sum_old, residual, scale_val, ratio;
+  FP_PRECISION k_eff = _k_eff;
+  FP_PRECISION wielandt_inverse = 0.;
+  int num_iterations = 0;
+  bool use_shift = _wielandt_shift > 0.;
+
+  /* The criteria can not be tighter than the floating point precision */
+  double tolerance = std::max(double(_source_convergence_threshold),
+      10. * std::numeric_limits<FP_PRECISION>::epsilon());
+
+  _one_group_M->multiply(_collapsed_flux, _one_group_old_source);
+  sum_old = pairwise_sum(_one_group_old_source, num_cells);
+  scale_val = num_cells / sum_old;
+  vector_scale(_one_group_old_source, scale_val, num_cells);
+  vector_copy(_collapsed_flux, _one_group_flux, num_cells);
+  vector_scale(_one_group_flux, scale_val, num_cells);
+
+  /* Power iteration on the one-group problem, Wielandt shifted in the
+   * same way as the multigroup problem in computeKeff(...) */
+  for (int iter = 0; iter < 25000; iter++){
+
+    if (use_shift){
+      FP_PRECISION change = 1. / (k_eff + _wielandt_shift) - wielandt_inverse;
+      wielandt_inverse += change;
+      _one_group_A->addMatrix(_one_group_M, -change);
+    }
+
+    /* Scale the initial flux to the solution of the (shifted) problem */
+    if (iter == 0)
+      vector_scale(_one_group_flux,
+                   FP_PRECISION(1. / (1. / k_eff - wielandt_inverse)),
+                   num_cells);
+
+    linearSolve(_one_group_A, _one_group_flux, _one_group_old_source, 1E-7);
+
+    _one_group_M->multiply(_one_group_flux, _one_group_new_source);
+    sum_new = pairwise_sum(_one_group_new_source, num_cells);
+    ratio = sum_new / num_cells;
+
+    if (wielandt_inverse == 0.)
+      k_eff = ratio;
+    else if (ratio > 0.)
+      k_eff = 1. / (1. / ratio + wielandt_inverse);
+    else {
+      log_printf(WARNING, "Turning off the CMFD Wielandt shift for this "
+                 "solve since the shifted one-group eigenvalue %f is "
+                 "negative", ratio);
+      _one_group_A->addMatrix(_one_group_M, wielandt_inverse);
+      wielandt_inverse = 0.;
+      use_shift = false;
+      continue;
+    }
+
+    /* Compute the source RMS error */
+    residual = 0.0;
+    for (int i = 0; i < num_cells; i++){
+      if (_one_group_new_source[i] != 0.0)
+        residual += pow((_one_group_new_source[i] - ratio *
+                         _one_group_old_source[i]) /
+                        _one_group_new_source[i], 2);
+    }
+    residual = sqrt(residual / num_cells);
+
+    /* Normalize the new source to have an average value of 1.0 */
+    scale_val = num_cells / sum_new;
+    vector_scale(_one_group_new_source, scale_val, num_cells);
+    vector_copy(_one_group_new_source, _one_group_old_source, num_cells);
+
+    num_iterations++;
+
+    log_printf(DEBUG, "CMFD one-group iter: %i, keff: %f, error: %f",
+               iter, k_eff, residual);
+
+    if (residual < tolerance)
+      break;
+  }
+
+  _num_one_group_iterations += num_iterations;
+
+  /* Prolong the one-group flux to the multigroup flux unless the collapsed
+   * flux already solves the one-group problem */
+  if (num_iterations > 1){
+    #pragma omp parallel for
+    for (int i = 0; i < num_cells; i++){
+      if (_collapsed_flux[i] != 0.){
+        FP_PRECISION ratio = _one_group_flux[i] / _collapsed_flux[i];
+        for (int g = 0; g < ng; g++)
+          flux[i*ng+g] *= ratio;
+      }
+    }
+  }
+
+  _one_group_solve_time += omp_get_wtime() - start_time;
+
+  return k_eff;
+}
+
+
+/**
+ * @brief Shifts the A matrix for Wielandt shifted power iterations.
+ * @details The A matrix is replaced by \f$ A - M / k_s \f$ with the shifted
+ *          eigenvalue \f$ k_s = k_{eff} + \delta \f$ for the Wielandt shift
+ *          \f$ \delta \f$, which reduces the dominance ratio of the power
+ *          iteration from \f$ k_2 / k_1 \f$ to
+ *          \f$ (1/k_1 - 1/k_s) / (1/k_2 - 1/k_s) \f$.
+ * @param k_eff the current estimate of keff (0 to remove the shift)
+ */
+void Cmfd::shiftMatrix(FP_PRECISION k_eff){
+
+  FP_PRECISION wielandt_inverse = 0.;
+  if (k_eff > 0.)
+    wielandt_inverse = 1. / (k_eff + _wielandt_shift);
+
+  FP_PRECISION change = wielandt_inverse - _wielandt_inverse;
+  _wielandt_inverse = wielandt_inverse;
+
+  _A->addMatrix(_M, -change);
+}
+
+
+/**
+ * @brief Replaces the old source with the Chebyshev extrapolation of the
+ *        new source.
+ * @details The normalized sources are extrapolated as
+ *          \f$ s_{n+1} = s_n + \alpha_p (\hat{s}_{n+1} - s_n) + \beta_p
+ *          (s_n - s_{n-1}) \f$, with the coefficients of the p-th step of a
+ *          Chebyshev cycle, unless chebyshev_next_step(...) calls for a power
+ *          iteration or the extrapolated source is negative.
+ * @param residual the residual of the new source
+ * @return whether the old source was replaced by the extrapolated source
+ */
+bool Cmfd::extrapolateSource(FP_PRECISION residual){
+
+  int size = _num_x*_num_y*_num_cmfd_groups;
+  int last_step = _chebyshev_step;
+
+  _chebyshev_step = chebyshev_next_step(last_step, _chebyshev_order,
+                                        &_chebyshev_num_power_iterations,
+                                        residual, &_chebyshev_residual,
+                                        &_chebyshev_cycle_residual,
+                                        &_dominance_ratio);
+
+  /* Keep the old source as the previous source for power iterations */
+  if (_chebyshev_step == 0){
+    vector_copy(_old_source, _previous_source, size);
+    return false;
+  }
+
+  double alpha, beta;
+  chebyshev_coefficients(_chebyshev_step, _dominance_ratio, &alpha, &beta);
+
+  /* Extrapolate into the previous source */
+  bool negative = false;
+
+  for (int i = 0; i < size; i++){
+    _previous_source[i] = _old_source[i] +
+        alpha * (_new_source[i] - _old_source[i]) +
+        beta * (_old_source[i] - _previous_source[i]);
+    if (_previous_source[i] < 0.0)
+      negative = true;
+  }
+
+  if (negative){
+    log_printf(DEBUG, "Restarting CMFD Chebyshev extrapolation since the "
+               "extrapolated source is negative");
+    _chebyshev_step = 0;
+    _chebyshev_num_power_iterations = 0;
+    vector_copy(_old_source, _previous_source, size);
+    return false;
+  }
+
+  std::swap(_old_source, _previous_source);
+  return true;
+}
+
+
+/**
+ * @brief Solve the linear system Ax=b with the selected linear solver.
+ * @details The number of iterations and time for each solve are logged
+ *          and added to the totals reported by getLinearSolveIterations()
+ *          and getLinearSolveTime().
+ * @param pointer to A matrix
+ * @param pointer to x vector
+ * @param pointer to b vector
+ * @param flux convergence criteria
+ * @param the maximum number of iterations
+ */
+void Cmfd::linearSolve(Matrix* mat, FP_PRECISION* vec_x, FP_PRECISION* vec_b,
+                       FP_PRECISION conv, int max_iter){
+
+  ScopedTimer timer("linearSolve");
+
+  double start_time = omp_get_wtime();
+  int iter;
+
+  if (_linear_solver_type == BICGSTAB)
+    iter = solveBiCGSTAB(mat, vec_x, vec_b, conv, max_iter);
+  else
+    iter = solveGaussSeidel(mat, vec_x, vec_b, conv, max_iter);
+
+  double solve_time = omp_get_wtime() - start_time;
+
+  _num_linear_solves++;
+  _linear_solve_iterations += iter;
+  _linear_solve_time += solve_time;
+
+  log_printf(DEBUG, "linear solver iterations: %i, time: %1.4E sec",
+             iter, solve_time);
+}
+
+
 /**
  * @brief Solve the linear system Ax=b using Gauss Seidel with SOR.
  * @param pointer to A matrix
@@ -629,148 +1057,291 @@ FP_PRECISION Cmfd::computeKeff(int moc_iteration){
  * @param pointer to b vector
  * @param flux convergence criteria
  * @param the maximum number of iterations
+ * @return the number of iterations
  */
-void Cmfd::linearSolve(FP_PRECISION** mat, FP_PRECISION* vec_x, 
-                       FP_PRECISION* vec_b, FP_PRECISION conv, int max_iter){
+int Cmfd::solveGaussSeidel(Matrix* mat, FP_PRECISION* vec_x,
+                           FP_PRECISION* vec_b, FP_PRECISION conv,
+                           int max_iter){
 
   FP_PRECISION residual = 1E10;
-  int row, cell;
-  FP_PRECISION val;
+  int size = mat->getNumRows();
   int iter = 0;
 
   while (iter < max_iter){
 
     /* Pass new flux to old flux */
-    vector_copy(vec_x, _flux_temp, _num_x*_num_y*_num_cmfd_groups);
+    vector_copy(vec_x, _flux_temp, size);
 
     /* Iteration over red cells */
-    #pragma omp parallel for private(row, val, cell)
-    for (int y = 0; y < _num_y; y++){
-      for (int x = y % 2; x < _num_x; x += 2){
+    mat->sweepGaussSeidel(vec_x, vec_b, _SOR_factor, _red_black_cells,
+                          _num_red_cells);
 
-        cell = y*_num_x+x;
+    /* Iteration over black cells */
+    mat->sweepGaussSeidel(vec_x, vec_b, _SOR_factor,
+                          &_red_black_cells[_num_red_cells],
+                          _num_x*_num_y - _num_red_cells);
 
-        for (int g = 0; g < _num_cmfd_groups; g++){
+    /* Compute the average residual */
+    residual = 0.0;
+    for (int i = 0; i < size; i++){
+      if (vec_x[i] != 0.0)
+        residual += pow((vec_x[i] - _flux_temp[i]) / vec_x[i], 2);
+    }
+    residual = pow(residual, 0.5) / size;
 
-          row = cell*_num_cmfd_groups + g;
-          val = 0.0;
-
-          /* Previous flux term */
-          val += (1.0 - _SOR_factor) * vec_x[row];
-
-          /* Source term */
-          val += _SOR_factor*vec_b[row] / mat[cell][g*(_num_cmfd_groups+4)+g+2];
-
-          /* Left surface */
-          if (x != 0)
-            val -= _SOR_factor * vec_x[row - _num_cmfd_groups] *
-                   mat[cell][g*(_num_cmfd_groups+4)] /
-                   mat[cell][g*(_num_cmfd_groups+4)+g+2];
-
-          /* Bottom surface */
-          if (y != 0)
-            val -= _SOR_factor * vec_x[row - _num_x * _num_cmfd_groups] *
-                   mat[cell][g*(_num_cmfd_groups+4)+1] /
-                   mat[cell][g*(_num_cmfd_groups+4)+g+2];
-
-          /* Group-to-group */
-          for (int e = 0; e < _num_cmfd_groups; e++){
-            if (e != g)
-              val -= _SOR_factor * vec_x[cell*_num_cmfd_groups+e] *
-                     mat[cell][g*(_num_cmfd_groups+4)+2+e] /
-                     mat[cell][g*(_num_cmfd_groups+4)+g+2];
-          }
+    /* Increment the interations counter */
+    iter++;
+
+    log_printf(DEBUG, "GS iter: %i, res: %f", iter, residual);
+
+    if (residual < conv && iter > 10)
+      break;
+  }
+
+  return iter;
+}
+
+
+/**
+ * @brief Invert the group-to-group block of the A matrix in each cell for
+ *        the block Jacobi preconditioner.
+ * @param pointer to A matrix
+ */
+void Cmfd::computeBlockInverses(Matrix* mat){
 
-          /* Right surface */
-          if (x != _num_x - 1)
-            val -= _SOR_factor * vec_x[row + _num_cmfd_groups] *
-                   mat[cell][g*(_num_cmfd_groups+4)+_num_cmfd_groups+2] /
-                   mat[cell][g*(_num_cmfd_groups+4)+g+2];
+  int ng = mat->getNumGroups();
+  int* row_pointers = mat->getRowPointers();
+  int* columns = mat->getColumns();
+  FP_PRECISION* values = mat->getValues();
 
-          /* Top surface */
-          if (y != _num_y - 1)
-            val -= _SOR_factor * vec_x[row + _num_cmfd_groups*_num_x] *
-                   mat[cell][g*(_num_cmfd_groups+4)+_num_cmfd_groups+3] /
-                   mat[cell][g*(_num_cmfd_groups+4)+g+2];
+  /* The first cell with a singular block, which is reported after the
+   * parallel region since an error can not be raised within it */
+  int singular_cell = -1;
 
-          vec_x[row] = val;
+  #pragma omp parallel
+  {
+    std::vector<double> diagonal_block(ng*ng), block(ng*ng), column(ng);
+
+    #pragma omp for
+    for (int cell = 0; cell < _num_x*_num_y; cell++){
+
+      FP_PRECISION* inverse = &_block_inverses[cell*ng*ng];
+
+      /* Gather the group-to-group block from the rows of the cell */
+      std::fill(diagonal_block.begin(), diagonal_block.end(), 0.);
+
+      for (int g = 0; g < ng; g++){
+        int row = cell*ng + g;
+        for (int i = row_pointers[row]; i < row_pointers[row+1]; i++){
+          if (columns[i] >= cell*ng && columns[i] < (cell+1)*ng)
+            diagonal_block[g*ng + columns[i] - cell*ng] = values[i];
         }
       }
+
+      /* Solve for each column of the inverse */
+      for (int j = 0; j < ng; j++){
+
+        block = diagonal_block;
+        for (int g = 0; g < ng; g++)
+          column[g] = (g == j) ? 1.0 : 0.0;
+
+        if (!dense_solve(&block[0], &column[0], ng)){
+          #pragma omp critical
+          {
+            if (singular_cell < 0 || cell < singular_cell)
+              singular_cell = cell;
+          }
+          break;
+        }
+
+        for (int g = 0; g < ng; g++)
+          inverse[g*ng+j] = column[g];
+      }
     }
+  }
 
-    /* Iteration over black cells */
-    #pragma omp parallel for private(row, val, cell)
-    for (int y = 0; y < _num_y; y++){
-      for (int x = 1 - y % 2; x < _num_x; x += 2){
+  if (singular_cell >= 0)
+    log_printf(ERROR, "Unable to precondition the CMFD linear system "
+               "since the group-to-group block in cell %d is singular",
+               singular_cell);
+}
 
-        cell = y*_num_x+x;
 
-        for (int g = 0; g < _num_cmfd_groups; g++){
+/**
+ * @brief Apply the block Jacobi preconditioner to a vector (i.e.,
+ *        y = D^-1 x for the group-to-group blocks D of the A matrix).
+ * @param pointer to A matrix
+ * @param pointer to x vector
+ * @param pointer to y vector
+ */
+void Cmfd::applyBlockInverses(Matrix* mat, FP_PRECISION* vec_x,
+                              FP_PRECISION* vec_y){
 
-          row = cell*_num_cmfd_groups + g;
-          val = 0.0;
-
-          /* Previous flux term */
-          val += (1.0 - _SOR_factor) * vec_x[row];
-
-          /* Source term */
-          val += _SOR_factor*vec_b[row] / mat[cell][g*(_num_cmfd_groups+4)+g+2];
-
-          /* Left surface */
-          if (x != 0)
-            val -= _SOR_factor * vec_x[row - _num_cmfd_groups] *
-                   mat[cell][g*(_num_cmfd_groups+4)] /
-                   mat[cell][g*(_num_cmfd_groups+4)+g+2];
-
-          /* Bottom surface */
-          if (y != 0)
-            val -= _SOR_factor * vec_x[row - _num_x * _num_cmfd_groups] *
-                   mat[cell][g*(_num_cmfd_groups+4)+1] /
-                   mat[cell][g*(_num_cmfd_groups+4)+g+2];
-
-          /* Group-to-group */
-          for (int e = 0; e < _num_cmfd_groups; e++){
-            if (e != g)
-              val -= _SOR_factor * vec_x[cell*_num_cmfd_groups+e] *
-                     mat[cell][g*(_num_cmfd_groups+4)+2+e] /
-                     mat[cell][g*(_num_cmfd_groups+4)+g+2];
-          }
+  int ng = mat->getNumGroups();
 
-          /* Right surface */
-          if (x != _num_x - 1)
-            val -= _SOR_factor * vec_x[row + _num_cmfd_groups] *
-                   mat[cell][g*(_num_cmfd_groups+4)+_num_cmfd_groups+2] /
-                   mat[cell][g*(_num_cmfd_groups+4)+g+2];
+  #pragma omp parallel for
+  for (int cell = 0; cell < _num_x*_num_y; cell++){
 
-          /* Top surface */
-          if (y != _num_y - 1)
-            val -= _SOR_factor * vec_x[row + _num_cmfd_groups*_num_x] *
-                   mat[cell][g*(_num_cmfd_groups+4)+_num_cmfd_groups+3] /
-                   mat[cell][g*(_num_cmfd_groups+4)+g+2];
+    FP_PRECISION* inverse = &_block_inverses[cell*ng*ng];
 
-          vec_x[row] = val;
-        }
-      }
+    for (int g = 0; g < ng; g++){
+      FP_PRECISION val = 0.0;
+      for (int e = 0; e < ng; e++)
+        val += inverse[g*ng+e] * vec_x[cell*ng+e];
+      vec_y[cell*ng+g] = val;
     }
+  }
+}
 
-    /* Compute the average residual */
-    residual = 0.0;
-    for (int i = 0; i < _num_x*_num_y*_num_cmfd_groups; i++){
-      if (vec_x[i] != 0.0)
-        residual += pow((vec_x[i] - _flux_temp[i]) / vec_x[i], 2);
+
+/**
+ * @brief Solve the linear system Ax=b using BiCGSTAB with a block Jacobi
+ *        preconditioner.
+ * @details The preconditioner inverts the coupling between energy groups
+ *          in each cell and is applied on the right. The solve converges
+ *          when the L2 norm of the residual is less than the convergence
+ *          criteria times the L2 norm of b, and is restarted from the
+ *          current solution on a breakdown.
+ * @param pointer to A matrix
+ * @param pointer to x vector
+ * @param pointer to b vector
+ * @param flux convergence criteria
+ * @param the maximum number of iterations
+ * @return the number of iterations
+ */
+int Cmfd::solveBiCGSTAB(Matrix* mat, FP_PRECISION* vec_x,
+                        FP_PRECISION* vec_b, FP_PRECISION conv,
+                        int max_iter){
+
+  int size = mat->getNumRows();
+
+  /* Allocate for the multigroup systems, which are the largest solved */
+  if (_krylov_vectors == NULL){
+    _krylov_vectors = new FP_PRECISION[7*_num_x*_num_y*_num_cmfd_groups];
+    _block_inverses = new FP_PRECISION[_num_x*_num_y*_num_cmfd_groups*
+                                       _num_cmfd_groups];
+  }
+
+  FP_PRECISION* r = &_krylov_vectors[0];
+  FP_PRECISION* r_hat = &_krylov_vectors[size];
+  FP_PRECISION* p = &_krylov_vectors[2*size];
+  FP_PRECISION* v = &_krylov_vectors[3*size];
+  FP_PRECISION* p_hat = &_krylov_vectors[4*size];
+  FP_PRECISION* s = &_krylov_vectors[5*size];
+  FP_PRECISION* t = &_krylov_vectors[6*size];
+
+  computeBlockInverses(mat);
+
+  /* The criteria can not be tighter than the floating point precision */
+  double tolerance = std::max(double(conv),
+      10. * std::numeric_limits<FP_PRECISION>::epsilon());
+  double norm_b = vector_norm(vec_b, size);
+  if (norm_b == 0.){
+    vector_zero(vec_x, size);
+    return 0;
+  }
+
+  double rho = 1., alpha = 1., omega = 1., rho_new, norm_r = 0.;
+  bool restart = true;
+  int iter = 0;
+
+  while (iter < max_iter){
+
+    /* Compute the residual r = b - Ax to start or restart */
+    if (restart){
+      mat->multiply(vec_x, r);
+
+      #pragma omp parallel for
+      for (int i = 0; i < size; i++)
+        r[i] = vec_b[i] - r[i];
+
+      norm_r = vector_norm(r, size);
+      if (norm_r <= tolerance * norm_b)
+        break;
+
+      vector_copy(r, r_hat, size);
+      vector_zero(p, size);
+      vector_zero(v, size);
+      rho = alpha = omega = 1.;
+      restart = false;
     }
-    residual = pow(residual, 0.5) / (_num_x*_num_y*_num_cmfd_groups);
 
-    /* Increment the interations counter */
     iter++;
 
-    log_printf(DEBUG, "GS iter: %i, res: %f", iter, residual);
+    rho_new = vector_dot(r_hat, r, size);
+    if (rho_new == 0.){
+      restart = true;
+      continue;
+    }
 
-    if (residual < conv && iter > 10)
+    /* Update the search direction */
+    double beta = (rho_new / rho) * (alpha / omega);
+
+    #pragma omp parallel for
+    for (int i = 0; i < size; i++)
+      p[i] = r[i] + beta * (p[i] - omega * v[i]);
+
+    applyBlockInverses(mat, p, p_hat);
+    mat->multiply(p_hat, v);
+
+    double r_hat_v = vector_dot(r_hat, v, size);
+    if (r_hat_v == 0.){
+      restart = true;
+      continue;
+    }
+
+    alpha = rho_new / r_hat_v;
+    double norm_s = 0.;
+
+    #pragma omp parallel for reduction(+:norm_s)
+    for (int i = 0; i < size; i++){
+      s[i] = r[i] - alpha * v[i];
+      norm_s += double(s[i]) * s[i];
+    }
+
+    /* Check for convergence after the half step */
+    if (sqrt(norm_s) <= tolerance * norm_b){
+      for (int i = 0; i < size; i++)
+        vec_x[i] += alpha * p_hat[i];
+      break;
+    }
+
+    /* Stabilize with a minimal residual step (reusing r for the
+     * preconditioned half step residual) */
+    applyBlockInverses(mat, s, r);
+    mat->multiply(r, t);
+
+    double t_t = 0., t_s = 0.;
+
+    #pragma omp parallel for reduction(+:t_t,t_s)
+    for (int i = 0; i < size; i++){
+      t_t += double(t[i]) * t[i];
+      t_s += double(t[i]) * s[i];
+    }
+
+    omega = (t_t > 0.) ? t_s / t_t : 0.;
+    norm_r = 0.;
+
+    #pragma omp parallel for reduction(+:norm_r)
+    for (int i = 0; i < size; i++){
+      vec_x[i] += alpha * p_hat[i] + omega * r[i];
+      r[i] = s[i] - omega * t[i];
+      norm_r += double(r[i]) * r[i];
+    }
+
+    rho = rho_new;
+
+    norm_r = sqrt(norm_r);
+    log_printf(DEBUG, "BiCGSTAB iter: %i, res: %e", iter, norm_r / norm_b);
+
+    if (norm_r <= tolerance * norm_b)
       break;
+
+    if (omega == 0.)
+      restart = true;
   }
 
-  log_printf(DEBUG, "linear solver iterations: %i", iter);
+  return iter;
 }
 
 
@@ -782,13 +1353,11 @@ void Cmfd::rescaleFlux(){
   FP_PRECISION sum_new, sum_old, scale_val;
 
   /* Rescale the new and old flux to have an avg source of 1.0 */
-  matrix_multiplication(_M, _new_flux, _new_source, _num_x*_num_y, 
-      _num_cmfd_groups);
+  _M->multiply(_new_flux, _new_source);
   sum_new = pairwise_sum(_new_source, _num_x*_num_y*_num_cmfd_groups);
   scale_val = _num_x*_num_y*_num_cmfd_groups / sum_new;
   vector_scale(_new_flux, scale_val, _num_x*_num_y*_num_cmfd_groups);
-  matrix_multiplication(_M, _old_flux, _old_source, _num_x*_num_y, 
-          _num_cmfd_groups);
+  _M->multiply(_old_flux, _old_source);
   sum_old = pairwise_sum(_old_source, _num_x*_num_y*_num_cmfd_groups);
   scale_val = _num_x*_num_y*_num_cmfd_groups / sum_old;
   vector_scale(_old_flux, scale_val, _num_x*_num_y*_num_cmfd_groups);
@@ -800,18 +1369,20 @@ void Cmfd::rescaleFlux(){
  */
 void Cmfd::constructMatrices(){
 
+  ScopedTimer timer("constructMatrices");
+
   log_printf(INFO,"Constructing matrices...");
     
   FP_PRECISION value, volume;
-  int cell, row;
+  int cell;
   Material* material;
   
   /* Zero _A and _M matrices */
-  matrix_zero(_M, _num_cmfd_groups*_num_cmfd_groups, _num_x*_num_y);
-  matrix_zero(_A, _num_cmfd_groups*(_num_cmfd_groups+4), _num_x*_num_y);
+  _M->clear();
+  _A->clear();
   
   /* Loop over cells */
-  #pragma omp parallel for private(value, volume, cell, row, material)
+  #pragma omp parallel for private(value, volume, cell, material)
   for (int y = 0; y < _num_y; y++){
     for (int x = 0; x < _num_x; x++){
 
@@ -821,20 +1392,18 @@ void Cmfd::constructMatrices(){
 
       /* Loop over groups */
       for (int e = 0; e < _num_cmfd_groups; e++){
-          
-        row = cell*_num_cmfd_groups + e;
-    
+
         /* Absorption term */
         value = material->getSigmaA()[e] * volume;
-        _A[cell][e*(_num_cmfd_groups+4)+e+2] += value;
+        _A->incrementValue(cell, e, cell, e, value);
         
         /* Out (1st) and in (2nd) scattering */
         for (int g = 0; g < _num_cmfd_groups; g++){
           if (e != g){
             value = material->getSigmaS()[g*_num_cmfd_groups + e] * volume;
-            _A[cell][e*(_num_cmfd_groups+4)+e+2] += value;
+            _A->incrementValue(cell, e, cell, e, value);
             value = - material->getSigmaS()[e*_num_cmfd_groups + g] * volume;
-            _A[cell][e*(_num_cmfd_groups+4)+g+2] += value;
+            _A->incrementValue(cell, g, cell, e, value);
           }
         }
 
@@ -845,7 +1414,7 @@ void Cmfd::constructMatrices(){
                 - material->getDifTilde()[2*_num_cmfd_groups + e])
           * _cell_height;
         
-        _A[cell][e*(_num_cmfd_groups+4)+e+2] += value;
+        _A->incrementValue(cell, e, cell, e, value);
 
         /* Set transport term on off diagonal */
         if (x != _num_x - 1){
@@ -853,7 +1422,7 @@ void Cmfd::constructMatrices(){
                   + material->getDifTilde()[2*_num_cmfd_groups + e])
                   * _cell_height;
             
-          _A[cell][e*(_num_cmfd_groups+4)+_num_cmfd_groups+2] += value;
+          _A->incrementValue(cell+1, e, cell, e, value);
         }
 
         /* LEFT SURFACE */
@@ -864,7 +1433,7 @@ void Cmfd::constructMatrices(){
             * _cell_height;
         
 
-        _A[cell][e*(_num_cmfd_groups+4)+e+2] += value;
+        _A->incrementValue(cell, e, cell, e, value);
 
         /* Set transport term on off diagonal */
         if (x != 0){
@@ -872,7 +1441,7 @@ void Cmfd::constructMatrices(){
                      - material->getDifTilde()[e])
               * _cell_height;
           
-          _A[cell][e*(_num_cmfd_groups+4)] += value;
+          _A->incrementValue(cell-1, e, cell, e, value);
         }
 
         /* BOTTOM SURFACE */
@@ -882,7 +1451,7 @@ void Cmfd::constructMatrices(){
                 + material->getDifTilde()[1*_num_cmfd_groups + e])
                 * _cell_width;
         
-        _A[cell][e*(_num_cmfd_groups+4)+e+2] += value;
+        _A->incrementValue(cell, e, cell, e, value);
 
         /* Set transport term on off diagonal */
         if (y != 0){
@@ -890,7 +1459,7 @@ void Cmfd::constructMatrices(){
                   - material->getDifTilde()[1*_num_cmfd_groups + e])
               * _cell_width;
           
-          _A[cell][e*(_num_cmfd_groups+4)+1] += value;
+          _A->incrementValue(cell-_num_x, e, cell, e, value);
         }
 
         /* TOP SURFACE */
@@ -900,7 +1469,7 @@ void Cmfd::constructMatrices(){
                 - material->getDifTilde()[3*_num_cmfd_groups + e])
             * _cell_width;
         
-        _A[cell][e*(_num_cmfd_groups+4)+e+2] += value;
+        _A->incrementValue(cell, e, cell, e, value);
 
         /* Set transport term on off diagonal */
         if (y != _num_y - 1){
@@ -908,7 +1477,7 @@ void Cmfd::constructMatrices(){
                   + material->getDifTilde()[3*_num_cmfd_groups + e])
                   * _cell_width;
           
-          _A[cell][e*(_num_cmfd_groups+4)+_num_cmfd_groups+3] += value;
+          _A->incrementValue(cell+_num_x, e, cell, e, value);
         }
 
         /* Source term */
@@ -916,58 +1485,78 @@ void Cmfd::constructMatrices(){
           value = material->getChi()[e] * material->getNuSigmaF()[g]
                   * volume;
 
-          _M[cell][e*_num_cmfd_groups+g] += value;
+          _M->incrementValue(cell, g, cell, e, value);
         }
 
         log_printf(DEBUG, "cell: %i, vol; %f", cell, volume);
 
-        for (int i = 0; i < _num_cmfd_groups+4; i++)
-          log_printf(DEBUG, "i: %i, A value: %f",
-                     i, _A[cell][e*(_num_cmfd_groups+4)+i]);
-
         for (int i = 0; i < _num_cmfd_groups; i++)
-          log_printf(DEBUG, "i: %i, M value: %f",
-                     i, _M[cell][e*(_num_cmfd_groups)+i]);
+          log_printf(DEBUG, "i: %i, A value: %f, M value: %f", i,
+                     _A->getValue(cell, i, cell, e),
+                     _M->getValue(cell, i, cell, e));
       }
     }
   }
 
+  /* Add any new entries to the sparsity patterns */
+  _A->assemble();
+  _M->assemble();
+
   log_printf(INFO, "Done constructing matrices...");
 }
 
 
 /**
- * @brief Update the MOC flux in each FSR.
+ * @brief Compute the ratio of new to old CMFD flux in each cell and MOC
+ *        group, and the CMFD cell containing each FSR.
+ * @details The ratios are used to update the MOC scalar and boundary fluxes
+ *          after each CMFD solve.
  */
-void Cmfd::updateMOCFlux(){
+void Cmfd::computeFluxRatios(){
 
-  log_printf(INFO, "Updating MOC flux...");
+  if (_flux_ratios == NULL)
+    _flux_ratios = new FP_PRECISION[_num_x*_num_y*_num_moc_groups];
 
-  /* Loop over mesh cells */
   #pragma omp parallel for
   for (int i = 0; i < _num_x*_num_y; i++){
+    for (int h = 0; h < _num_moc_groups; h++)
+      _flux_ratios[i*_num_moc_groups+h] = getFluxRatio(i, h);
+  }
 
-    std::vector<int>::iterator iter;
+  /* Map each FSR to its CMFD cell */
+  _FSR_cells.assign(_num_FSRs, -1);
 
-    /* Loop over CMFD groups */
-    for (int e = 0; e < _num_cmfd_groups; e++){
+  for (int i = 0; i < _num_x*_num_y; i++){
+    for (size_t r = 0; r < _cell_fsrs.at(i).size(); r++)
+      _FSR_cells.at(_cell_fsrs.at(i)[r]) = i;
+  }
+}
 
-      for (int h = _group_indices[e]; h < _group_indices[e+1]; h++){
 
-        /* Loop over FRSs in mesh cell */
-        for (iter = _cell_fsrs.at(i).begin();
-          iter != _cell_fsrs.at(i).end(); ++iter) {
+/**
+ * @brief Update the MOC flux in each FSR.
+ * @details The flux in each FSR is scaled by the flux ratios computed by
+ *          computeFluxRatios() for its CMFD cell.
+ */
+void Cmfd::updateMOCFlux(){
 
-          /* Set new flux in FSR */
-            _FSR_fluxes[*iter*_num_moc_groups+h] = getFluxRatio(i,h)
-             * _FSR_fluxes[*iter*_num_moc_groups+h];
+  ScopedTimer timer("updateMOCFlux");
 
-          log_printf(DEBUG, "Updating flux in FSR: %i, cell: %i, group: "
-                     "%i, ratio: %f", *iter ,i, h,
-                     getFluxRatio(i,h));
-        }
-      }
-    }
+  log_printf(INFO, "Updating MOC flux...");
+
+  /* Loop over FSRs */
+  #pragma omp parallel for schedule(guided)
+  for (int r = 0; r < _num_FSRs; r++){
+
+    if (_FSR_cells[r] == -1)
+      continue;
+
+    FP_PRECISION* ratios = &_flux_ratios[_FSR_cells[r]*_num_moc_groups];
+    FP_PRECISION* fluxes = &_FSR_fluxes[r*_num_moc_groups];
+
+    /* Set new flux in FSR */
+    for (int h = 0; h < _num_moc_groups; h++)
+      fluxes[h] *= ratios[h];
   }
 }
 
@@ -1167,7 +1756,9 @@ void Cmfd::initializeMaterials(){
  * @details Instantiates a dummy Cmfd object if one was not assigned to
  *          the Solver by the user and initializes FSRs, Materials, fluxes
  *          and the Mesh. This method intializes a global array for the
- *          surface currents.
+ *          surface currents, and a private copy of it for each of the
+ *          Solver's OpenMP threads (see setNumThreads(...)) so that currents
+ *          are tallied without locks.
  */
 void Cmfd::initializeSurfaceCurrents() {
 
@@ -1175,21 +1766,18 @@ void Cmfd::initializeSurfaceCurrents() {
   if (_surface_currents != NULL)
     delete [] _surface_currents;
 
-  if (_surface_locks != NULL)
-    delete [] _surface_locks;
+  if (_thread_surface_currents != NULL)
+    delete [] _thread_surface_currents;
 
   /* Allocate memory for the Cmfd Mesh surface currents array */
   int num_mesh_cells = _num_x * _num_y;
   int size = num_mesh_cells * _num_cmfd_groups * 8;
   _surface_currents = new FP_PRECISION[size];
 
-  /* Allocate memory for OpenMP locks for each Cmfd Mesh surface */ 
-  _surface_locks = new omp_lock_t[num_mesh_cells * 8];
+  /* Allocate memory for the surface currents tallied by each thread */
+  _thread_surface_currents = new FP_PRECISION[_num_threads * size];
 
-  /* Loop over all mesh cell surfaces to initialize OpenMP locks */
-  #pragma omp parallel for schedule(guided)
-  for (int r=0; r < num_mesh_cells * 8; r++)
-    omp_init_lock(&_surface_locks[r]);
+  zeroSurfaceCurrents();
 
   return;
 }
@@ -1740,15 +2328,340 @@ void Cmfd::setSourceConvergenceThreshold(FP_PRECISION source_thresh) {
  */
 void Cmfd::setPolarQuadrature(PolarQuad* polar_quad) {
 
-  /* Deletes the old Quadrature if one existed */
-  if (_polar_quad != NULL)
-    delete _polar_quad;
-
+  /* The PolarQuad is owned by the Solver, which may already have deleted
+   * a previous one, so it is not deleted here */
   _polar_quad = polar_quad;
   _num_polar = polar_quad->getNumPolarAngles();
 }
 
 
+/**
+ * @brief Get the number of relaxed surface diffusion coefficient corrections
+ *        (\f$ \tilde{D} \f$) for all Mesh cells, surfaces and CMFD groups.
+ * @return the number of surface diffusion coefficient corrections
+ */
+int Cmfd::getNumDifTildes(){
+  return _num_x * _num_y * 4 * _num_cmfd_groups;
+}
+
+
+/**
+ * @brief Copies the relaxed surface diffusion coefficient corrections for
+ *        each Mesh cell into an array.
+ * @details The corrections are underrelaxed from one MOC iteration to the
+ *          next and are stored in Solver checkpoints so that a restarted
+ *          calculation resumes from the same state. The array is indexed by
+ *          Mesh cell, surface and CMFD group, and is zero before the first
+ *          diffusion solve.
+ * @param dif_tildes an array to store the corrections
+ * @param num_dif_tildes the number of corrections (from getNumDifTildes())
+ */
+void Cmfd::getDifTildes(FP_PRECISION* dif_tildes, int num_dif_tildes){
+
+  if (num_dif_tildes != getNumDifTildes())
+    log_printf(ERROR, "Unable to get %d CMFD surface diffusion coefficient "
+               "corrections since there are %d", num_dif_tildes,
+               getNumDifTildes());
+
+  int size = 4 * _num_cmfd_groups;
+
+  for (int i = 0; i < _num_x*_num_y; i++){
+    for (int j = 0; j < size; j++){
+      if (_materials == NULL)
+        dif_tildes[i*size + j] = 0.0;
+      else
+        dif_tildes[i*size + j] = _materials[i]->getDifTilde()[j];
+    }
+  }
+}
+
+
+/**
+ * @brief Sets the relaxed surface diffusion coefficient corrections for
+ *        each Mesh cell from an array.
+ * @details This is used to restore the CMFD state from a Solver checkpoint.
+ *          The Mesh cell Materials are created if they do not yet exist.
+ * @param dif_tildes an array of corrections indexed by Mesh cell, surface
+ *        and CMFD group
+ * @param num_dif_tildes the number of corrections (from getNumDifTildes())
+ */
+void Cmfd::setDifTildes(FP_PRECISION* dif_tildes, int num_dif_tildes){
+
+  if (num_dif_tildes != getNumDifTildes())
+    log_printf(ERROR, "Unable to set %d CMFD surface diffusion coefficient "
+               "corrections since there are %d", num_dif_tildes,
+               getNumDifTildes());
+
+  if (_materials == NULL)
+    initializeMaterials();
+
+  for (int i = 0; i < _num_x*_num_y; i++){
+    for (int s = 0; s < 4; s++){
+      for (int e = 0; e < _num_cmfd_groups; e++){
+        int index = (i*4 + s)*_num_cmfd_groups + e;
+        _materials[i]->setDifTildeByGroup(dif_tildes[index], e+1, s);
+      }
+    }
+  }
+}
+
+
+/**
+ * @brief Returns the Wielandt shift of the CMFD eigenvalue.
+ * @return the Wielandt shift (0 if the eigenvalue is not shifted)
+ */
+FP_PRECISION Cmfd::getWielandtShift(){
+  return _wielandt_shift;
+}
+
+
+/**
+ * @brief Returns the number of steps in each cycle of Chebyshev
+ *        extrapolation of the CMFD power iteration.
+ * @return the Chebyshev order (0 if Chebyshev extrapolation is not used)
+ */
+int Cmfd::getChebyshevOrder(){
+  return _chebyshev_order;
+}
+
+
+/**
+ * @brief Returns the dominance ratio estimated in the last CMFD solve.
+ * @details With Chebyshev extrapolation, this is the dominance ratio fit to
+ *          the error reduction of each Chebyshev cycle. Otherwise it is the
+ *          asymptotic ratio of successive residuals, which is the dominance
+ *          ratio of the shifted problem with a Wielandt shift.
+ * @return the estimated dominance ratio
+ */
+double Cmfd::getDominanceRatio(){
+  return _dominance_ratio;
+}
+
+
+/**
+ * @brief Returns the number of power iterations in the last CMFD solve.
+ * @return the number of power iterations
+ */
+int Cmfd::getNumIterations(){
+  return _num_iterations;
+}
+
+
+/**
+ * @brief Returns the method used to solve the CMFD linear systems.
+ * @return the linear solver type (GAUSS_SEIDEL or BICGSTAB)
+ */
+linearSolverType Cmfd::getLinearSolverType(){
+  return _linear_solver_type;
+}
+
+
+/**
+ * @brief Returns the number of CMFD linear solves.
+ * @return the number of linear solves
+ */
+int Cmfd::getNumLinearSolves(){
+  return _num_linear_solves;
+}
+
+
+/**
+ * @brief Returns the total number of iterations for all CMFD linear solves.
+ * @return the number of linear solver iterations
+ */
+long Cmfd::getLinearSolveIterations(){
+  return _linear_solve_iterations;
+}
+
+
+/**
+ * @brief Returns the total time for all CMFD linear solves.
+ * @return the linear solve time (seconds)
+ */
+double Cmfd::getLinearSolveTime(){
+  return _linear_solve_time;
+}
+
+
+/**
+ * @brief Returns whether the multigroup CMFD power iteration is accelerated
+ *        by a one-group CMFD eigenvalue solve.
+ * @return true if using multilevel CMFD, false otherwise
+ */
+bool Cmfd::isMultilevel(){
+  return _multilevel;
+}
+
+
+/**
+ * @brief Returns the number of one-group power iterations in the last
+ *        multilevel CMFD solve.
+ * @return the number of one-group power iterations
+ */
+int Cmfd::getNumOneGroupIterations(){
+  return _num_one_group_iterations;
+}
+
+
+/**
+ * @brief Returns the time for the multigroup power iterations in the last
+ *        CMFD solve, excluding the one-group solves.
+ * @return the multigroup solve time (seconds)
+ */
+double Cmfd::getMultigroupSolveTime(){
+  return _multigroup_solve_time;
+}
+
+
+/**
+ * @brief Returns the time for the one-group solves in the last multilevel
+ *        CMFD solve.
+ * @return the one-group solve time (seconds)
+ */
+double Cmfd::getOneGroupSolveTime(){
+  return _one_group_solve_time;
+}
+
+
+/**
+ * @brief Returns the number of threads which tally surface currents.
+ * @return the number of threads
+ */
+int Cmfd::getNumThreads(){
+  return _num_threads;
+}
+
+
+/**
+ * @brief Estimates the memory used by the CMFD matrices, vectors, surface
+ *        currents and mesh cell Materials.
+ * @details The estimate is computed from the number of mesh cells, CMFD and
+ *          MOC energy groups, FSRs and OpenMP threads, before the arrays are
+ *          allocated during the first CMFD solve. The loss matrix is assumed
+ *          to couple each cell to its four neighbors.
+ * @return the number of bytes used by CMFD
+ */
+size_t Cmfd::predictMemoryUsage(){
+
+  size_t num_cells = _num_x * _num_y;
+  size_t num_rows = num_cells * _num_cmfd_groups;
+  size_t fp_size = sizeof(FP_PRECISION);
+  size_t nonzero_size = sizeof(int) + fp_size;
+
+  /* The CSR loss and production matrices */
+  size_t num_bytes = num_rows * (_num_cmfd_groups + 4) * nonzero_size +
+    num_rows * _num_cmfd_groups * nonzero_size + 4 * num_rows * sizeof(int);
+
+  /* The sources, fluxes, flux ratios and surface currents */
+  num_bytes += 6 * num_rows * fp_size;
+  num_bytes += num_cells * (sizeof(int) + fp_size + sizeof(Material*));
+  num_bytes += num_cells * _num_moc_groups * fp_size;
+  num_bytes += (_num_threads + 1) * num_rows * 8 * fp_size;
+
+  /* The mesh cell Materials */
+  num_bytes += num_cells * (sizeof(Material) + (_num_cmfd_groups + 16) *
+                            _num_cmfd_groups * fp_size);
+
+  /* The FSRs in each mesh cell */
+  num_bytes += 2 * size_t(_num_FSRs) * sizeof(int);
+
+  /* The BiCGSTAB vectors and block Jacobi preconditioner */
+  if (_linear_solver_type == BICGSTAB)
+    num_bytes += (7 + _num_cmfd_groups) * num_rows * fp_size;
+
+  /* The one-group matrices and vectors */
+  if (_multilevel)
+    num_bytes += num_cells * (6 * nonzero_size + 4 * sizeof(int) +
+                              4 * fp_size);
+
+  return num_bytes;
+}
+
+
+/**
+ * @brief Sets the Wielandt shift of the CMFD eigenvalue.
+ * @details Each CMFD power iteration solves the shifted problem
+ *          \f$ (A - M / k_s) \phi_{n+1} = (1/k_n - 1/k_s) M \phi_n \f$ with
+ *          \f$ k_s = k_n + \delta \f$ for the shift \f$ \delta \f$. Smaller
+ *          shifts need fewer power iterations, each of which needs more
+ *          linear solver iterations. A shift of 0.1 to 0.5 is typical.
+ * @param shift the Wielandt shift (0 to turn off the shift)
+ */
+void Cmfd::setWielandtShift(FP_PRECISION shift){
+
+  if (shift < 0.)
+    log_printf(ERROR, "Unable to set the CMFD Wielandt shift to %f since it "
+               "is negative", shift);
+
+  _wielandt_shift = shift;
+}
+
+
+/**
+ * @brief Sets the method used to solve the CMFD linear systems.
+ * @details Red-black Gauss-Seidel (GAUSS_SEIDEL) is the default. BiCGSTAB
+ *          with a block Jacobi preconditioner (BICGSTAB) needs far fewer
+ *          iterations on fine CMFD meshes, for which the number of
+ *          Gauss-Seidel iterations grows with the square of the number of
+ *          mesh cells across the geometry.
+ * @param solver_type the linear solver type
+ */
+void Cmfd::setLinearSolverType(linearSolverType solver_type){
+  _linear_solver_type = solver_type;
+}
+
+
+/**
+ * @brief Sets whether to accelerate the multigroup CMFD power iteration with
+ *        a one-group CMFD eigenvalue solve.
+ * @details After each multigroup power iteration, the CMFD matrices are
+ *          collapsed to one group with the current flux spectrum in each
+ *          cell. The one-group eigenvalue problem is converged and its flux
+ *          shape is prolonged to the multigroup flux. The cheap one-group
+ *          iterations converge the spatial shape, so that the multigroup
+ *          iterations need only converge the spectrum. This pays off most
+ *          for many CMFD groups on fine meshes. With multilevel CMFD, the
+ *          Wielandt shift is applied to the one-group power iteration and
+ *          Chebyshev extrapolation is not used.
+ * @param multilevel whether to use multilevel CMFD (false by default)
+ */
+void Cmfd::setMultilevel(bool multilevel){
+  _multilevel = multilevel;
+}
+
+
+/**
+ * @brief Sets the number of threads which tally surface currents (>0).
+ * @details This must be the number of threads of the Solver's transport
+ *          sweep so that each thread has private surface currents. It takes
+ *          effect when the surface currents are next initialized.
+ * @param num_threads the number of threads
+ */
+void Cmfd::setNumThreads(int num_threads){
+
+  if (num_threads <= 0)
+    log_printf(ERROR, "Unable to set the number of CMFD threads to %d "
+               "since it is less than or equal to 0", num_threads);
+
+  _num_threads = num_threads;
+}
+
+
+/**
+ * @brief Sets the number of steps in each cycle of Chebyshev extrapolation
+ *        of the CMFD power iteration.
+ * @param order the Chebyshev order (0 to turn off Chebyshev extrapolation)
+ */
+void Cmfd::setChebyshevOrder(int order){
+
+  if (order < 0)
+    log_printf(ERROR, "Unable to set the CMFD Chebyshev order to %d since it "
+               "is negative", order);
+
+  _chebyshev_order = order;
+}
+
+
 /**
  * @brief Get the new to old flux ratio for a CMFD cell.
  * @param the CMFD cell ID
@@ -1778,46 +2691,39 @@ FP_PRECISION Cmfd::getFluxRatio(int cmfd_cell, int moc_group){
 void Cmfd::updateBoundaryFlux(Track** tracks, FP_PRECISION* boundary_flux, 
 			      int num_tracks){
 
-  segment* segments;
-  segment* curr_segment;
-  int num_segments;
-  int bc;
-  FP_PRECISION* track_flux;
-  FP_PRECISION ratio;
-  int cmfd_cell;
-  
   log_printf(INFO, "updating boundary flux");
 
   /* Loop over Tracks */
+  #pragma omp parallel for schedule(guided)
   for (int i=0; i < num_tracks; i++) {
-      
-    num_segments = tracks[i]->getNumSegments();
-    segments = tracks[i]->getSegments();
+
+    int num_segments = tracks[i]->getNumSegments();
+    segment* segments = tracks[i]->getSegments();
+    FP_PRECISION* track_flux;
+    FP_PRECISION* ratios;
+    int cmfd_cell;
 
     /* Update boundary flux in forward direction */
-    bc = (int)tracks[i]->getBCOut();
-    curr_segment = &segments[0];
+    cmfd_cell = _FSR_cells[segments[0]._region_id];
     track_flux = &boundary_flux[i*2*_num_moc_groups*_num_polar];
-    cmfd_cell = convertFSRIdToCmfdCell(curr_segment->_region_id);
-    
-    if (bc){
-      for (int e=0; e < _num_moc_groups; e++) {
-        for (int p=0; p < _num_polar; p++) {
-          track_flux[p*_num_moc_groups+e] *= getFluxRatio(cmfd_cell, e);
-        }
+
+    if (tracks[i]->getBCOut() && cmfd_cell != -1){
+      ratios = &_flux_ratios[cmfd_cell*_num_moc_groups];
+      for (int p=0; p < _num_polar; p++) {
+        for (int e=0; e < _num_moc_groups; e++)
+          track_flux[p*_num_moc_groups+e] *= ratios[e];
       }
     }
 
     /* Update boundary flux in backwards direction */
-    bc = (int)tracks[i]->getBCIn();
-    curr_segment = &segments[num_segments-1];
+    cmfd_cell = _FSR_cells[segments[num_segments-1]._region_id];
     track_flux = &boundary_flux[(i*2 + 1)*_num_moc_groups*_num_polar];
-    
-    if (bc){
-      for (int e=0; e < _num_moc_groups; e++) {
-        for (int p=0; p < _num_polar; p++) {
-          track_flux[p*_num_moc_groups+e] *= getFluxRatio(cmfd_cell, e);
-        }
+
+    if (tracks[i]->getBCIn() && cmfd_cell != -1){
+      ratios = &_flux_ratios[cmfd_cell*_num_moc_groups];
+      for (int p=0; p < _num_polar; p++) {
+        for (int e=0; e < _num_moc_groups; e++)
+          track_flux[p*_num_moc_groups+e] *= ratios[e];
       }
     }
   }
@@ -1829,11 +2735,35 @@ void Cmfd::updateBoundaryFlux(Track** tracks, FP_PRECISION* boundary_flux,
  */
 void Cmfd::zeroSurfaceCurrents() {
 
+  int size = _num_x * _num_y * _num_cmfd_groups * 8;
+
+  #pragma omp parallel for schedule(guided)
+  for (int i=0; i < size; i++)
+    _surface_currents[i] = 0.0;
+
+  #pragma omp parallel for schedule(guided)
+  for (int i=0; i < _num_threads * size; i++)
+    _thread_surface_currents[i] = 0.0;
+
+  return;
+}
+
+
+/**
+ * @brief Adds the surface currents tallied by each thread to the surface
+ *        currents for each mesh cell and energy group.
+ * @details This must be called after each transport sweep which tallies
+ *          surface currents. The thread-private currents are zeroed.
+ */
+void Cmfd::reduceSurfaceCurrents() {
+
+  int size = _num_x * _num_y * _num_cmfd_groups * 8;
+
   #pragma omp parallel for schedule(guided)
-  for (int r=0; r < _num_x*_num_y; r++) {
-    for (int s=0; s < 8; s++) {
-      for (int e=0; e < _num_moc_groups; e++)
-        _surface_currents(r*8+s,e) = 0.0;
+  for (int i=0; i < size; i++) {
+    for (int t=0; t < _num_threads; t++) {
+      _surface_currents[i] += _thread_surface_currents[t*size + i];
+      _thread_surface_currents[t*size + i] = 0.0;
     }
   }
 
@@ -1844,6 +2774,9 @@ void Cmfd::zeroSurfaceCurrents() {
 /**
  * @brief Tallies the current contribution from this segment across the
  *        the appropriate CMFD mesh cell surface.
+ * @details The current is tallied into the calling thread's private
+ *          surface currents, which are added to the surface currents by
+ *          reduceSurfaceCurrents().
  * @param curr_segment the current Track segment
  * @param track_flux the outgoing angular flux for this segment
  * @param polar_weights array of polar weights for some azimuthal angle
@@ -1855,46 +2788,25 @@ void Cmfd::tallySurfaceCurrent(segment* curr_segment, FP_PRECISION* track_flux,
   FP_PRECISION surf_current;
   int surf_id;
 
-  if (curr_segment->_cmfd_surface_fwd != -1 && fwd){
-
+  if (fwd)
     surf_id = curr_segment->_cmfd_surface_fwd;
-
-    for (int e=0; e < _num_moc_groups; e++) {
-      surf_current = 0.;
-
-      for (int p=0; p < _num_polar; p++)
-        surf_current += track_flux(p,e) * polar_weights[p];
-
-      /* Atomically increment the Cmfd Mesh surface current from the
-       * temporary array using mutual exclusion locks */
-      omp_set_lock(&_surface_locks[surf_id]);
-
-      /* Increment current (polar and azimuthal weighted flux, group) */
-      _surface_currents(surf_id, e) += surf_current / 2.;
-
-      /* Release Cmfd Mesh surface mutual exclusion lock */
-      omp_unset_lock(&_surface_locks[surf_id]);
-    }
-  }
-  else if (curr_segment->_cmfd_surface_bwd != -1 && !fwd){
-
+  else
     surf_id = curr_segment->_cmfd_surface_bwd;
 
-    for (int e=0; e < _num_moc_groups; e++) {
-      surf_current = 0.;
+  if (surf_id == -1)
+    return;
 
-      for (int p=0; p < _num_polar; p++)
-        surf_current += track_flux(p,e) * polar_weights[p];
+  int tid = omp_get_thread_num();
+  FP_PRECISION* thread_currents = &_thread_surface_currents
+      [(tid * _num_x * _num_y * 8 + surf_id) * _num_cmfd_groups];
 
-      /* Atomically increment the Cmfd Mesh surface current from the
-       * temporary array using mutual exclusion locks */
-      omp_set_lock(&_surface_locks[surf_id]);
+  for (int e=0; e < _num_moc_groups; e++) {
+    surf_current = 0.;
 
-      /* Increment current (polar and azimuthal weighted flux, group) */
-      _surface_currents(surf_id, e) += surf_current / 2.;
+    for (int p=0; p < _num_polar; p++)
+      surf_current += track_flux(p,e) * polar_weights[p];
 
-      /* Release Cmfd Mesh surface mutual exclusion lock */
-      omp_unset_lock(&_surface_locks[surf_id]);
-    }
+    /* Increment current (polar and azimuthal weighted flux, group) */
+    thread_currents[getCmfdGroup(e)] += surf_current / 2.;
   }
 }
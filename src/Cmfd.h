@@ -10,13 +10,13 @@
 
 #ifdef __cplusplus
 #define _USE_MATH_DEFINES
-#include "Python.h"
 #include "log.h"
 #include "Timer.h"
 #include "Universe.h"
 #include "Track.h"
 #include "PolarQuad.h"
 #include "linalg.h"
+#include "Matrix.h"
 #include "pairwise_sum.h"
 #include <utility>
 #include <math.h>
@@ -26,6 +26,9 @@
 #include <queue>
 #include <iostream>
 #include <fstream>
+#include <vector>
+#include <limits>
+#include <algorithm>
 #endif
 
 
@@ -41,6 +44,20 @@
 						  + getCmfdGroup((e))])
 
 
+/**
+ * @enum linearSolverType
+ * @brief The method used to solve the CMFD linear systems.
+ */
+enum linearSolverType {
+
+  /** Red-black Gauss-Seidel with successive over-relaxation */
+  GAUSS_SEIDEL,
+
+  /** BiCGSTAB with a block Jacobi preconditioner over energy groups */
+  BICGSTAB
+};
+
+
 /**
  * @class Cmfd Cmfd.h "src/Cmfd.h"
  * @brief A class for Coarse Mesh Finite Difference (CMFD) acceleration.
@@ -56,10 +73,17 @@ private:
   FP_PRECISION _k_eff;
 
   /** The A (destruction) matrix */
-  FP_PRECISION** _A;
+  Matrix* _A;
 
   /** The M (production) matrix */
-  FP_PRECISION** _M;
+  Matrix* _M;
+
+  /** The red cells followed by the black cells of the CMFD mesh, in the
+   *  order they are relaxed by Gauss-Seidel */
+  int* _red_black_cells;
+
+  /** The number of red cells in the CMFD mesh */
+  int _num_red_cells;
 
   /** The old source vector */
   FP_PRECISION* _old_source;
@@ -137,12 +161,22 @@ private:
   /** Array of surface currents for each CMFD cell */
   FP_PRECISION* _surface_currents;
 
-  /** OpenMP mutual exclusion locks for atomic surface current updates */
-  omp_lock_t* _surface_locks;
+  /** Thread-private surface currents for each CMFD cell, tallied during
+   *  the transport sweep and reduced into the surface currents after it */
+  FP_PRECISION* _thread_surface_currents;
+
+  /** The number of threads with private surface currents */
+  int _num_threads;
 
   /** Vector of vectors of FSRs containing in each cell */
   std::vector< std::vector<int> > _cell_fsrs;
 
+  /** The CMFD cell containing each FSR (-1 if none) */
+  std::vector<int> _FSR_cells;
+
+  /** The ratio of new to old CMFD flux in each cell and MOC group */
+  FP_PRECISION* _flux_ratios;
+
   /** MOC flux update relaxation factor */
   FP_PRECISION _relax_factor;
 
@@ -155,6 +189,88 @@ private:
   /** Flag indicating whether to update the MOC flux */
   bool _flux_update_on;
 
+  /** The Wielandt shift of the eigenvalue (0 for no shift) */
+  FP_PRECISION _wielandt_shift;
+
+  /** The inverse of the shifted eigenvalue subtracted from the A matrix */
+  FP_PRECISION _wielandt_inverse;
+
+  /** The number of steps in each cycle of Chebyshev extrapolation
+   *  (0 for no extrapolation) */
+  int _chebyshev_order;
+
+  /** The step in the current Chebyshev cycle (0 for a power iteration) */
+  int _chebyshev_step;
+
+  /** The number of power iterations since the last Chebyshev restart */
+  int _chebyshev_num_power_iterations;
+
+  /** The residual at the start of the Chebyshev cycle */
+  double _chebyshev_cycle_residual;
+
+  /** The last residual seen by Chebyshev extrapolation */
+  double _chebyshev_residual;
+
+  /** The source vector before the old source vector */
+  FP_PRECISION* _previous_source;
+
+  /** The estimated dominance ratio of the last CMFD solve */
+  double _dominance_ratio;
+
+  /** The number of power iterations in the last CMFD solve */
+  int _num_iterations;
+
+  /** The method used to solve the CMFD linear systems */
+  linearSolverType _linear_solver_type;
+
+  /** The number of CMFD linear solves */
+  int _num_linear_solves;
+
+  /** The total number of iterations for all CMFD linear solves */
+  long _linear_solve_iterations;
+
+  /** The total time for all CMFD linear solves (seconds) */
+  double _linear_solve_time;
+
+  /** The inverse of the group-to-group block of the A matrix in each cell,
+   *  used to precondition BiCGSTAB */
+  FP_PRECISION* _block_inverses;
+
+  /** The work vectors for BiCGSTAB */
+  FP_PRECISION* _krylov_vectors;
+
+  /** Flag indicating whether to accelerate the multigroup power iteration
+   *  with a one-group CMFD eigenvalue solve */
+  bool _multilevel;
+
+  /** The A matrix collapsed to one group */
+  Matrix* _one_group_A;
+
+  /** The M matrix collapsed to one group */
+  Matrix* _one_group_M;
+
+  /** The multigroup flux summed over groups in each cell */
+  FP_PRECISION* _collapsed_flux;
+
+  /** The one-group flux in each cell */
+  FP_PRECISION* _one_group_flux;
+
+  /** The old one-group source in each cell */
+  FP_PRECISION* _one_group_old_source;
+
+  /** The new one-group source in each cell */
+  FP_PRECISION* _one_group_new_source;
+
+  /** The number of one-group power iterations in the last CMFD solve */
+  int _num_one_group_iterations;
+
+  /** The time for multigroup power iterations in the last CMFD solve,
+   *  excluding the one-group solves (seconds) */
+  double _multigroup_solve_time;
+
+  /** The time for one-group solves in the last CMFD solve (seconds) */
+  double _one_group_solve_time;
+
 public:
 
   Cmfd();
@@ -165,6 +281,7 @@ public:
   void computeDs(int moc_iteration);
   void computeXS();
   void updateMOCFlux();
+  void computeFluxRatios();
   FP_PRECISION computeDiffCorrect(FP_PRECISION d, FP_PRECISION h);
   FP_PRECISION computeKeff(int moc_iteration);
   void initializeCellMap();
@@ -174,8 +291,20 @@ public:
   void initializeSurfaceCurrents();
 
   void rescaleFlux();
-  void linearSolve(FP_PRECISION** mat, FP_PRECISION* vec_x, FP_PRECISION* vec_b,
+  void shiftMatrix(FP_PRECISION k_eff);
+  bool extrapolateSource(FP_PRECISION residual);
+  void linearSolve(Matrix* mat, FP_PRECISION* vec_x, FP_PRECISION* vec_b,
                    FP_PRECISION conv, int max_iter=10000);
+  int solveGaussSeidel(Matrix* mat, FP_PRECISION* vec_x, FP_PRECISION* vec_b,
+                       FP_PRECISION conv, int max_iter);
+  int solveBiCGSTAB(Matrix* mat, FP_PRECISION* vec_x, FP_PRECISION* vec_b,
+                    FP_PRECISION conv, int max_iter);
+  void computeBlockInverses(Matrix* mat);
+  void collapseMatrix(Matrix* mat, Matrix* one_group_mat,
+                      FP_PRECISION* flux);
+  FP_PRECISION solveOneGroup(FP_PRECISION* flux);
+  void applyBlockInverses(Matrix* mat, FP_PRECISION* vec_x,
+                          FP_PRECISION* vec_y);
   void splitCorners();
   int getCellNext(int cell_num, int surface_id);
   int findCmfdCell(LocalCoords* coords);
@@ -184,6 +313,7 @@ public:
   void updateBoundaryFlux(Track** tracks, FP_PRECISION* boundary_flux, 
                           int num_tracks);
   void zeroSurfaceCurrents();
+  void reduceSurfaceCurrents();
   void tallySurfaceCurrent(segment* curr_segment, FP_PRECISION* track_flux, 
                            FP_PRECISION* polar_weights, bool fwd);
 
@@ -202,6 +332,22 @@ public:
   std::vector< std::vector<int> > getCellFSRs();
   bool isFluxUpdateOn();
   FP_PRECISION getFluxRatio(int cmfd_cell, int moc_group);
+  int getNumDifTildes();
+  void getDifTildes(FP_PRECISION* dif_tildes, int num_dif_tildes);
+  FP_PRECISION getWielandtShift();
+  int getChebyshevOrder();
+  double getDominanceRatio();
+  int getNumIterations();
+  linearSolverType getLinearSolverType();
+  int getNumLinearSolves();
+  long getLinearSolveIterations();
+  double getLinearSolveTime();
+  bool isMultilevel();
+  int getNumOneGroupIterations();
+  double getMultigroupSolveTime();
+  double getOneGroupSolveTime();
+  int getNumThreads();
+  size_t predictMemoryUsage();
 
   /* Set parameters */
   void setSORRelaxationFactor(FP_PRECISION SOR_factor);
@@ -220,6 +366,12 @@ public:
   void setGroupStructure(int* group_indices, int length_group_indices);
   void setSourceConvergenceThreshold(FP_PRECISION source_thresh);
   void setPolarQuadrature(PolarQuad* polar_quad);
+  void setDifTildes(FP_PRECISION* dif_tildes, int num_dif_tildes);
+  void setWielandtShift(FP_PRECISION shift);
+  void setChebyshevOrder(int order);
+  void setLinearSolverType(linearSolverType solver_type);
+  void setMultilevel(bool multilevel);
+  void setNumThreads(int num_threads);
   
   /* Set FSR parameters */
   void setFSRMaterials(Material** FSR_materials);
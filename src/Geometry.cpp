@@ -257,10 +257,16 @@ int Geometry::getNumCells() {
 /**
  * @brief Return a std::map container of Material IDs (keys) with Materials
  *        pointers (values).
+ * @details Once the FSRs have been initialized, these are the Materials
+ *          filling the FSRs, which differ from those filling the Cells if
+ *          Materials have been assigned with setFSRMaterial(...).
  * @return a std::map of Materials indexed by Material ID in the geometry
  */
 std::map<int, Material*> Geometry::getAllMaterials() {
 
+  if (_all_materials.size() != 0)
+    return _all_materials;
+
   std::map<int, Material*> all_materials;
   Cell* cell;
   Material* material;
@@ -730,7 +736,8 @@ void Geometry::initializeFlatSourceRegions() {
   /* Build collections of neighbor Cells for optimized ray tracing */
   _root_universe->buildNeighbors();
 
-  /* Create map of Material IDs to Material pointers */
+  /* Create map of Material IDs to Material pointers from the Cells */
+  _all_materials.clear();
   _all_materials = getAllMaterials();
 
   /* Initialize CMFD */
@@ -911,6 +918,167 @@ void Geometry::computeFissionability(Universe* univ) {
 }
 
 
+/**
+ * @brief Mixes an integer into a running hash.
+ * @details The integer is widened to a fixed 64-bit width so that the hash
+ *          is the same on every platform.
+ * @param hash the running hash
+ * @param value the integer to mix into the hash
+ */
+static inline void hash_combine(uint64_t& hash, int value) {
+  int64_t word = value;
+  hash = fnv1a_checksum(&word, sizeof(word), hash);
+}
+
+
+/**
+ * @brief Mixes the bit pattern of a double into a running hash.
+ * @param hash the running hash
+ * @param value the double to mix into the hash
+ */
+static inline void hash_combine(uint64_t& hash, double value) {
+  uint64_t word;
+  memcpy(&word, &value, sizeof(word));
+  hash = fnv1a_checksum(&word, sizeof(word), hash);
+}
+
+
+/**
+ * @brief Computes a hash of the structure of the Geometry.
+ * @details The hash includes the Surfaces bounding each Cell, the ring and
+ *          sector subdivisions of each Cell, the Universe and Lattice
+ *          hierarchy and the CMFD mesh, but not the Materials filling each
+ *          Cell. Two Geometries with the same structural hash produce the
+ *          same Tracks and segments, up to the Material of each segment.
+ *          The hash is built from fixed-width values so that Track files
+ *          and checkpoints which store it are portable across platforms.
+ * @return the structural hash
+ */
+uint64_t Geometry::getStructuralHash() {
+
+  uint64_t hash = FNV1A_OFFSET_BASIS;
+
+  if (_root_universe == NULL)
+    return hash;
+
+  std::map<int, Cell*> all_cells = _root_universe->getAllCells();
+  std::map<int, Universe*> all_universes = _root_universe->getAllUniverses();
+  std::map<int, Cell*>::iterator cell_iter;
+  std::map<int, Universe*>::iterator univ_iter;
+  std::map<int, surface_halfspace> surfaces;
+  std::map<int, surface_halfspace>::iterator surf_iter;
+
+  hash_combine(hash, _root_universe->getId());
+
+  /* Hash each Cell's fill type, subdivisions and bounding Surfaces */
+  for (cell_iter = all_cells.begin(); cell_iter != all_cells.end();
+       ++cell_iter) {
+
+    Cell* cell = cell_iter->second;
+    hash_combine(hash, cell->getId());
+    hash_combine(hash, int(cell->getType()));
+    hash_combine(hash, cell->getNumRings());
+    hash_combine(hash, cell->getNumSectors());
+
+    if (cell->getType() == FILL)
+      hash_combine(hash, cell->getFillUniverse()->getId());
+
+    surfaces = cell->getSurfaces();
+
+    for (surf_iter = surfaces.begin(); surf_iter != surfaces.end();
+         ++surf_iter) {
+
+      Surface* surface = surf_iter->second._surface;
+      hash_combine(hash, surface->getId());
+      hash_combine(hash, surf_iter->second._halfspace);
+      hash_combine(hash, int(surface->getSurfaceType()));
+      hash_combine(hash, int(surface->getBoundaryType()));
+
+      if (surface->getSurfaceType() == CIRCLE) {
+        Circle* circle = static_cast<Circle*>(surface);
+        hash_combine(hash, circle->getX0());
+        hash_combine(hash, circle->getY0());
+        hash_combine(hash, circle->getRadius());
+      }
+      else if (surface->getSurfaceType() != QUADRATIC) {
+        Plane* plane = static_cast<Plane*>(surface);
+        hash_combine(hash, plane->getA());
+        hash_combine(hash, plane->getB());
+        hash_combine(hash, plane->getC());
+      }
+    }
+  }
+
+  /* Hash each Universe's Cells and each Lattice's layout */
+  for (univ_iter = all_universes.begin(); univ_iter != all_universes.end();
+       ++univ_iter) {
+
+    Universe* universe = univ_iter->second;
+    hash_combine(hash, universe->getId());
+    hash_combine(hash, int(universe->getType()));
+
+    if (universe->getType() == LATTICE) {
+      Lattice* lattice = static_cast<Lattice*>(universe);
+      hash_combine(hash, lattice->getNumX());
+      hash_combine(hash, lattice->getNumY());
+      hash_combine(hash, lattice->getWidthX());
+      hash_combine(hash, lattice->getWidthY());
+      hash_combine(hash, lattice->getOffset()->getX());
+      hash_combine(hash, lattice->getOffset()->getY());
+
+      for (int j=0; j < lattice->getNumY(); j++) {
+        for (int i=0; i < lattice->getNumX(); i++)
+          hash_combine(hash, lattice->getUniverse(i, j)->getId());
+      }
+    }
+    else {
+      std::map<int, Cell*> cells = universe->getCells();
+      for (cell_iter = cells.begin(); cell_iter != cells.end(); ++cell_iter)
+        hash_combine(hash, cell_iter->first);
+    }
+  }
+
+  /* Hash the CMFD mesh, which sets the CMFD surfaces of each segment */
+  if (_cmfd != NULL) {
+    hash_combine(hash, _cmfd->getNumX());
+    hash_combine(hash, _cmfd->getNumY());
+
+    Lattice* mesh = _cmfd->getLattice();
+    if (mesh != NULL) {
+      hash_combine(hash, mesh->getWidthX());
+      hash_combine(hash, mesh->getWidthY());
+      hash_combine(hash, mesh->getOffset()->getX());
+      hash_combine(hash, mesh->getOffset()->getY());
+    }
+  }
+
+  return hash;
+}
+
+
+/**
+ * @brief Computes a hash of the Material filling each Cell.
+ * @details Geometries with the same structural hash but a different
+ *          Material hash share the same ray tracing data, but the Material
+ *          assigned to each FSR and segment must be updated.
+ * @return the Material hash
+ */
+uint64_t Geometry::getMaterialHash() {
+
+  uint64_t hash = FNV1A_OFFSET_BASIS;
+  std::map<int, Cell*> material_cells = getAllMaterialCells();
+  std::map<int, Cell*>::iterator iter;
+
+  for (iter = material_cells.begin(); iter != material_cells.end(); ++iter) {
+    hash_combine(hash, iter->first);
+    if (iter->second->getFillMaterial() != NULL)
+      hash_combine(hash, iter->second->getFillMaterial()->getId());
+  }
+
+  return hash;
+}
+
+
 /**
  * @brief Converts this Geometry's attributes to a character array.
  * @details This method calls the toString() method for all Materials,
@@ -1000,6 +1168,191 @@ void Geometry::initializeCmfd(){
 }
 
 
+/**
+ * @brief Returns the outermost Lattice in the CSG tree.
+ * @details The CSG tree is searched breadth first from the root Universe
+ *          through the Universes filling each Cell. If there are several
+ *          Lattices at the shallowest level, the one with the most lattice
+ *          cells is returned.
+ * @return a pointer to the Lattice (NULL if there is no Lattice)
+ */
+Lattice* Geometry::getRootLattice() {
+
+  std::vector<Universe*> universes;
+  std::map<int, Cell*>::iterator iter;
+
+  if (_root_universe != NULL)
+    universes.push_back(_root_universe);
+
+  while (universes.size() > 0) {
+
+    std::vector<Universe*> fill_universes;
+    Lattice* root_lattice = NULL;
+
+    for (size_t i=0; i < universes.size(); i++) {
+
+      if (universes[i]->getType() == LATTICE) {
+        Lattice* lattice = static_cast<Lattice*>(universes[i]);
+
+        if (root_lattice == NULL ||
+            lattice->getNumX() * lattice->getNumY() >
+            root_lattice->getNumX() * root_lattice->getNumY())
+          root_lattice = lattice;
+
+        continue;
+      }
+
+      /* Descend into the Universes filling this Universe's Cells */
+      std::map<int, Cell*> cells = universes[i]->getCells();
+
+      for (iter = cells.begin(); iter != cells.end(); ++iter) {
+        if (iter->second->getType() == FILL &&
+            iter->second->getFillUniverse() != NULL)
+          fill_universes.push_back(iter->second->getFillUniverse());
+      }
+    }
+
+    if (root_lattice != NULL)
+      return root_lattice;
+
+    universes = fill_universes;
+  }
+
+  return NULL;
+}
+
+
+/**
+ * @brief Finds the first thermal energy group from the Materials'
+ *        scattering matrices.
+ * @details The thermal groups begin with the highest energy group which
+ *          receives upscattering in any Material. Without upscattering,
+ *          they begin with the first group below the fission spectrum.
+ * @return the index of the first thermal group (the number of groups if
+ *         none are thermal)
+ */
+int Geometry::findThermalGroup() {
+
+  std::map<int, Material*> materials = getAllMaterials();
+  std::map<int, Material*>::iterator iter;
+  int num_groups = getNumEnergyGroups();
+  int upscatter_group = num_groups;
+  int fission_group = 0;
+
+  for (iter = materials.begin(); iter != materials.end(); ++iter) {
+
+    FP_PRECISION* sigma_s = iter->second->getSigmaS();
+    FP_PRECISION* chi = iter->second->getChi();
+
+    for (int g=0; g < num_groups; g++) {
+
+      /* Upscattering into group g */
+      for (int e=g+1; e < num_groups; e++) {
+        if (sigma_s[g*num_groups+e] > 0.)
+          upscatter_group = std::min(upscatter_group, g);
+      }
+
+      if (chi[g] > 0.)
+        fission_group = std::max(fission_group, g+1);
+    }
+  }
+
+  if (upscatter_group < num_groups)
+    return upscatter_group;
+
+  return fission_group;
+}
+
+
+/**
+ * @brief Creates a CMFD mesh aligned with the outermost Lattice.
+ * @details The mesh has one cell per lattice cell of the Lattice returned
+ *          by getRootLattice(), divided into refinement x refinement cells
+ *          or merged in blocks of coarsening x coarsening lattice cells,
+ *          and spans the Geometry with the lattice pitch. If the Geometry
+ *          has more than two energy groups, the CMFD groups may be
+ *          condensed to a fast and a thermal group, split at the group
+ *          found by findThermalGroup(). The new Cmfd is set on the Geometry
+ *          and returned for further tuning, and must be built before the
+ *          flat source regions are initialized. This method may be called
+ *          from Python as follows:
+ *
+ * @code
+ *          cmfd = geometry.buildCmfd(refinement=1, coarsening=1)
+ *          geometry.initializeFlatSourceRegions()
+ * @endcode
+ *
+ * @param refinement the number of mesh cells along each axis per lattice
+ *        cell
+ * @param coarsening the number of lattice cells along each axis per mesh
+ *        cell
+ * @param condense_groups whether to condense the CMFD groups
+ * @return a pointer to the new Cmfd
+ */
+Cmfd* Geometry::buildCmfd(int refinement, int coarsening,
+                          bool condense_groups) {
+
+  if (refinement < 1 || coarsening < 1)
+    log_printf(ERROR, "Unable to build a CMFD mesh with refinement %d and "
+               "coarsening %d since both must be positive", refinement,
+               coarsening);
+
+  if (_num_FSRs != 0)
+    log_printf(ERROR, "Unable to build a CMFD mesh after the flat source "
+               "regions have been initialized");
+
+  Lattice* lattice = getRootLattice();
+
+  if (lattice == NULL)
+    log_printf(ERROR, "Unable to build a CMFD mesh since the Geometry does "
+               "not contain a Lattice");
+
+  /* Find the number of lattice pitches spanning the Geometry */
+  double num_pitches_x = getWidth() / lattice->getWidthX();
+  double num_pitches_y = getHeight() / lattice->getWidthY();
+  int num_x = std::max(int(round(num_pitches_x)), 1);
+  int num_y = std::max(int(round(num_pitches_y)), 1);
+
+  double offset_x = (lattice->getMinX() - getMinX()) / lattice->getWidthX();
+  double offset_y = (lattice->getMinY() - getMinY()) / lattice->getWidthY();
+
+  if (fabs(num_pitches_x - num_x) > 1E-6 ||
+      fabs(num_pitches_y - num_y) > 1E-6 ||
+      fabs(offset_x - round(offset_x)) > 1E-6 ||
+      fabs(offset_y - round(offset_y)) > 1E-6)
+    log_printf(WARNING, "The CMFD mesh for Lattice %d is not aligned with "
+               "the lattice cells since the Geometry is not spanned by a "
+               "whole number of lattice pitches", lattice->getId());
+
+  if (num_x % coarsening != 0 || num_y % coarsening != 0)
+    log_printf(ERROR, "Unable to coarsen a %d x %d CMFD mesh by %d since the "
+               "mesh cells must be uniform", num_x, num_y, coarsening);
+
+  num_x = num_x / coarsening * refinement;
+  num_y = num_y / coarsening * refinement;
+
+  Cmfd* cmfd = new Cmfd();
+  cmfd->setLatticeStructure(num_x, num_y);
+
+  /* Condense the groups into a fast and a thermal group */
+  int num_groups = getNumEnergyGroups();
+  int thermal_group = findThermalGroup();
+
+  if (condense_groups && num_groups > 2 && thermal_group > 0 &&
+      thermal_group < num_groups) {
+    int group_indices[3] = {1, thermal_group+1, num_groups+1};
+    cmfd->setGroupStructure(group_indices, 3);
+    num_groups = 2;
+  }
+
+  log_printf(NORMAL, "Built a %d x %d CMFD mesh with %d groups from Lattice "
+             "%d", num_x, num_y, num_groups, lattice->getId());
+
+  setCmfd(cmfd);
+  return cmfd;
+}
+
+
 /**
  * @brief Returns the map that maps FSR keys to FSR IDs
  * @return _FSR_keys_map map of FSR keys to FSR IDs
@@ -1032,6 +1385,30 @@ std::vector<int> Geometry::getFSRsToMaterialIDs() {
 }
 
 
+/**
+ * @brief Estimates the memory used by the FSR maps.
+ * @details The estimate includes the FSR key map with its buckets, nodes
+ *          and characteristic Points, and the vectors of FSR keys and
+ *          Material IDs, which grow with the number of FSRs found while
+ *          the Tracks are segmented.
+ * @return the number of bytes used by the FSR maps
+ */
+size_t Geometry::getFSRMemoryUsage() {
+
+  size_t num_bytes = _FSRs_to_keys.capacity() * sizeof(std::size_t) +
+    _FSRs_to_material_IDs.capacity() * sizeof(int);
+
+#ifndef CUDA
+  /* Each node holds the key, the fsr_data, the hash and a next pointer */
+  num_bytes += _FSR_keys_map.bucket_count() * sizeof(void*);
+  num_bytes += _FSR_keys_map.size() * (sizeof(std::size_t) + sizeof(fsr_data)
+                                       + 2 * sizeof(void*) + sizeof(Point));
+#endif
+
+  return num_bytes;
+}
+
+
 /**
  * @brief Sets the _FSR_keys_map map
  * @details The _FSR_keys_map stores a hash of a std::string representing
@@ -1066,6 +1443,59 @@ void Geometry::setFSRsToMaterialIDs(std::vector<int> FSRs_to_material_IDs){
 }
 
 
+/**
+ * @brief Assigns a Material to an FSR.
+ * @details Materials are identified by ID, so the Material also replaces
+ *          any other Material with the same ID in each FSR lookup.
+ * @param fsr_id the ID of the FSR
+ * @param material a pointer to the Material to fill the FSR
+ */
+void Geometry::setFSRMaterial(int fsr_id, Material* material) {
+  setFSRMaterials(&fsr_id, 1, material);
+}
+
+
+/**
+ * @brief Assigns a Material to some FSRs.
+ * @details Materials are identified by ID, so the Material also replaces
+ *          any other Material with the same ID in each FSR lookup. A
+ *          Material which no longer fills any FSR is removed from the
+ *          Geometry's Materials.
+ * @param fsr_ids an array of FSR IDs
+ * @param num_fsr_ids the number of FSR IDs
+ * @param material a pointer to the Material to fill the FSRs
+ */
+void Geometry::setFSRMaterials(int* fsr_ids, int num_fsr_ids,
+                               Material* material) {
+
+  if (_all_materials.size() == 0)
+    _all_materials = getAllMaterials();
+
+  std::set<int> replaced_ids;
+
+  for (int i=0; i < num_fsr_ids; i++) {
+
+    if (fsr_ids[i] < 0 || fsr_ids[i] >= _num_FSRs)
+      log_printf(ERROR, "Unable to set the Material for FSR %d since the FSR "
+                 "IDs lie in the range (0, %d)", fsr_ids[i], _num_FSRs-1);
+
+    replaced_ids.insert(_FSRs_to_material_IDs.at(fsr_ids[i]));
+    _FSRs_to_material_IDs.at(fsr_ids[i]) = material->getId();
+  }
+
+  _all_materials[material->getId()] = material;
+  replaced_ids.erase(material->getId());
+
+  /* Remove the replaced Materials which no longer fill any FSR */
+  for (int r=0; r < _num_FSRs && !replaced_ids.empty(); r++)
+    replaced_ids.erase(_FSRs_to_material_IDs[r]);
+
+  std::set<int>::iterator iter;
+  for (iter = replaced_ids.begin(); iter != replaced_ids.end(); ++iter)
+    _all_materials.erase(*iter);
+}
+
+
 /**
  * @brief Determins whether a point is within the bounding box of the geometry.
  * @param coords a populated LocalCoords linked list
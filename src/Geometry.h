@@ -9,8 +9,8 @@
 #define GEOMETRY_H_
 
 #ifdef __cplusplus
-#include "Python.h"
 #include "Cmfd.h"
+#include "checksum.h"
 #include <limits>
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -18,6 +18,7 @@
 #include <string>
 #include <omp.h>
 #include <functional>
+#include <set>
 #include <unordered_map>
 #endif
 
@@ -98,6 +99,7 @@ private:
 
   Cell* findFirstCell(LocalCoords* coords, double angle);
   Cell* findNextCell(LocalCoords* coords, double angle);
+  int findThermalGroup();
 
 public:
 
@@ -129,8 +131,10 @@ public:
   void setRootUniverse(Universe* root_universe);
 
   Cmfd* getCmfd();
+  Lattice* getRootLattice();
   std::vector<std::size_t> getFSRsToKeys();
   std::vector<int> getFSRsToMaterialIDs();
+  size_t getFSRMemoryUsage();
   int getFSRId(LocalCoords* coords);
   Point* getFSRPoint(int fsr_id);
   std::string getFSRKey(LocalCoords* coords);
@@ -142,6 +146,8 @@ public:
   void setFSRsToMaterialIDs(std::vector<int> FSRs_to_material_IDs);
   void setFSRsToKeys(std::vector<std::size_t> FSRs_to_keys);
   void setNumFSRs(int num_fsrs);
+  void setFSRMaterial(int fsr_id, Material* material);
+  void setFSRMaterials(int* fsr_ids, int num_fsr_ids, Material* material);
   void setCmfd(Cmfd* cmfd);
 
 #ifndef CUDA
@@ -160,9 +166,14 @@ public:
   void segmentize(Track* track);
   void computeFissionability(Universe* univ=NULL);
 
+  uint64_t getStructuralHash();
+  uint64_t getMaterialHash();
+
   std::string toString();
   void printString();
   void initializeCmfd();
+  Cmfd* buildCmfd(int refinement=1, int coarsening=1,
+                  bool condense_groups=true);
   bool withinBounds(LocalCoords* coords);
 };
 
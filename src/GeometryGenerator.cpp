@@ -0,0 +1,504 @@
+#include "GeometryGenerator.h"
+
+
+/**
+ * @brief Constructor sets the lattice structure and the default pin cells.
+ * @details By default, each pin is a 0.54 cm radius circle of fuel with 3
+ *          rings and 8 sectors in a 1.26 cm pitch with 7 energy groups, and
+ *          the Geometry has reflective boundaries.
+ * @param num_x the number of Lattice cells along x at each level
+ * @param num_y the number of Lattice cells along y at each level
+ * @param nesting_depth the number of levels of Lattices
+ */
+GeometryGenerator::GeometryGenerator(int num_x, int num_y,
+                                     int nesting_depth) {
+
+  if (num_x <= 0 || num_y <= 0)
+    log_printf(ERROR, "Unable to generate a Geometry with a %d x %d "
+               "Lattice", num_x, num_y);
+
+  if (nesting_depth <= 0)
+    log_printf(ERROR, "Unable to generate a Geometry with a nesting depth "
+               "of %d", nesting_depth);
+
+  _num_x = num_x;
+  _num_y = num_y;
+  _nesting_depth = nesting_depth;
+  _num_rings = 3;
+  _num_sectors = 8;
+  _pitch = 1.26;
+  _fuel_radius = 0.54;
+  _num_fuel_materials = 1;
+  _moderator_fraction = 0.;
+  _num_groups = 7;
+  _boundary_type = REFLECTIVE;
+  _seed = 1;
+}
+
+
+/**
+ * @brief Destructor clears the Materials of the last Geometry.
+ * @details The Materials are not deleted since the Geometry uses them.
+ */
+GeometryGenerator::~GeometryGenerator() {
+  _materials.clear();
+}
+
+
+/**
+ * @brief Returns the next number of a pseudo-random sequence.
+ * @details This is a linear congruential generator, which gives the same
+ *          sequence on any machine for a given seed.
+ * @param state the state of the sequence, updated in place
+ * @return a pseudo-random number in [0, 1)
+ */
+double GeometryGenerator::random(unsigned int& state) {
+  state = 1664525u * state + 1013904223u;
+  return (state & 0xFFFFFFu) / 16777216.;
+}
+
+
+/**
+ * @brief Sets the number of equal volume rings in the fuel.
+ * @param num_rings the number of rings (0 for none)
+ */
+void GeometryGenerator::setNumRings(int num_rings) {
+
+  if (num_rings < 0)
+    log_printf(ERROR, "Unable to set %d rings for the GeometryGenerator",
+               num_rings);
+
+  _num_rings = num_rings;
+}
+
+
+/**
+ * @brief Sets the number of sectors in the fuel and moderator.
+ * @param num_sectors the number of sectors (0 or 1 for none)
+ */
+void GeometryGenerator::setNumSectors(int num_sectors) {
+
+  if (num_sectors < 0)
+    log_printf(ERROR, "Unable to set %d sectors for the GeometryGenerator",
+               num_sectors);
+
+  _num_sectors = num_sectors;
+}
+
+
+/**
+ * @brief Sets the pin cell pitch.
+ * @param pitch the pitch (cm)
+ */
+void GeometryGenerator::setPitch(double pitch) {
+
+  if (pitch <= 0. || pitch <= 2. * _fuel_radius)
+    log_printf(ERROR, "Unable to set a pitch of %f cm for the "
+               "GeometryGenerator with a fuel radius of %f cm",
+               pitch, _fuel_radius);
+
+  _pitch = pitch;
+}
+
+
+/**
+ * @brief Sets the radius of the fuel.
+ * @param fuel_radius the radius (cm)
+ */
+void GeometryGenerator::setFuelRadius(double fuel_radius) {
+
+  if (fuel_radius <= 0. || 2. * fuel_radius >= _pitch)
+    log_printf(ERROR, "Unable to set a fuel radius of %f cm for the "
+               "GeometryGenerator with a pitch of %f cm",
+               fuel_radius, _pitch);
+
+  _fuel_radius = fuel_radius;
+}
+
+
+/**
+ * @brief Sets the number of fuel Materials to fill the fuel pins with.
+ * @details Each fuel Material has a larger fission cross-section than the
+ *          last (e.g., a higher enrichment).
+ * @param num_fuel_materials the number of fuel Materials
+ */
+void GeometryGenerator::setNumFuelMaterials(int num_fuel_materials) {
+
+  if (num_fuel_materials <= 0)
+    log_printf(ERROR, "Unable to set %d fuel Materials for the "
+               "GeometryGenerator", num_fuel_materials);
+
+  _num_fuel_materials = num_fuel_materials;
+}
+
+
+/**
+ * @brief Sets the fraction of the pins which are moderator holes.
+ * @param moderator_fraction the fraction of the pins in [0, 1)
+ */
+void GeometryGenerator::setModeratorFraction(double moderator_fraction) {
+
+  if (moderator_fraction < 0. || moderator_fraction >= 1.)
+    log_printf(ERROR, "Unable to set a moderator fraction of %f for the "
+               "GeometryGenerator", moderator_fraction);
+
+  _moderator_fraction = moderator_fraction;
+}
+
+
+/**
+ * @brief Sets the number of energy groups of the Materials.
+ * @param num_groups the number of energy groups
+ */
+void GeometryGenerator::setNumEnergyGroups(int num_groups) {
+
+  if (num_groups <= 0)
+    log_printf(ERROR, "Unable to set %d energy groups for the "
+               "GeometryGenerator", num_groups);
+
+  _num_groups = num_groups;
+}
+
+
+/**
+ * @brief Sets the boundary condition on each side of the Geometry.
+ * @param boundary_type the boundary condition (REFLECTIVE or VACUUM)
+ */
+void GeometryGenerator::setBoundaryType(boundaryType boundary_type) {
+  _boundary_type = boundary_type;
+}
+
+
+/**
+ * @brief Sets the seed of the placement of moderator holes and Materials.
+ * @param seed the seed
+ */
+void GeometryGenerator::setSeed(unsigned int seed) {
+  _seed = seed;
+}
+
+
+/**
+ * @brief Returns the number of pins along x.
+ * @return the number of pins along x
+ */
+int GeometryGenerator::getNumPinsX() {
+  return int(pow(double(_num_x), _nesting_depth) + 0.5);
+}
+
+
+/**
+ * @brief Returns the number of pins along y.
+ * @return the number of pins along y
+ */
+int GeometryGenerator::getNumPinsY() {
+  return int(pow(double(_num_y), _nesting_depth) + 0.5);
+}
+
+
+/**
+ * @brief Returns the width of the Geometry along x.
+ * @return the width (cm)
+ */
+double GeometryGenerator::getWidth() {
+  return getNumPinsX() * _pitch;
+}
+
+
+/**
+ * @brief Returns the height of the Geometry along y.
+ * @return the height (cm)
+ */
+double GeometryGenerator::getHeight() {
+  return getNumPinsY() * _pitch;
+}
+
+
+/**
+ * @brief Returns the number of FSRs in each pin.
+ * @return the number of FSRs in each pin
+ */
+int GeometryGenerator::getNumFSRsPerPin() {
+
+  int num_rings = std::max(_num_rings, 1);
+  int num_sectors = std::max(_num_sectors, 1);
+
+  return (num_rings + 1) * num_sectors;
+}
+
+
+/**
+ * @brief Returns the number of FSRs in the Geometry.
+ * @return the number of FSRs
+ */
+long GeometryGenerator::getNumFSRs() {
+  return long(getNumPinsX()) * getNumPinsY() * getNumFSRsPerPin();
+}
+
+
+/**
+ * @brief Returns the total length of the boundaries between FSRs.
+ * @details This is the length of the ring circles and sector planes in
+ *          each pin, and of the boundaries between pins, excluding the
+ *          boundary of the Geometry.
+ * @return the length of the boundaries between FSRs (cm)
+ */
+double GeometryGenerator::getBoundaryLength() {
+
+  /* The circles of the equal volume rings */
+  int num_rings = std::max(_num_rings, 1);
+  double pin_length = 0.;
+
+  for (int i=1; i <= num_rings; i++)
+    pin_length += 2. * M_PI * _fuel_radius * sqrt(double(i) / num_rings);
+
+  /* The sector planes from the center of the pin to the pin boundary,
+   * which are at the angles normal to each of the sector Planes */
+  if (_num_sectors > 1) {
+    for (int i=0; i < _num_sectors; i++) {
+      double angle = 2. * M_PI * i / _num_sectors + M_PI / 2.;
+      pin_length += 0.5 * _pitch /
+        std::max(fabs(cos(angle)), fabs(sin(angle)));
+    }
+  }
+
+  /* The boundaries between the pins */
+  int num_pins_x = getNumPinsX();
+  int num_pins_y = getNumPinsY();
+  double lattice_length = (num_pins_x - 1) * getHeight() +
+    (num_pins_y - 1) * getWidth();
+
+  return double(num_pins_x) * num_pins_y * pin_length + lattice_length;
+}
+
+
+/**
+ * @brief Estimates the number of segments from ray tracing the Geometry.
+ * @details Each Track has one more segment than the number of FSR
+ *          boundaries it crosses. For Tracks which are evenly spread over
+ *          the azimuthal angles, a unit length of Track crosses on average
+ *          \f$ 2L / (\pi A) \f$ boundaries, where L is the length of the
+ *          boundaries (see getBoundaryLength()) and A is the area of the
+ *          Geometry. The total length of the Tracks is the number of angles
+ *          in \f$ [0, \pi) \f$ times A over the spacing, and the number of
+ *          Tracks is on average the perimeter over \f$ \pi \f$ times the
+ *          number of angles over the spacing, so that the number of
+ *          segments is about
+ *
+ *          \f$ \frac{N_{azim}}{\pi \delta} (L + W + H) \f$
+ *
+ *          Since the TrackGenerator reduces the spacing to fit the Tracks
+ *          to the Geometry, and splits segments which are optically too
+ *          thick for the exponential table, this is a slight underestimate.
+ * @param num_azim the number of azimuthal angles in \f$ [0, 2\pi) \f$
+ * @param spacing the track spacing (cm)
+ * @return the estimated number of segments
+ */
+long GeometryGenerator::estimateNumSegments(int num_azim, double spacing) {
+
+  if (num_azim <= 0 || spacing <= 0.)
+    log_printf(ERROR, "Unable to estimate the number of segments for %d "
+               "azimuthal angles and a track spacing of %f cm",
+               num_azim, spacing);
+
+  double length = getBoundaryLength() + getWidth() + getHeight();
+  return long(num_azim * length / (M_PI * spacing));
+}
+
+
+/**
+ * @brief Returns a Material of the last Geometry generated.
+ * @param index the index of a fuel Material, or the number of fuel
+ *        Materials for the moderator
+ * @return a pointer to the Material
+ */
+Material* GeometryGenerator::getMaterial(int index) {
+
+  if (index < 0 || index >= int(_materials.size()))
+    log_printf(ERROR, "Unable to get Material %d from the GeometryGenerator "
+               "which has %d Materials", index, int(_materials.size()));
+
+  return _materials.at(index);
+}
+
+
+/**
+ * @brief Creates the fuel and moderator Materials.
+ * @details The cross-sections vary smoothly from the fast to the thermal
+ *          groups, with in-group scattering and downscattering to the next
+ *          group. The fission cross-section grows with the enrichment of
+ *          each fuel Material and is included in its absorption, so that
+ *          the absorption always exceeds the fission. The scattering
+ *          matrices are indexed by origin and then destination group as in
+ *          Material::setSigmaS(...).
+ */
+void GeometryGenerator::createMaterials() {
+
+  int num_groups = _num_groups;
+  int num_scatter = num_groups * num_groups;
+  std::vector<double> sigma_t(num_groups), sigma_a(num_groups);
+  std::vector<double> sigma_f(num_groups), nu_sigma_f(num_groups);
+  std::vector<double> chi(num_groups, 0.), sigma_s(num_scatter);
+
+  _materials.clear();
+
+  for (int m=0; m <= _num_fuel_materials; m++) {
+
+    bool fuel = (m < _num_fuel_materials);
+    double enrichment = 1. + 0.25 * m;
+    std::fill(sigma_s.begin(), sigma_s.end(), 0.);
+    std::fill(chi.begin(), chi.end(), 0.);
+
+    if (fuel)
+      chi[0] = 1.;
+
+    for (int g=0; g < num_groups; g++) {
+
+      double x = (num_groups > 1) ? double(g) / (num_groups-1) : 0.;
+
+      nu_sigma_f[g] = fuel ? (0.02 + 0.5 * x) * enrichment : 0.;
+      sigma_f[g] = nu_sigma_f[g] / 2.43;
+
+      /* Split the scattering and capture cross-section between in-group
+       * scattering, downscattering and capture */
+      double sigma_sc = fuel ? 0.4 + 0.9 * x : 0.6 + 1.4 * x;
+      sigma_s[g*num_groups + g] = (fuel ? 0.7 : 0.85) * sigma_sc;
+      sigma_a[g] = sigma_sc - sigma_s[g*num_groups + g];
+
+      if (g < num_groups-1) {
+        sigma_s[g*num_groups + g+1] = (fuel ? 0.05 : 0.1) * sigma_sc;
+        sigma_a[g] -= sigma_s[g*num_groups + g+1];
+      }
+
+      /* The absorption is the capture plus the fission */
+      sigma_a[g] += sigma_f[g];
+      sigma_t[g] = sigma_sc + sigma_f[g];
+    }
+
+    Material* material = new Material(0, fuel ? "fuel" : "moderator");
+    material->setNumEnergyGroups(num_groups);
+    material->setSigmaT(&sigma_t[0], num_groups);
+    material->setSigmaA(&sigma_a[0], num_groups);
+    material->setSigmaS(&sigma_s[0], num_scatter);
+    material->setSigmaF(&sigma_f[0], num_groups);
+    material->setNuSigmaF(&nu_sigma_f[0], num_groups);
+    material->setChi(&chi[0], num_groups);
+    _materials.push_back(material);
+  }
+}
+
+
+/**
+ * @brief Creates a pin cell Universe.
+ * @details The circle in the pin is divided into rings and sectors, and the
+ *          moderator around it into the same sectors, for both fuel pins
+ *          and moderator holes.
+ * @param material the Material inside the circle
+ * @param fuel whether the pin is a fuel pin or a moderator hole
+ * @return a pointer to the pin cell Universe
+ */
+Universe* GeometryGenerator::createPin(Material* material, bool fuel) {
+
+  Material* moderator = _materials.back();
+  Circle* circle = new Circle(0., 0., _fuel_radius);
+
+  Cell* inner_cell = new Cell(0, fuel ? "fuel" : "moderator hole");
+  inner_cell->setFill(material);
+  inner_cell->setNumRings(_num_rings);
+  inner_cell->setNumSectors(_num_sectors);
+  inner_cell->addSurface(-1, circle);
+
+  Cell* outer_cell = new Cell(0, "moderator");
+  outer_cell->setFill(moderator);
+  outer_cell->setNumSectors(_num_sectors);
+  outer_cell->addSurface(+1, circle);
+
+  Universe* pin = new Universe(0, fuel ? "fuel pin" : "moderator hole");
+  pin->addCell(inner_cell);
+  pin->addCell(outer_cell);
+
+  return pin;
+}
+
+
+/**
+ * @brief Builds a Geometry of nested Lattices of pin cells.
+ * @details Each position in the innermost Lattice is a moderator hole with
+ *          a probability of the moderator fraction, and is otherwise a fuel
+ *          pin with one of the fuel Materials chosen at random. The
+ *          innermost Lattice is repeated in each of the outer Lattices. The
+ *          Geometry is returned without its FSRs initialized, so that a
+ *          Cmfd may be added before Geometry::initializeFlatSourceRegions()
+ *          is called.
+ * @return a pointer to the Geometry
+ */
+Geometry* GeometryGenerator::generateGeometry() {
+
+  log_printf(NORMAL, "Generating a %d x %d pin Geometry with %ld FSRs...",
+             getNumPinsX(), getNumPinsY(), getNumFSRs());
+
+  createMaterials();
+
+  std::vector<Universe*> fuel_pins;
+  for (int m=0; m < _num_fuel_materials; m++)
+    fuel_pins.push_back(createPin(_materials.at(m), true));
+
+  Universe* hole = createPin(_materials.back(), false);
+
+  /* Fill the innermost Lattice with pins */
+  unsigned int state = _seed;
+  std::vector<Universe*> universes(_num_x * _num_y);
+
+  for (int i=0; i < _num_x * _num_y; i++) {
+    if (random(state) < _moderator_fraction)
+      universes[i] = hole;
+    else
+      universes[i] = fuel_pins.at(int(random(state) * _num_fuel_materials));
+  }
+
+  /* Nest each level of Lattices in a Lattice of the next level */
+  Universe* level = NULL;
+  double width_x = _pitch;
+  double width_y = _pitch;
+
+  for (int d=0; d < _nesting_depth; d++) {
+
+    Lattice* lattice = new Lattice(0, (d == 0) ? "pins" : "lattices");
+    lattice->setWidth(width_x, width_y);
+    lattice->setUniverses(_num_y, _num_x, &universes[0]);
+
+    Cell* cell = new Cell();
+    cell->setFill(lattice);
+    level = new Universe();
+    level->addCell(cell);
+
+    std::fill(universes.begin(), universes.end(), level);
+    width_x *= _num_x;
+    width_y *= _num_y;
+  }
+
+  /* Bound the outermost Lattice */
+  XPlane* left = new XPlane(-getWidth() / 2., 0, "left");
+  XPlane* right = new XPlane(getWidth() / 2., 0, "right");
+  YPlane* bottom = new YPlane(-getHeight() / 2., 0, "bottom");
+  YPlane* top = new YPlane(getHeight() / 2., 0, "top");
+  left->setBoundaryType(_boundary_type);
+  right->setBoundaryType(_boundary_type);
+  bottom->setBoundaryType(_boundary_type);
+  top->setBoundaryType(_boundary_type);
+
+  Cell* root_cell = new Cell(0, "root");
+  root_cell->setFill(level);
+  root_cell->addSurface(+1, left);
+  root_cell->addSurface(-1, right);
+  root_cell->addSurface(+1, bottom);
+  root_cell->addSurface(-1, top);
+
+  Universe* root_universe = new Universe(0, "root");
+  root_universe->addCell(root_cell);
+
+  Geometry* geometry = new Geometry();
+  geometry->setRootUniverse(root_universe);
+
+  return geometry;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file GeometryGenerator.h
+ * @brief The GeometryGenerator class.
+ * @date October 18, 2026
+ */
+
+#ifndef GEOMETRYGENERATOR_H_
+#define GEOMETRYGENERATOR_H_
+
+#ifdef __cplusplus
+#include "Geometry.h"
+#include <vector>
+#include <math.h>
+#endif
+
+
+/**
+ * @class GeometryGenerator GeometryGenerator.h "src/GeometryGenerator.h"
+ * @brief Builds synthetic Geometries of nested lattices of pin cells for
+ *        stress and scale testing.
+ * @details The innermost Lattices are num_x by num_y lattices of pin cells,
+ *          and each of the (nesting depth - 1) outer levels is a num_x by
+ *          num_y Lattice of the level below. Each pin cell is a circle of
+ *          fuel divided into equal volume rings and sectors, surrounded by
+ *          moderator divided into the same sectors. A fraction of the pins
+ *          are moderator holes (e.g., guide tubes) with the same subdivision,
+ *          and each fuel pin is filled with one of several fuel Materials.
+ *          The positions of the moderator holes and the fuel Material of
+ *          each pin are chosen with a seeded pseudo-random sequence, so that
+ *          a Geometry is reproducible on any machine.
+ *
+ *          Since each pin has the same subdivision, the number of FSRs is
+ *          known before the Geometry is built. The number of segments may be
+ *          estimated from the total length of the FSR boundaries, which
+ *          helps to size a problem before ray tracing it.
+ *
+ *          The Materials, Surfaces, Cells and Universes which are created
+ *          are not deleted by the GeometryGenerator, as for the objects of
+ *          a Geometry built from Python.
+ */
+class GeometryGenerator {
+
+private:
+
+  /** The number of Lattice cells along x at each level */
+  int _num_x;
+
+  /** The number of Lattice cells along y at each level */
+  int _num_y;
+
+  /** The number of levels of Lattices */
+  int _nesting_depth;
+
+  /** The number of equal volume rings in the fuel */
+  int _num_rings;
+
+  /** The number of sectors in the fuel and moderator */
+  int _num_sectors;
+
+  /** The pin cell pitch (cm) */
+  double _pitch;
+
+  /** The radius of the fuel (cm) */
+  double _fuel_radius;
+
+  /** The number of fuel Materials */
+  int _num_fuel_materials;
+
+  /** The fraction of the pins which are moderator holes */
+  double _moderator_fraction;
+
+  /** The number of energy groups */
+  int _num_groups;
+
+  /** The boundary condition on each side of the Geometry */
+  boundaryType _boundary_type;
+
+  /** The seed of the pseudo-random placement of pins and Materials */
+  unsigned int _seed;
+
+  /** The fuel Materials followed by the moderator of the last Geometry */
+  std::vector<Material*> _materials;
+
+  double random(unsigned int& state);
+  void createMaterials();
+  Universe* createPin(Material* material, bool fuel);
+
+public:
+  GeometryGenerator(int num_x, int num_y, int nesting_depth=1);
+  virtual ~GeometryGenerator();
+
+  /* Set parameters */
+  void setNumRings(int num_rings);
+  void setNumSectors(int num_sectors);
+  void setPitch(double pitch);
+  void setFuelRadius(double fuel_radius);
+  void setNumFuelMaterials(int num_fuel_materials);
+  void setModeratorFraction(double moderator_fraction);
+  void setNumEnergyGroups(int num_groups);
+  void setBoundaryType(boundaryType boundary_type);
+  void setSeed(unsigned int seed);
+
+  /* Get parameters */
+  int getNumPinsX();
+  int getNumPinsY();
+  double getWidth();
+  double getHeight();
+  int getNumFSRsPerPin();
+  long getNumFSRs();
+  double getBoundaryLength();
+  long estimateNumSegments(int num_azim, double spacing);
+  Material* getMaterial(int index);
+
+  /* Worker functions */
+  Geometry* generateGeometry();
+};
+
+
+#endif /* GEOMETRYGENERATOR_H_ */
@@ -0,0 +1,1061 @@
+#include "InputDeck.h"
+
+
+/**
+ * @brief Splits a line of an input deck into tokens.
+ * @details Tokens are separated by whitespace, may be quoted with double
+ *          quotes to include whitespace, and end at a "#" comment.
+ * @param line the line to split
+ * @param tokens the vector to append the tokens to
+ * @return whether all of the quotes in the line were closed
+ */
+static bool tokenize(const std::string& line,
+                     std::vector<std::string>& tokens) {
+
+  size_t i = 0;
+
+  while (i < line.size()) {
+
+    if (isspace(line[i])) {
+      i++;
+      continue;
+    }
+
+    if (line[i] == '#')
+      break;
+
+    if (line[i] == '"') {
+      size_t end = line.find('"', i+1);
+      if (end == std::string::npos)
+        return false;
+      tokens.push_back(line.substr(i+1, end-i-1));
+      i = end + 1;
+      continue;
+    }
+
+    size_t start = i;
+    while (i < line.size() && !isspace(line[i]) && line[i] != '#' &&
+           line[i] != '"')
+      i++;
+    tokens.push_back(line.substr(start, i-start));
+  }
+
+  return true;
+}
+
+
+/**
+ * @brief Constructor reads an input deck and builds its Geometry.
+ * @details The statements of the deck are read first, so that objects may
+ *          be referred to before they are declared. The Materials, Surfaces
+ *          and settings are then built, followed by the Cells, the
+ *          Universes and Lattices, the CMFD mesh and the Geometry. The FSRs
+ *          of the Geometry are initialized, so that it is ready to be ray
+ *          traced.
+ * @param filename the name of the input deck file
+ */
+InputDeck::InputDeck(const char* filename) {
+
+  _filename = std::string(filename);
+  _geometry = NULL;
+  _cmfd = NULL;
+  _polar_quad = NULL;
+  _num_azim = 4;
+  _spacing = 0.1;
+  _num_threads = omp_get_num_procs();
+  _tolerance = 1.E-5;
+  _max_iters = 1000;
+  _exp_interpolation = true;
+
+  log_printf(NORMAL, "Reading the input deck %s...", filename);
+
+  readFile(_filename, 0);
+
+  /* Declare the Universes and Lattices so that Cells may be filled by them
+   * before their own Cells are built */
+  for (size_t i=0; i < _statements.size(); i++) {
+    deckStatement& statement = _statements[i];
+    const std::string& keyword = statement._tokens[0];
+
+    if (keyword == "material")
+      buildMaterial(statement);
+    else if (keyword == "surface")
+      buildSurface(statement);
+    else if (keyword == "universe" || keyword == "lattice") {
+      if (statement._tokens.size() < 2)
+        log_printf(ERROR, "%s:%d: A %s requires a name",
+                   statement._filename.c_str(), statement._line,
+                   keyword.c_str());
+
+      const std::string& name = statement._tokens[1];
+      if (_universes.find(name) != _universes.end())
+        log_printf(ERROR, "%s:%d: Universe or Lattice \"%s\" is already "
+                   "declared", statement._filename.c_str(), statement._line,
+                   name.c_str());
+
+      if (keyword == "universe")
+        _universes[name] = new Universe(0, name.c_str());
+      else
+        _universes[name] = new Lattice(0, name.c_str());
+    }
+    else if (keyword != "cell" && keyword != "cmfd" && keyword != "geometry")
+      readSettings(statement);
+  }
+
+  for (size_t i=0; i < _statements.size(); i++) {
+    if (_statements[i]._tokens[0] == "cell")
+      buildCell(_statements[i]);
+  }
+
+  for (size_t i=0; i < _statements.size(); i++) {
+    if (_statements[i]._tokens[0] == "universe")
+      buildUniverse(_statements[i]);
+    else if (_statements[i]._tokens[0] == "lattice")
+      buildLattice(_statements[i]);
+  }
+
+  for (size_t i=0; i < _statements.size(); i++) {
+    if (_statements[i]._tokens[0] == "cmfd")
+      buildCmfd(_statements[i]);
+  }
+
+  buildGeometry();
+
+  log_printf(NORMAL, "Read %d Materials, %d Surfaces, %d Cells and %d "
+             "Universes and Lattices from %s", int(_materials.size()),
+             int(_surfaces.size()), int(_cells.size()),
+             int(_universes.size()), filename);
+}
+
+
+/**
+ * @brief Destructor deletes the polar quadrature.
+ * @details The Geometry and the objects within it are not deleted since
+ *          they may be in use by a TrackGenerator and Solver.
+ */
+InputDeck::~InputDeck() {
+  if (_polar_quad != NULL)
+    delete _polar_quad;
+}
+
+
+/**
+ * @brief Reads the statements of an input deck file.
+ * @details Included files are read in place of their include statements.
+ *          The lines of the blocks of material and lattice statements are
+ *          stored with the statement up to the closing "end".
+ * @param filename the name of the file
+ * @param depth the depth of nested include statements
+ */
+void InputDeck::readFile(std::string filename, int depth) {
+
+  if (depth > MAX_INPUT_DECK_DEPTH)
+    log_printf(ERROR, "Unable to read the input deck %s which is included "
+               "more than %d deep", filename.c_str(), MAX_INPUT_DECK_DEPTH);
+
+  std::ifstream file(filename.c_str());
+  if (!file.is_open())
+    log_printf(ERROR, "Unable to open the input deck %s", filename.c_str());
+
+  std::string line;
+  int line_number = 0;
+  deckStatement* block = NULL;
+
+  while (std::getline(file, line)) {
+
+    line_number++;
+    int first_line = line_number;
+
+    /* Join continued lines */
+    std::string next;
+    while (!line.empty() && line[line.size()-1] == '\\' &&
+           std::getline(file, next)) {
+      line_number++;
+      line = line.substr(0, line.size()-1) + " " + next;
+    }
+
+    std::vector<std::string> tokens;
+    if (!tokenize(line, tokens))
+      log_printf(ERROR, "%s:%d: Unclosed quote", filename.c_str(),
+                 first_line);
+
+    if (tokens.empty())
+      continue;
+
+    /* Lines within the block of a statement */
+    if (block != NULL) {
+      if (tokens[0] == "end")
+        block = NULL;
+      else {
+        block->_block.push_back(tokens);
+        block->_block_lines.push_back(first_line);
+      }
+      continue;
+    }
+
+    if (tokens[0] == "include") {
+      if (tokens.size() != 2)
+        log_printf(ERROR, "%s:%d: An include requires one file name",
+                   filename.c_str(), first_line);
+
+      /* Paths are relative to the directory of the including file */
+      std::string include = tokens[1];
+      size_t slash = filename.rfind('/');
+      if (include[0] != '/' && slash != std::string::npos)
+        include = filename.substr(0, slash+1) + include;
+
+      readFile(include, depth+1);
+      continue;
+    }
+
+    deckStatement statement;
+    statement._tokens = tokens;
+    statement._filename = filename;
+    statement._line = first_line;
+    _statements.push_back(statement);
+
+    if (tokens[0] == "material" || tokens[0] == "lattice")
+      block = &_statements.back();
+  }
+
+  if (block != NULL)
+    log_printf(ERROR, "%s:%d: The %s is missing its \"end\"",
+               filename.c_str(), block->_line, block->_tokens[0].c_str());
+}
+
+
+/**
+ * @brief Converts a token of a statement to an integer.
+ * @param statement the statement
+ * @param token the token to convert
+ * @return the integer
+ */
+int InputDeck::toInt(deckStatement& statement, const std::string& token) {
+
+  char* end;
+  long value = strtol(token.c_str(), &end, 10);
+
+  if (token.empty() || *end != '\0')
+    log_printf(ERROR, "%s:%d: Unable to read \"%s\" as an integer",
+               statement._filename.c_str(), statement._line, token.c_str());
+
+  return int(value);
+}
+
+
+/**
+ * @brief Converts a token of a statement to a floating point number.
+ * @param statement the statement
+ * @param token the token to convert
+ * @return the floating point number
+ */
+double InputDeck::toDouble(deckStatement& statement,
+                           const std::string& token) {
+
+  char* end;
+  double value = strtod(token.c_str(), &end);
+
+  if (token.empty() || *end != '\0')
+    log_printf(ERROR, "%s:%d: Unable to read \"%s\" as a number",
+               statement._filename.c_str(), statement._line, token.c_str());
+
+  return value;
+}
+
+
+/**
+ * @brief Converts an "on" or "off" token of a statement to a boolean.
+ * @param statement the statement
+ * @param token the token to convert
+ * @return whether the token is "on"
+ */
+bool InputDeck::toBool(deckStatement& statement, const std::string& token) {
+
+  if (token != "on" && token != "off")
+    log_printf(ERROR, "%s:%d: Unable to read \"%s\" as on or off",
+               statement._filename.c_str(), statement._line, token.c_str());
+
+  return token == "on";
+}
+
+
+/**
+ * @brief Returns the value of an option of a statement.
+ * @param statement the statement
+ * @param index the index of the option's name, which is advanced to the
+ *        index of its value
+ * @return the value of the option
+ */
+const std::string& InputDeck::getValue(deckStatement& statement,
+                                       size_t& index) {
+
+  if (++index >= statement._tokens.size())
+    log_printf(ERROR, "%s:%d: The %s option requires a value",
+               statement._filename.c_str(), statement._line,
+               statement._tokens[index-1].c_str());
+
+  return statement._tokens[index];
+}
+
+
+/**
+ * @brief Finds a Material by name.
+ * @param statement the statement referring to the Material
+ * @param name the name of the Material
+ * @return a pointer to the Material
+ */
+Material* InputDeck::findMaterial(deckStatement& statement,
+                                  const std::string& name) {
+
+  std::map<std::string, Material*>::iterator iter = _materials.find(name);
+
+  if (iter == _materials.end())
+    log_printf(ERROR, "%s:%d: Material \"%s\" is not declared",
+               statement._filename.c_str(), statement._line, name.c_str());
+
+  return iter->second;
+}
+
+
+/**
+ * @brief Finds a Universe or Lattice by name.
+ * @param statement the statement referring to the Universe
+ * @param name the name of the Universe or Lattice
+ * @return a pointer to the Universe
+ */
+Universe* InputDeck::findUniverse(deckStatement& statement,
+                                  const std::string& name) {
+
+  std::map<std::string, Universe*>::iterator iter = _universes.find(name);
+
+  if (iter == _universes.end())
+    log_printf(ERROR, "%s:%d: Universe or Lattice \"%s\" is not declared",
+               statement._filename.c_str(), statement._line, name.c_str());
+
+  return iter->second;
+}
+
+
+/**
+ * @brief Builds a Material from a material statement.
+ * @details The block of the statement has a line for each cross-section,
+ *          named as in the materialize module: sigma-t, sigma-a, sigma-s,
+ *          sigma-f, nu-sigma-f, chi, dif-coef and buckling. The values of a
+ *          cross-section may be continued on the following lines. The
+ *          number of energy groups is the number of sigma-t values, and the
+ *          scattering matrix is indexed by origin and then destination group
+ *          as in Material::setSigmaS(...).
+ * @param statement the material statement
+ */
+void InputDeck::buildMaterial(deckStatement& statement) {
+
+  if (statement._tokens.size() != 2)
+    log_printf(ERROR, "%s:%d: A material requires a name",
+               statement._filename.c_str(), statement._line);
+
+  const std::string& name = statement._tokens[1];
+  if (_materials.find(name) != _materials.end())
+    log_printf(ERROR, "%s:%d: Material \"%s\" is already declared",
+               statement._filename.c_str(), statement._line, name.c_str());
+
+  std::map<std::string, std::vector<double> > xs;
+  std::string quantity;
+
+  for (size_t i=0; i < statement._block.size(); i++) {
+    std::vector<std::string>& tokens = statement._block[i];
+    size_t first = 0;
+
+    /* Lines which start with a number continue the last cross-section */
+    char* end;
+    strtod(tokens[0].c_str(), &end);
+    if (*end != '\0' || quantity.empty()) {
+      quantity = tokens[0];
+      first = 1;
+
+      if (quantity != "sigma-t" && quantity != "sigma-a" &&
+          quantity != "sigma-s" && quantity != "sigma-f" &&
+          quantity != "nu-sigma-f" && quantity != "chi" &&
+          quantity != "dif-coef" && quantity != "buckling")
+        log_printf(ERROR, "%s:%d: Unknown cross-section %s for Material "
+                   "\"%s\"", statement._filename.c_str(),
+                   statement._block_lines[i], quantity.c_str(), name.c_str());
+    }
+
+    for (size_t j=first; j < tokens.size(); j++)
+      xs[quantity].push_back(toDouble(statement, tokens[j]));
+  }
+
+  if (xs["sigma-t"].empty())
+    log_printf(ERROR, "%s:%d: Material \"%s\" requires sigma-t",
+               statement._filename.c_str(), statement._line, name.c_str());
+
+  Material* material = new Material(0, name.c_str());
+  material->setNumEnergyGroups(xs["sigma-t"].size());
+
+  std::map<std::string, std::vector<double> >::iterator iter;
+  for (iter = xs.begin(); iter != xs.end(); ++iter) {
+    std::vector<double>& values = iter->second;
+    if (values.empty())
+      continue;
+
+    if (iter->first == "sigma-t")
+      material->setSigmaT(&values[0], values.size());
+    else if (iter->first == "sigma-a")
+      material->setSigmaA(&values[0], values.size());
+    else if (iter->first == "sigma-s")
+      material->setSigmaS(&values[0], values.size());
+    else if (iter->first == "sigma-f")
+      material->setSigmaF(&values[0], values.size());
+    else if (iter->first == "nu-sigma-f")
+      material->setNuSigmaF(&values[0], values.size());
+    else if (iter->first == "chi")
+      material->setChi(&values[0], values.size());
+    else if (iter->first == "dif-coef")
+      material->setDifCoef(&values[0], values.size());
+    else if (iter->first == "buckling")
+      material->setBuckling(&values[0], values.size());
+  }
+
+  if (!xs["sigma-a"].empty() && !xs["sigma-s"].empty())
+    material->checkSigmaT();
+
+  _materials[name] = material;
+}
+
+
+/**
+ * @brief Builds a Surface from a surface statement.
+ * @details The statement gives the name and type of the Surface followed by
+ *          its coefficients, and optionally its boundary condition:
+ *
+ *          - surface NAME x-plane X
+ *          - surface NAME y-plane Y
+ *          - surface NAME z-plane Z
+ *          - surface NAME plane A B C
+ *          - surface NAME circle X Y RADIUS
+ *
+ *          followed by "boundary reflective" or "boundary vacuum".
+ * @param statement the surface statement
+ */
+void InputDeck::buildSurface(deckStatement& statement) {
+
+  std::vector<std::string>& tokens = statement._tokens;
+
+  if (tokens.size() < 3)
+    log_printf(ERROR, "%s:%d: A surface requires a name and a type",
+               statement._filename.c_str(), statement._line);
+
+  const std::string& name = tokens[1];
+  const std::string& type = tokens[2];
+
+  if (_surfaces.find(name) != _surfaces.end())
+    log_printf(ERROR, "%s:%d: Surface \"%s\" is already declared",
+               statement._filename.c_str(), statement._line, name.c_str());
+
+  int num_coeffs = 0;
+  if (type == "x-plane" || type == "y-plane" || type == "z-plane")
+    num_coeffs = 1;
+  else if (type == "plane" || type == "circle")
+    num_coeffs = 3;
+  else
+    log_printf(ERROR, "%s:%d: Unknown type %s for Surface \"%s\"",
+               statement._filename.c_str(), statement._line, type.c_str(),
+               name.c_str());
+
+  if (tokens.size() < size_t(3 + num_coeffs))
+    log_printf(ERROR, "%s:%d: A %s requires %d coefficients",
+               statement._filename.c_str(), statement._line, type.c_str(),
+               num_coeffs);
+
+  double coeffs[3];
+  for (int i=0; i < num_coeffs; i++)
+    coeffs[i] = toDouble(statement, tokens[3+i]);
+
+  Surface* surface;
+  if (type == "x-plane")
+    surface = new XPlane(coeffs[0], 0, name.c_str());
+  else if (type == "y-plane")
+    surface = new YPlane(coeffs[0], 0, name.c_str());
+  else if (type == "z-plane")
+    surface = new ZPlane(coeffs[0], 0, name.c_str());
+  else if (type == "plane")
+    surface = new Plane(coeffs[0], coeffs[1], coeffs[2], 0, name.c_str());
+  else
+    surface = new Circle(coeffs[0], coeffs[1], coeffs[2], 0, name.c_str());
+
+  for (size_t i=3+num_coeffs; i < tokens.size(); i++) {
+    if (tokens[i] == "boundary") {
+      const std::string& boundary = getValue(statement, i);
+      if (boundary == "reflective")
+        surface->setBoundaryType(REFLECTIVE);
+      else if (boundary == "vacuum")
+        surface->setBoundaryType(VACUUM);
+      else
+        log_printf(ERROR, "%s:%d: Unknown boundary type %s",
+                   statement._filename.c_str(), statement._line,
+                   boundary.c_str());
+    }
+    else
+      log_printf(ERROR, "%s:%d: Unknown surface option %s",
+                 statement._filename.c_str(), statement._line,
+                 tokens[i].c_str());
+  }
+
+  _surfaces[name] = surface;
+}
+
+
+/**
+ * @brief Builds a Cell from a cell statement.
+ * @details The statement gives the name of the Cell and its options:
+ *
+ *          - material NAME: fill the Cell with a Material
+ *          - fill NAME: fill the Cell with a Universe or Lattice
+ *          - rings N: divide the Cell into N equal volume rings
+ *          - sectors N: divide the Cell into N equal angle sectors
+ *          - surfaces +NAME -NAME ...: bound the Cell by the positive or
+ *            negative halfspaces of Surfaces
+ * @param statement the cell statement
+ */
+void InputDeck::buildCell(deckStatement& statement) {
+
+  std::vector<std::string>& tokens = statement._tokens;
+
+  if (tokens.size() < 2)
+    log_printf(ERROR, "%s:%d: A cell requires a name",
+               statement._filename.c_str(), statement._line);
+
+  const std::string& name = tokens[1];
+  if (_cells.find(name) != _cells.end())
+    log_printf(ERROR, "%s:%d: Cell \"%s\" is already declared",
+               statement._filename.c_str(), statement._line, name.c_str());
+
+  Cell* cell = new Cell(0, name.c_str());
+  bool filled = false;
+
+  for (size_t i=2; i < tokens.size(); i++) {
+
+    if (tokens[i] == "material" || tokens[i] == "fill") {
+      if (filled)
+        log_printf(ERROR, "%s:%d: Cell \"%s\" has more than one fill",
+                   statement._filename.c_str(), statement._line,
+                   name.c_str());
+
+      if (tokens[i] == "material")
+        cell->setFill(findMaterial(statement, getValue(statement, i)));
+      else
+        cell->setFill(findUniverse(statement, getValue(statement, i)));
+      filled = true;
+    }
+    else if (tokens[i] == "rings")
+      cell->setNumRings(toInt(statement, getValue(statement, i)));
+    else if (tokens[i] == "sectors")
+      cell->setNumSectors(toInt(statement, getValue(statement, i)));
+    else if (tokens[i] == "surfaces") {
+
+      /* The Surfaces continue to the next option */
+      while (i+1 < tokens.size() &&
+             (tokens[i+1][0] == '+' || tokens[i+1][0] == '-')) {
+        const std::string& token = tokens[++i];
+        std::string surface_name = token.substr(1);
+        std::map<std::string, Surface*>::iterator iter =
+          _surfaces.find(surface_name);
+
+        if (iter == _surfaces.end())
+          log_printf(ERROR, "%s:%d: Surface \"%s\" is not declared",
+                     statement._filename.c_str(), statement._line,
+                     surface_name.c_str());
+
+        cell->addSurface((token[0] == '+') ? +1 : -1, iter->second);
+      }
+    }
+    else
+      log_printf(ERROR, "%s:%d: Unknown cell option %s",
+                 statement._filename.c_str(), statement._line,
+                 tokens[i].c_str());
+  }
+
+  if (!filled)
+    log_printf(ERROR, "%s:%d: Cell \"%s\" requires a material or fill",
+               statement._filename.c_str(), statement._line, name.c_str());
+
+  _cells[name] = cell;
+}
+
+
+/**
+ * @brief Adds the Cells of a universe statement to its Universe.
+ * @details The statement is "universe NAME cells CELL ...". A Cell may be
+ *          in more than one Universe.
+ * @param statement the universe statement
+ */
+void InputDeck::buildUniverse(deckStatement& statement) {
+
+  std::vector<std::string>& tokens = statement._tokens;
+  Universe* universe = _universes[tokens[1]];
+
+  if (tokens.size() < 4 || tokens[2] != "cells")
+    log_printf(ERROR, "%s:%d: Universe \"%s\" requires a list of cells",
+               statement._filename.c_str(), statement._line,
+               tokens[1].c_str());
+
+  for (size_t i=3; i < tokens.size(); i++) {
+    std::map<std::string, Cell*>::iterator iter = _cells.find(tokens[i]);
+
+    if (iter == _cells.end())
+      log_printf(ERROR, "%s:%d: Cell \"%s\" is not declared",
+                 statement._filename.c_str(), statement._line,
+                 tokens[i].c_str());
+
+    universe->addCell(iter->second);
+  }
+}
+
+
+/**
+ * @brief Fills the Lattice of a lattice statement.
+ * @details The statement is "lattice NAME width WIDTH_X WIDTH_Y", with an
+ *          optional "offset X Y". Its block has a line of Universe names for
+ *          each row of the Lattice from the top down. A name may be
+ *          repeated N times along a row with "NAME*N".
+ * @param statement the lattice statement
+ */
+void InputDeck::buildLattice(deckStatement& statement) {
+
+  std::vector<std::string>& tokens = statement._tokens;
+  const std::string& name = tokens[1];
+  Lattice* lattice = static_cast<Lattice*>(_universes[name]);
+  bool width = false;
+
+  for (size_t i=2; i < tokens.size(); i++) {
+    if (tokens[i] == "width" || tokens[i] == "offset") {
+      bool is_width = (tokens[i] == "width");
+      double x = toDouble(statement, getValue(statement, i));
+      double y = toDouble(statement, getValue(statement, i));
+
+      if (is_width) {
+        lattice->setWidth(x, y);
+        width = true;
+      }
+      else
+        lattice->setOffset(x, y);
+    }
+    else
+      log_printf(ERROR, "%s:%d: Unknown lattice option %s",
+                 statement._filename.c_str(), statement._line,
+                 tokens[i].c_str());
+  }
+
+  if (!width)
+    log_printf(ERROR, "%s:%d: Lattice \"%s\" requires a width",
+               statement._filename.c_str(), statement._line, name.c_str());
+
+  std::vector<Universe*> universes;
+  int num_x = 0;
+  int num_y = statement._block.size();
+
+  for (int j=0; j < num_y; j++) {
+    std::vector<std::string>& row = statement._block[j];
+    int row_length = 0;
+
+    for (size_t i=0; i < row.size(); i++) {
+      std::string universe_name = row[i];
+      int repeat = 1;
+
+      size_t star = universe_name.rfind('*');
+      if (star != std::string::npos) {
+        repeat = toInt(statement, universe_name.substr(star+1));
+        universe_name = universe_name.substr(0, star);
+      }
+
+      Universe* universe = findUniverse(statement, universe_name);
+      for (int r=0; r < repeat; r++)
+        universes.push_back(universe);
+      row_length += repeat;
+    }
+
+    if (j == 0)
+      num_x = row_length;
+    else if (row_length != num_x)
+      log_printf(ERROR, "%s:%d: Row %d of Lattice \"%s\" has %d Universes "
+                 "rather than %d", statement._filename.c_str(),
+                 statement._block_lines[j], j+1, name.c_str(), row_length,
+                 num_x);
+  }
+
+  if (num_x == 0)
+    log_printf(ERROR, "%s:%d: Lattice \"%s\" requires at least one row",
+               statement._filename.c_str(), statement._line, name.c_str());
+
+  lattice->setUniverses(num_y, num_x, &universes[0]);
+}
+
+
+/**
+ * @brief Builds the CMFD mesh from a cmfd statement.
+ * @details The statement has the options:
+ *
+ *          - lattice NUM_X NUM_Y: the number of CMFD cells (required)
+ *          - groups G1 G2 ...: the first MOC group of each CMFD group
+ *          - moc-relaxation FACTOR: the MOC flux relaxation factor
+ *          - sor-relaxation FACTOR: the SOR relaxation factor
+ *          - flux-update on|off: whether to update the MOC flux
+ *          - optically-thick on|off: whether to use the optically thick
+ *            diffusion correction
+ * @param statement the cmfd statement
+ */
+void InputDeck::buildCmfd(deckStatement& statement) {
+
+  if (_cmfd != NULL)
+    log_printf(ERROR, "%s:%d: The CMFD mesh is already declared",
+               statement._filename.c_str(), statement._line);
+
+  std::vector<std::string>& tokens = statement._tokens;
+  _cmfd = new Cmfd();
+  bool lattice = false;
+
+  for (size_t i=1; i < tokens.size(); i++) {
+
+    if (tokens[i] == "lattice") {
+      int num_x = toInt(statement, getValue(statement, i));
+      int num_y = toInt(statement, getValue(statement, i));
+      _cmfd->setLatticeStructure(num_x, num_y);
+      lattice = true;
+    }
+    else if (tokens[i] == "groups") {
+      std::vector<int> groups;
+      while (i+1 < tokens.size() && isdigit(tokens[i+1][0]))
+        groups.push_back(toInt(statement, tokens[++i]));
+
+      if (groups.empty())
+        log_printf(ERROR, "%s:%d: The groups option requires a value",
+                   statement._filename.c_str(), statement._line);
+
+      _cmfd->setGroupStructure(&groups[0], groups.size());
+    }
+    else if (tokens[i] == "moc-relaxation")
+      _cmfd->setMOCRelaxationFactor(toDouble(statement,
+                                             getValue(statement, i)));
+    else if (tokens[i] == "sor-relaxation")
+      _cmfd->setSORRelaxationFactor(toDouble(statement,
+                                             getValue(statement, i)));
+    else if (tokens[i] == "flux-update")
+      _cmfd->setFluxUpdateOn(toBool(statement, getValue(statement, i)));
+    else if (tokens[i] == "optically-thick")
+      _cmfd->setOpticallyThick(toBool(statement, getValue(statement, i)));
+    else
+      log_printf(ERROR, "%s:%d: Unknown cmfd option %s",
+                 statement._filename.c_str(), statement._line,
+                 tokens[i].c_str());
+  }
+
+  if (!lattice)
+    log_printf(ERROR, "%s:%d: The CMFD mesh requires a lattice",
+               statement._filename.c_str(), statement._line);
+}
+
+
+/**
+ * @brief Reads the calculation settings from a statement.
+ * @details The settings statements are:
+ *
+ *          - log-level LEVEL
+ *          - tracks num-azim N spacing SPACING
+ *          - polar-quadrature TYPE N, where the type is tabuchi-yamamoto,
+ *            leonard, gauss-legendre, equal-weight or equal-angle
+ *          - solver tolerance T max-iters N threads N
+ *            exponential interpolation|intrinsic
+ *          - memory-budget MB, the budget for the MemoryTracker
+ *          - output FILE
+ * @param statement the statement
+ */
+void InputDeck::readSettings(deckStatement& statement) {
+
+  std::vector<std::string>& tokens = statement._tokens;
+  const std::string& keyword = tokens[0];
+
+  if (keyword == "log-level") {
+    if (tokens.size() != 2)
+      log_printf(ERROR, "%s:%d: The log-level requires one level",
+                 statement._filename.c_str(), statement._line);
+    set_log_level(tokens[1].c_str());
+  }
+
+  else if (keyword == "tracks") {
+    for (size_t i=1; i < tokens.size(); i++) {
+      if (tokens[i] == "num-azim")
+        _num_azim = toInt(statement, getValue(statement, i));
+      else if (tokens[i] == "spacing")
+        _spacing = toDouble(statement, getValue(statement, i));
+      else
+        log_printf(ERROR, "%s:%d: Unknown tracks option %s",
+                   statement._filename.c_str(), statement._line,
+                   tokens[i].c_str());
+    }
+  }
+
+  else if (keyword == "polar-quadrature") {
+    if (tokens.size() != 3)
+      log_printf(ERROR, "%s:%d: The polar-quadrature requires a type and a "
+                 "number of polar angles", statement._filename.c_str(),
+                 statement._line);
+
+    if (_polar_quad != NULL)
+      delete _polar_quad;
+
+    if (tokens[1] == "tabuchi-yamamoto")
+      _polar_quad = new TYPolarQuad();
+    else if (tokens[1] == "leonard")
+      _polar_quad = new LeonardPolarQuad();
+    else if (tokens[1] == "gauss-legendre")
+      _polar_quad = new GLPolarQuad();
+    else if (tokens[1] == "equal-weight")
+      _polar_quad = new EqualWeightPolarQuad();
+    else if (tokens[1] == "equal-angle")
+      _polar_quad = new EqualAnglePolarQuad();
+    else
+      log_printf(ERROR, "%s:%d: Unknown polar quadrature %s",
+                 statement._filename.c_str(), statement._line,
+                 tokens[1].c_str());
+
+    _polar_quad->setNumPolarAngles(toInt(statement, tokens[2]));
+  }
+
+  else if (keyword == "solver") {
+    for (size_t i=1; i < tokens.size(); i++) {
+      if (tokens[i] == "tolerance")
+        _tolerance = toDouble(statement, getValue(statement, i));
+      else if (tokens[i] == "max-iters")
+        _max_iters = toInt(statement, getValue(statement, i));
+      else if (tokens[i] == "threads")
+        _num_threads = toInt(statement, getValue(statement, i));
+      else if (tokens[i] == "exponential") {
+        const std::string& method = getValue(statement, i);
+        if (method != "interpolation" && method != "intrinsic")
+          log_printf(ERROR, "%s:%d: Unknown exponential method %s",
+                     statement._filename.c_str(), statement._line,
+                     method.c_str());
+        _exp_interpolation = (method == "interpolation");
+      }
+      else
+        log_printf(ERROR, "%s:%d: Unknown solver option %s",
+                   statement._filename.c_str(), statement._line,
+                   tokens[i].c_str());
+    }
+  }
+
+  else if (keyword == "memory-budget") {
+    if (tokens.size() != 2)
+      log_printf(ERROR, "%s:%d: The memory-budget requires one size in MB",
+                 statement._filename.c_str(), statement._line);
+
+    double budget = toDouble(statement, tokens[1]);
+    if (budget < 0.)
+      log_printf(ERROR, "%s:%d: The memory-budget must not be negative",
+                 statement._filename.c_str(), statement._line);
+    MemoryTracker::Get()->setBudget(size_t(budget * 1.E6));
+  }
+
+  else if (keyword == "output") {
+    if (tokens.size() != 2)
+      log_printf(ERROR, "%s:%d: The output requires one file name",
+                 statement._filename.c_str(), statement._line);
+    _output_filename = tokens[1];
+  }
+
+  else
+    log_printf(ERROR, "%s:%d: Unknown statement %s",
+               statement._filename.c_str(), statement._line,
+               keyword.c_str());
+}
+
+
+/**
+ * @brief Builds the Geometry from the geometry statement.
+ * @details The statement is "geometry ROOT" for the name of the root
+ *          Universe. The CMFD mesh is added to the Geometry, if any, and
+ *          its FSRs are initialized.
+ */
+void InputDeck::buildGeometry() {
+
+  deckStatement* root = NULL;
+
+  for (size_t i=0; i < _statements.size(); i++) {
+    if (_statements[i]._tokens[0] != "geometry")
+      continue;
+
+    if (root != NULL)
+      log_printf(ERROR, "%s:%d: The geometry is already declared",
+                 _statements[i]._filename.c_str(), _statements[i]._line);
+
+    if (_statements[i]._tokens.size() != 2)
+      log_printf(ERROR, "%s:%d: The geometry requires one root universe",
+                 _statements[i]._filename.c_str(), _statements[i]._line);
+
+    root = &_statements[i];
+  }
+
+  if (root == NULL)
+    log_printf(ERROR, "The input deck %s has no geometry statement",
+               _filename.c_str());
+
+  _geometry = new Geometry();
+  _geometry->setRootUniverse(findUniverse(*root, root->_tokens[1]));
+
+  if (_cmfd != NULL)
+    _geometry->setCmfd(_cmfd);
+
+  _geometry->initializeFlatSourceRegions();
+}
+
+
+/**
+ * @brief Returns the Geometry.
+ * @return a pointer to the Geometry
+ */
+Geometry* InputDeck::getGeometry() {
+  return _geometry;
+}
+
+
+/**
+ * @brief Returns the CMFD mesh.
+ * @return a pointer to the Cmfd (NULL if none)
+ */
+Cmfd* InputDeck::getCmfd() {
+  return _cmfd;
+}
+
+
+/**
+ * @brief Returns the polar quadrature.
+ * @return a pointer to the PolarQuad (NULL for the Solver's default)
+ */
+PolarQuad* InputDeck::getPolarQuadrature() {
+  return _polar_quad;
+}
+
+
+/**
+ * @brief Returns a Material by name.
+ * @param name the name of the Material
+ * @return a pointer to the Material
+ */
+Material* InputDeck::getMaterial(const char* name) {
+
+  if (_materials.find(name) == _materials.end())
+    log_printf(ERROR, "Unable to get Material \"%s\" which is not in the "
+               "input deck %s", name, _filename.c_str());
+
+  return _materials[name];
+}
+
+
+/**
+ * @brief Returns a Surface by name.
+ * @param name the name of the Surface
+ * @return a pointer to the Surface
+ */
+Surface* InputDeck::getSurface(const char* name) {
+
+  if (_surfaces.find(name) == _surfaces.end())
+    log_printf(ERROR, "Unable to get Surface \"%s\" which is not in the "
+               "input deck %s", name, _filename.c_str());
+
+  return _surfaces[name];
+}
+
+
+/**
+ * @brief Returns a Cell by name.
+ * @param name the name of the Cell
+ * @return a pointer to the Cell
+ */
+Cell* InputDeck::getCell(const char* name) {
+
+  if (_cells.find(name) == _cells.end())
+    log_printf(ERROR, "Unable to get Cell \"%s\" which is not in the "
+               "input deck %s", name, _filename.c_str());
+
+  return _cells[name];
+}
+
+
+/**
+ * @brief Returns a Universe or Lattice by name.
+ * @param name the name of the Universe or Lattice
+ * @return a pointer to the Universe
+ */
+Universe* InputDeck::getUniverse(const char* name) {
+
+  if (_universes.find(name) == _universes.end())
+    log_printf(ERROR, "Unable to get Universe \"%s\" which is not in the "
+               "input deck %s", name, _filename.c_str());
+
+  return _universes[name];
+}
+
+
+/**
+ * @brief Returns the number of azimuthal angles.
+ * @return the number of azimuthal angles
+ */
+int InputDeck::getNumAzim() {
+  return _num_azim;
+}
+
+
+/**
+ * @brief Returns the track spacing.
+ * @return the track spacing (cm)
+ */
+double InputDeck::getTrackSpacing() {
+  return _spacing;
+}
+
+
+/**
+ * @brief Returns the number of OpenMP threads.
+ * @details The default is the number of processors.
+ * @return the number of threads
+ */
+int InputDeck::getNumThreads() {
+  return _num_threads;
+}
+
+
+/**
+ * @brief Returns the source convergence threshold.
+ * @return the convergence threshold
+ */
+double InputDeck::getTolerance() {
+  return _tolerance;
+}
+
+
+/**
+ * @brief Returns the maximum number of source iterations.
+ * @return the maximum number of source iterations
+ */
+int InputDeck::getMaxIterations() {
+  return _max_iters;
+}
+
+
+/**
+ * @brief Returns whether to use the exponential interpolation table.
+ * @return true for the interpolation table or false for the exponential
+ *         intrinsic
+ */
+bool InputDeck::isUsingExponentialInterpolation() {
+  return _exp_interpolation;
+}
+
+
+/**
+ * @brief Returns the name of the results file.
+ * @return the name of the results file (empty if none)
+ */
+const char* InputDeck::getOutputFilename() {
+  return _output_filename.c_str();
+}
@@ -0,0 +1,198 @@
+/**
+ * @file InputDeck.h
+ * @brief The InputDeck class.
+ * @date October 18, 2026
+ */
+
+#ifndef INPUTDECK_H_
+#define INPUTDECK_H_
+
+#ifdef __cplusplus
+#include "Geometry.h"
+#include "PolarQuad.h"
+#include "MemoryTracker.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <stdlib.h>
+#include <ctype.h>
+#endif
+
+
+/**
+ * @def MAX_INPUT_DECK_DEPTH
+ * @brief The maximum depth of nested include statements in an input deck.
+ */
+#define MAX_INPUT_DECK_DEPTH 16
+
+
+#ifndef SWIG
+
+/**
+ * @struct deckStatement
+ * @brief A statement of an input deck with the lines of its block.
+ */
+struct deckStatement {
+
+  /** The tokens of the statement, starting with its keyword */
+  std::vector<std::string> _tokens;
+
+  /** The tokens of each line of the statement's block (if any) */
+  std::vector< std::vector<std::string> > _block;
+
+  /** The lines numbers of the block */
+  std::vector<int> _block_lines;
+
+  /** The file containing the statement */
+  std::string _filename;
+
+  /** The line number of the statement in its file */
+  int _line;
+};
+
+#endif
+
+
+/**
+ * @class InputDeck InputDeck.h "src/InputDeck.h"
+ * @brief Builds a Geometry and the calculation settings from a text input
+ *        deck.
+ * @details An input deck declares the Materials, Surfaces, Cells, Universes
+ *          and Lattices of a Geometry with one statement per line, along
+ *          with the CMFD mesh, Track and Solver settings. This allows a
+ *          Geometry to be built natively without any calls through the
+ *          Python interface. Objects are referred to by name, and may be
+ *          used before they are declared. Comments start with "#", names
+ *          with spaces may be quoted, and a statement may be continued on
+ *          the next line by ending it with "\". The statements are:
+ *
+ * @code
+ *          include "file.deck"
+ *          log-level NORMAL
+ *
+ *          material "UO2"
+ *            sigma-t 1.779490E-01 3.298050E-01 ...
+ *            sigma-s 1.275370E-01 4.237800E-02 ...
+ *            nu-sigma-f ...
+ *          end
+ *
+ *          surface left x-plane -32.13 boundary reflective
+ *          surface fuel circle 0.0 0.0 0.54
+ *
+ *          cell fuel material "UO2" rings 3 sectors 8 surfaces -fuel
+ *          cell moderator material Water sectors 8 surfaces +fuel
+ *          universe pin cells fuel moderator
+ *
+ *          lattice assembly width 1.26 1.26
+ *            pin*8 guide pin*8
+ *            ...
+ *          end
+ *
+ *          cell core fill assembly surfaces +left -right +bottom -top
+ *          universe root cells core
+ *          geometry root
+ *
+ *          cmfd lattice 17 17 groups 1 4 8 moc-relaxation 0.6
+ *          tracks num-azim 32 spacing 0.05
+ *          polar-quadrature tabuchi-yamamoto 3
+ *          solver tolerance 1E-5 max-iters 1000 threads 4
+ *          memory-budget 4096
+ *          output results.bin
+ * @endcode
+ *
+ *          The Materials, Surfaces, Cells and Universes which are created
+ *          are not deleted by the InputDeck, as for the objects of a
+ *          Geometry built from Python.
+ */
+class InputDeck {
+
+private:
+
+  /** The name of the input deck file */
+  std::string _filename;
+
+  /** The statements of the deck and of its included files */
+  std::vector<deckStatement> _statements;
+
+  /** The Materials by name */
+  std::map<std::string, Material*> _materials;
+
+  /** The Surfaces by name */
+  std::map<std::string, Surface*> _surfaces;
+
+  /** The Cells by name */
+  std::map<std::string, Cell*> _cells;
+
+  /** The Universes and Lattices by name */
+  std::map<std::string, Universe*> _universes;
+
+  /** The Geometry */
+  Geometry* _geometry;
+
+  /** The CMFD mesh (NULL if none) */
+  Cmfd* _cmfd;
+
+  /** The polar quadrature (NULL for the Solver's default) */
+  PolarQuad* _polar_quad;
+
+  /** The number of azimuthal angles */
+  int _num_azim;
+
+  /** The track spacing (cm) */
+  double _spacing;
+
+  /** The number of OpenMP threads */
+  int _num_threads;
+
+  /** The source convergence threshold */
+  double _tolerance;
+
+  /** The maximum number of source iterations */
+  int _max_iters;
+
+  /** Whether to use the exponential interpolation table */
+  bool _exp_interpolation;
+
+  /** The results file to write (empty if none) */
+  std::string _output_filename;
+
+  void readFile(std::string filename, int depth);
+  void buildMaterial(deckStatement& statement);
+  void buildSurface(deckStatement& statement);
+  void buildCell(deckStatement& statement);
+  void buildUniverse(deckStatement& statement);
+  void buildLattice(deckStatement& statement);
+  void buildCmfd(deckStatement& statement);
+  void readSettings(deckStatement& statement);
+  void buildGeometry();
+
+  int toInt(deckStatement& statement, const std::string& token);
+  double toDouble(deckStatement& statement, const std::string& token);
+  bool toBool(deckStatement& statement, const std::string& token);
+  const std::string& getValue(deckStatement& statement, size_t& index);
+  Material* findMaterial(deckStatement& statement, const std::string& name);
+  Universe* findUniverse(deckStatement& statement, const std::string& name);
+
+public:
+  InputDeck(const char* filename);
+  virtual ~InputDeck();
+
+  /* Get parameters */
+  Geometry* getGeometry();
+  Cmfd* getCmfd();
+  PolarQuad* getPolarQuadrature();
+  Material* getMaterial(const char* name);
+  Surface* getSurface(const char* name);
+  Cell* getCell(const char* name);
+  Universe* getUniverse(const char* name);
+  int getNumAzim();
+  double getTrackSpacing();
+  int getNumThreads();
+  double getTolerance();
+  int getMaxIterations();
+  bool isUsingExponentialInterpolation();
+  const char* getOutputFilename();
+};
+
+
+#endif /* INPUTDECK_H_ */
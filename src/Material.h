@@ -9,7 +9,6 @@
 #define MATERIAL_H_
 
 #ifdef __cplusplus
-#include "Python.h"
 #include "constants.h"
 #include "log.h"
 #include <sstream>
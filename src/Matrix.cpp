@@ -0,0 +1,425 @@
+#include "Matrix.h"
+
+
+/**
+ * @brief Constructor initializes an empty Matrix with one block of rows for
+ *        each cell.
+ * @param num_cells the number of cells
+ * @param num_groups the number of energy groups in each cell
+ */
+Matrix::Matrix(int num_cells, int num_groups) {
+
+  if (num_cells <= 0 || num_groups <= 0)
+    log_printf(ERROR, "Unable to create a Matrix with %d cells and %d "
+               "groups", num_cells, num_groups);
+
+  _num_cells = num_cells;
+  _num_groups = num_groups;
+  _num_rows = num_cells * num_groups;
+
+  _row_pointers = new int[_num_rows+1];
+  _diagonals = new int[_num_rows];
+  _columns = NULL;
+  _values = NULL;
+
+  for (int row=0; row <= _num_rows; row++)
+    _row_pointers[row] = 0;
+
+  for (int row=0; row < _num_rows; row++)
+    _diagonals[row] = -1;
+
+  _pending.resize(_num_rows);
+}
+
+
+/**
+ * @brief Destructor deletes the arrays for the nonzeros.
+ */
+Matrix::~Matrix() {
+
+  delete [] _row_pointers;
+  delete [] _diagonals;
+
+  if (_columns != NULL)
+    delete [] _columns;
+
+  if (_values != NULL)
+    delete [] _values;
+
+  _pending.clear();
+}
+
+
+/**
+ * @brief Finds the index of an entry in the nonzero arrays.
+ * @param row the row of the entry
+ * @param column the column of the entry
+ * @return the index of the entry (-1 if it is not in the sparsity pattern)
+ */
+int Matrix::findIndex(int row, int column) {
+
+  if (_columns == NULL)
+    return -1;
+
+  int* first = &_columns[0] + _row_pointers[row];
+  int* last = &_columns[0] + _row_pointers[row+1];
+  int* found = std::lower_bound(first, last, column);
+
+  if (found == last || *found != column)
+    return -1;
+
+  return found - &_columns[0];
+}
+
+
+/**
+ * @brief Adds a value to the coupling of a cell and group to a cell and
+ *        group (i.e., the entry in the row for cell_to and group_to and
+ *        the column for cell_from and group_from).
+ * @param cell_from the cell of the column
+ * @param group_from the group of the column
+ * @param cell_to the cell of the row
+ * @param group_to the group of the row
+ * @param value the value to add to the entry
+ */
+void Matrix::incrementValue(int cell_from, int group_from, int cell_to,
+                            int group_to, FP_PRECISION value) {
+
+  if (cell_from < 0 || cell_from >= _num_cells ||
+      cell_to < 0 || cell_to >= _num_cells ||
+      group_from < 0 || group_from >= _num_groups ||
+      group_to < 0 || group_to >= _num_groups)
+    log_printf(ERROR, "Unable to increment the Matrix entry from cell %d "
+               "group %d to cell %d group %d for %d cells and %d groups",
+               cell_from, group_from, cell_to, group_to, _num_cells,
+               _num_groups);
+
+  int row = cell_to * _num_groups + group_to;
+  int column = cell_from * _num_groups + group_from;
+  int index = findIndex(row, column);
+
+  if (index != -1)
+    _values[index] += value;
+  else
+    _pending[row][column] += value;
+}
+
+
+/**
+ * @brief Sets the coupling of a cell and group to a cell and group (i.e.,
+ *        the entry in the row for cell_to and group_to and the column for
+ *        cell_from and group_from).
+ * @param cell_from the cell of the column
+ * @param group_from the group of the column
+ * @param cell_to the cell of the row
+ * @param group_to the group of the row
+ * @param value the value of the entry
+ */
+void Matrix::setValue(int cell_from, int group_from, int cell_to,
+                      int group_to, FP_PRECISION value) {
+
+  if (cell_from < 0 || cell_from >= _num_cells ||
+      cell_to < 0 || cell_to >= _num_cells ||
+      group_from < 0 || group_from >= _num_groups ||
+      group_to < 0 || group_to >= _num_groups)
+    log_printf(ERROR, "Unable to set the Matrix entry from cell %d group %d "
+               "to cell %d group %d for %d cells and %d groups", cell_from,
+               group_from, cell_to, group_to, _num_cells, _num_groups);
+
+  int row = cell_to * _num_groups + group_to;
+  int column = cell_from * _num_groups + group_from;
+  int index = findIndex(row, column);
+
+  if (index != -1)
+    _values[index] = value;
+  else
+    _pending[row][column] = value;
+}
+
+
+/**
+ * @brief Adds a multiple of another Matrix to this Matrix (i.e.,
+ *        this = this + scale * matrix).
+ * @details Entries of the other Matrix which are not in the sparsity
+ *          pattern of this Matrix are added to the pattern.
+ * @param matrix the Matrix to add
+ * @param scale the multiple of the Matrix to add
+ */
+void Matrix::addMatrix(Matrix* matrix, FP_PRECISION scale) {
+
+  if (matrix->getNumCells() != _num_cells ||
+      matrix->getNumGroups() != _num_groups)
+    log_printf(ERROR, "Unable to add a Matrix with %d cells and %d groups "
+               "to a Matrix with %d cells and %d groups",
+               matrix->getNumCells(), matrix->getNumGroups(), _num_cells,
+               _num_groups);
+
+  matrix->assemble();
+
+  int* row_pointers = matrix->getRowPointers();
+  int* columns = matrix->getColumns();
+  FP_PRECISION* values = matrix->getValues();
+
+  #pragma omp parallel for
+  for (int row=0; row < _num_rows; row++) {
+    for (int i=row_pointers[row]; i < row_pointers[row+1]; i++) {
+      int index = findIndex(row, columns[i]);
+
+      if (index != -1)
+        _values[index] += scale * values[i];
+      else
+        _pending[row][columns[i]] += scale * values[i];
+    }
+  }
+
+  assemble();
+}
+
+
+/**
+ * @brief Merges the entries which are not yet in the sparsity pattern into
+ *        the CSR arrays.
+ * @details This must be called after filling the Matrix and before
+ *          multiplying or sweeping it. It does nothing if the pattern is
+ *          unchanged since the last call.
+ */
+void Matrix::assemble() {
+
+  /* Count the nonzeros in each row of the new sparsity pattern */
+  int num_new = 0;
+
+  for (int row=0; row < _num_rows; row++)
+    num_new += _pending[row].size();
+
+  if (num_new == 0)
+    return;
+
+  int* row_pointers = new int[_num_rows+1];
+  int* columns = new int[_row_pointers[_num_rows] + num_new];
+  FP_PRECISION* values = new FP_PRECISION[_row_pointers[_num_rows] + num_new];
+  int index = 0;
+
+  /* Merge the sorted columns of each row with the pending columns */
+  for (int row=0; row < _num_rows; row++) {
+
+    row_pointers[row] = index;
+    std::map<int, FP_PRECISION>::iterator iter = _pending[row].begin();
+    int i = _row_pointers[row];
+
+    while (i < _row_pointers[row+1] || iter != _pending[row].end()) {
+
+      if (iter == _pending[row].end() ||
+          (i < _row_pointers[row+1] && _columns[i] < iter->first)) {
+        columns[index] = _columns[i];
+        values[index] = _values[i];
+        i++;
+      }
+      else {
+        columns[index] = iter->first;
+        values[index] = iter->second;
+        ++iter;
+      }
+
+      index++;
+    }
+
+    _pending[row].clear();
+  }
+
+  row_pointers[_num_rows] = index;
+
+  delete [] _row_pointers;
+  if (_columns != NULL)
+    delete [] _columns;
+  if (_values != NULL)
+    delete [] _values;
+
+  _row_pointers = row_pointers;
+  _columns = columns;
+  _values = values;
+
+  /* Find the diagonal in each row */
+  for (int row=0; row < _num_rows; row++)
+    _diagonals[row] = findIndex(row, row);
+
+  log_printf(DEBUG, "Assembled a Matrix with %d rows and %d nonzeros",
+             _num_rows, getNumNonzeros());
+}
+
+
+/**
+ * @brief Sets all values to zero while keeping the sparsity pattern.
+ */
+void Matrix::clear() {
+
+  #pragma omp parallel for
+  for (int i=0; i < getNumNonzeros(); i++)
+    _values[i] = 0.;
+
+  for (int row=0; row < _num_rows; row++)
+    _pending[row].clear();
+}
+
+
+/**
+ * @brief Multiplies a vector by the Matrix (i.e., y = Ax).
+ * @details The Matrix must be assembled.
+ * @param vec_x the x vector
+ * @param vec_y the y vector
+ */
+void Matrix::multiply(FP_PRECISION* vec_x, FP_PRECISION* vec_y) {
+
+  #pragma omp parallel for
+  for (int row=0; row < _num_rows; row++) {
+
+    FP_PRECISION val = 0.;
+
+    for (int i=_row_pointers[row]; i < _row_pointers[row+1]; i++)
+      val += _values[i] * vec_x[_columns[i]];
+
+    vec_y[row] = val;
+  }
+}
+
+
+/**
+ * @brief Performs a Gauss-Seidel sweep with successive over-relaxation over
+ *        the rows of a list of cells for the linear system Ax = b.
+ * @details The rows in each cell are relaxed in order of increasing group
+ *          using the latest values of x. The cells are relaxed in parallel,
+ *          and so must not be coupled to one another (e.g., the cells of
+ *          one color of a red-black ordering). The Matrix must be assembled
+ *          and have a diagonal in every row which is relaxed.
+ * @param vec_x the x vector, updated in place
+ * @param vec_b the b vector
+ * @param SOR_factor the over-relaxation factor
+ * @param cells the cells to relax
+ * @param num_cells the number of cells to relax
+ */
+void Matrix::sweepGaussSeidel(FP_PRECISION* vec_x, FP_PRECISION* vec_b,
+                              FP_PRECISION SOR_factor, int* cells,
+                              int num_cells) {
+
+  #pragma omp parallel for
+  for (int c=0; c < num_cells; c++) {
+    for (int g=0; g < _num_groups; g++) {
+
+      int row = cells[c] * _num_groups + g;
+      FP_PRECISION val = vec_b[row];
+
+      /* Compute the residual of the row including the diagonal */
+      for (int i=_row_pointers[row]; i < _row_pointers[row+1]; i++)
+        val -= _values[i] * vec_x[_columns[i]];
+
+      vec_x[row] += SOR_factor * val / _values[_diagonals[row]];
+    }
+  }
+}
+
+
+/**
+ * @brief Returns the coupling of a cell and group to a cell and group.
+ * @param cell_from the cell of the column
+ * @param group_from the group of the column
+ * @param cell_to the cell of the row
+ * @param group_to the group of the row
+ * @return the value of the entry (0 if it is not in the sparsity pattern)
+ */
+FP_PRECISION Matrix::getValue(int cell_from, int group_from, int cell_to,
+                              int group_to) {
+
+  if (cell_from < 0 || cell_from >= _num_cells ||
+      cell_to < 0 || cell_to >= _num_cells ||
+      group_from < 0 || group_from >= _num_groups ||
+      group_to < 0 || group_to >= _num_groups)
+    log_printf(ERROR, "Unable to get the Matrix entry from cell %d group %d "
+               "to cell %d group %d for %d cells and %d groups", cell_from,
+               group_from, cell_to, group_to, _num_cells, _num_groups);
+
+  int row = cell_to * _num_groups + group_to;
+  int column = cell_from * _num_groups + group_from;
+  int index = findIndex(row, column);
+
+  if (index != -1)
+    return _values[index];
+
+  std::map<int, FP_PRECISION>::iterator iter = _pending[row].find(column);
+
+  if (iter != _pending[row].end())
+    return iter->second;
+
+  return 0.;
+}
+
+
+/**
+ * @brief Returns the number of cells (blocks of rows).
+ * @return the number of cells
+ */
+int Matrix::getNumCells() {
+  return _num_cells;
+}
+
+
+/**
+ * @brief Returns the number of energy groups (rows in each block).
+ * @return the number of energy groups
+ */
+int Matrix::getNumGroups() {
+  return _num_groups;
+}
+
+
+/**
+ * @brief Returns the number of rows.
+ * @return the number of rows
+ */
+int Matrix::getNumRows() {
+  return _num_rows;
+}
+
+
+/**
+ * @brief Returns the number of nonzeros in the assembled Matrix.
+ * @return the number of nonzeros
+ */
+int Matrix::getNumNonzeros() {
+  return _row_pointers[_num_rows];
+}
+
+
+/**
+ * @brief Returns the index of the first nonzero in each row, followed by
+ *        the number of nonzeros.
+ * @return a pointer to the row pointers
+ */
+int* Matrix::getRowPointers() {
+  return _row_pointers;
+}
+
+
+/**
+ * @brief Returns the column index of each nonzero.
+ * @return a pointer to the column indices
+ */
+int* Matrix::getColumns() {
+  return _columns;
+}
+
+
+/**
+ * @brief Returns the value of each nonzero.
+ * @return a pointer to the values
+ */
+FP_PRECISION* Matrix::getValues() {
+  return _values;
+}
+
+
+/**
+ * @brief Returns the index of the diagonal nonzero in each row.
+ * @return a pointer to the diagonal indices (-1 for rows without one)
+ */
+int* Matrix::getDiagonals() {
+  return _diagonals;
+}
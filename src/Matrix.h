@@ -0,0 +1,99 @@
+/**
+ * @file Matrix.h
+ * @brief The Matrix class.
+ * @date October 18, 2026
+ */
+
+#ifndef MATRIX_H_
+#define MATRIX_H_
+
+#ifdef __cplusplus
+#include "log.h"
+#include <omp.h>
+#include <map>
+#include <vector>
+#include <algorithm>
+#endif
+
+
+/**
+ * @class Matrix Matrix.h "src/Matrix.h"
+ * @brief A sparse matrix in compressed sparse row (CSR) format for the
+ *        CMFD loss and production operators.
+ * @details The rows are grouped into blocks of one row per energy group for
+ *          each CMFD mesh cell, such that row (cell * num_groups + group)
+ *          holds the equation for a cell and group. The nonzero values are
+ *          stored contiguously by row with the column indices sorted within
+ *          each row.
+ *
+ *          The sparsity pattern is built when the matrix is first filled:
+ *          values added to entries which are not yet in the pattern are held
+ *          aside until assemble() merges them into the CSR arrays. Once
+ *          assembled, clear() zeroes the values but keeps the pattern, so
+ *          that refilling the matrix with the same entries does not
+ *          allocate. Threads may fill the matrix concurrently as long as
+ *          each thread fills distinct rows.
+ */
+class Matrix {
+
+private:
+
+  /** The number of cells (blocks of rows) */
+  int _num_cells;
+
+  /** The number of energy groups (rows in each block) */
+  int _num_groups;
+
+  /** The number of rows */
+  int _num_rows;
+
+  /** The index of the first nonzero in each row, with the number of
+   *  nonzeros at the end */
+  int* _row_pointers;
+
+  /** The column index of each nonzero */
+  int* _columns;
+
+  /** The value of each nonzero */
+  FP_PRECISION* _values;
+
+  /** The index of the diagonal nonzero in each row (-1 if none) */
+  int* _diagonals;
+
+  /** The values to add to entries which are not yet in the sparsity
+   *  pattern, indexed by row and then column */
+  std::vector< std::map<int, FP_PRECISION> > _pending;
+
+  int findIndex(int row, int column);
+
+public:
+  Matrix(int num_cells, int num_groups);
+  virtual ~Matrix();
+
+  /* Worker functions */
+  void incrementValue(int cell_from, int group_from, int cell_to,
+                      int group_to, FP_PRECISION value);
+  void setValue(int cell_from, int group_from, int cell_to, int group_to,
+                FP_PRECISION value);
+  void addMatrix(Matrix* matrix, FP_PRECISION scale);
+  void assemble();
+  void clear();
+  void multiply(FP_PRECISION* vec_x, FP_PRECISION* vec_y);
+  void sweepGaussSeidel(FP_PRECISION* vec_x, FP_PRECISION* vec_b,
+                        FP_PRECISION SOR_factor, int* cells, int num_cells);
+
+  /* Get parameters */
+  FP_PRECISION getValue(int cell_from, int group_from, int cell_to,
+                        int group_to);
+  int getNumCells();
+  int getNumGroups();
+  int getNumRows();
+  int getNumNonzeros();
+  int* getRowPointers();
+  int* getColumns();
+  FP_PRECISION* getValues();
+  int* getDiagonals();
+};
+
+
+#endif /* MATRIX_H_ */
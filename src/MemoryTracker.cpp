@@ -0,0 +1,262 @@
+#include "MemoryTracker.h"
+
+
+/**
+ * @brief Constructor initializes the usage of each subsystem to zero
+ *        without a memory budget.
+ */
+MemoryTracker::MemoryTracker() {
+
+  for (int i=0; i < NUM_MEMORY_SUBSYSTEMS; i++)
+    _usage[i] = 0;
+
+  _peak_usage = 0;
+  _budget = 0;
+}
+
+
+/**
+ * @brief Returns the memory budget.
+ * @return the maximum number of bytes which may be in use (0 for no limit)
+ */
+size_t MemoryTracker::getBudget() {
+  return _budget;
+}
+
+
+/**
+ * @brief Returns the bytes in use by a subsystem.
+ * @param subsystem the subsystem of interest
+ * @return the number of bytes in use
+ */
+size_t MemoryTracker::getUsage(memorySubsystem subsystem) {
+
+  if (subsystem < 0 || subsystem >= NUM_MEMORY_SUBSYSTEMS)
+    log_printf(ERROR, "Unable to get the memory usage of subsystem %d "
+               "which does not exist", subsystem);
+
+  return _usage[subsystem];
+}
+
+
+/**
+ * @brief Returns the bytes in use by all subsystems.
+ * @return the total number of bytes in use
+ */
+size_t MemoryTracker::getTotalUsage() {
+
+  size_t total = 0;
+
+  for (int i=0; i < NUM_MEMORY_SUBSYSTEMS; i++)
+    total += _usage[i];
+
+  return total;
+}
+
+
+/**
+ * @brief Returns the largest total number of bytes in use at once since
+ *        the start of the process or the last call to resetPeakUsage().
+ * @return the peak number of bytes in use
+ */
+size_t MemoryTracker::getPeakUsage() {
+  return _peak_usage;
+}
+
+
+/**
+ * @brief Returns the name of a subsystem for reports and error messages.
+ * @param subsystem the subsystem of interest
+ * @return the name of the subsystem
+ */
+const char* MemoryTracker::getSubsystemName(memorySubsystem subsystem) {
+
+  switch (subsystem) {
+  case TRACK_MEMORY:
+    return "Tracks and segments";
+  case GEOMETRY_MEMORY:
+    return "Geometry FSR maps";
+  case SOLVER_MEMORY:
+    return "Solver fluxes and sources";
+  case ACCELERATION_MEMORY:
+    return "Source iteration acceleration";
+  case CMFD_MEMORY:
+    return "CMFD";
+  case EXP_TABLE_MEMORY:
+    return "Exponential table";
+  }
+
+  return "Unknown";
+}
+
+
+/**
+ * @brief Sets the maximum number of bytes which may be in use at once.
+ * @details Allocations which would exceed the budget raise an error. A
+ *          budget of zero (the default) removes the limit. A budget below
+ *          the memory already in use only affects later allocations.
+ * @param num_bytes the memory budget in bytes
+ */
+void MemoryTracker::setBudget(size_t num_bytes) {
+
+  _budget = num_bytes;
+
+  if (_budget > 0 && getTotalUsage() > _budget)
+    log_printf(WARNING, "The memory budget of %.1f MB is less than the "
+               "%.1f MB already in use", _budget / 1.E6,
+               getTotalUsage() / 1.E6);
+}
+
+
+/**
+ * @brief Returns whether some more bytes would fit in the memory budget.
+ * @param num_bytes the number of bytes to be allocated
+ * @return true if the bytes fit within the budget (or there is no budget)
+ */
+bool MemoryTracker::fitsBudget(size_t num_bytes) {
+  return _budget == 0 || getTotalUsage() + num_bytes <= _budget;
+}
+
+
+/**
+ * @brief Records memory to be allocated by a subsystem.
+ * @details This should be called before the memory is allocated, so that
+ *          an allocation which would exceed the memory budget raises an
+ *          error with the memory in use by each subsystem instead of
+ *          running out of memory.
+ * @param subsystem the subsystem which allocates the memory
+ * @param num_bytes the number of bytes to be allocated
+ */
+void MemoryTracker::allocate(memorySubsystem subsystem, size_t num_bytes) {
+
+  if (subsystem < 0 || subsystem >= NUM_MEMORY_SUBSYSTEMS)
+    log_printf(ERROR, "Unable to allocate memory for subsystem %d "
+               "which does not exist", subsystem);
+
+  if (!fitsBudget(num_bytes)) {
+
+    /* Suggest how the subsystem can use less memory */
+    const char* suggestion = "";
+
+    switch (subsystem) {
+    case TRACK_MEMORY:
+      suggestion = "Use a larger track spacing or fewer azimuthal angles.";
+      break;
+    case GEOMETRY_MEMORY:
+      suggestion = "Use fewer rings and sectors to subdivide the Cells.";
+      break;
+    case SOLVER_MEMORY:
+      suggestion = "Use fewer polar angles or energy groups, or build "
+                   "OpenMOC in single precision.";
+      break;
+    case ACCELERATION_MEMORY:
+      suggestion = "Use a smaller Anderson depth or Krylov restart.";
+      break;
+    case CMFD_MEMORY:
+      suggestion = "Use a coarser CMFD mesh or fewer CMFD groups.";
+      break;
+    case EXP_TABLE_MEMORY:
+      suggestion = "Use the exponential intrinsic instead of the table.";
+      break;
+    }
+
+    printReport();
+    log_printf(ERROR, "Unable to allocate %.1f MB for the %s since the %.1f "
+               "MB in use would exceed the memory budget of %.1f MB. %s",
+               num_bytes / 1.E6, getSubsystemName(subsystem),
+               getTotalUsage() / 1.E6, _budget / 1.E6, suggestion);
+  }
+
+  _usage[subsystem] += num_bytes;
+  _peak_usage = std::max(_peak_usage, getTotalUsage());
+}
+
+
+/**
+ * @brief Records memory which has been deleted by a subsystem.
+ * @details This does not raise errors since it is called from destructors.
+ *          Releasing more memory than is in use only prints a warning and
+ *          sets the usage of the subsystem to zero.
+ * @param subsystem the subsystem which deleted the memory
+ * @param num_bytes the number of bytes which were deleted
+ */
+void MemoryTracker::release(memorySubsystem subsystem, size_t num_bytes) {
+
+  if (subsystem < 0 || subsystem >= NUM_MEMORY_SUBSYSTEMS) {
+    log_printf(WARNING, "Unable to release memory for subsystem %d "
+               "which does not exist", subsystem);
+    return;
+  }
+
+  if (num_bytes > _usage[subsystem]) {
+    log_printf(WARNING, "Unable to release %lu bytes for the %s which only "
+               "has %lu bytes in use", (unsigned long)num_bytes,
+               getSubsystemName(subsystem), (unsigned long)_usage[subsystem]);
+    _usage[subsystem] = 0;
+    return;
+  }
+
+  _usage[subsystem] -= num_bytes;
+}
+
+
+/**
+ * @brief Replaces the memory recorded by an object for a subsystem.
+ * @details This is a helper for objects which keep the number of bytes
+ *          they have recorded, and which reallocate their arrays with a
+ *          new size. The old bytes are released before the new bytes are
+ *          allocated, and the object's count is zero if the new bytes would
+ *          exceed the memory budget.
+ * @param subsystem the subsystem of the memory
+ * @param num_bytes the object's count of recorded bytes to be updated
+ * @param new_num_bytes the new number of bytes used by the object
+ */
+void MemoryTracker::update(memorySubsystem subsystem, size_t& num_bytes,
+                           size_t new_num_bytes) {
+
+  release(subsystem, num_bytes);
+  num_bytes = 0;
+  allocate(subsystem, new_num_bytes);
+  num_bytes = new_num_bytes;
+}
+
+
+/**
+ * @brief Resets the peak memory usage to the memory currently in use.
+ */
+void MemoryTracker::resetPeakUsage() {
+  _peak_usage = getTotalUsage();
+}
+
+
+/**
+ * @brief Prints the memory in use by each subsystem, the peak memory
+ *        usage and the memory budget.
+ */
+void MemoryTracker::printReport() {
+
+  log_printf(TITLE, "MEMORY REPORT");
+
+  for (int i=0; i < NUM_MEMORY_SUBSYSTEMS; i++) {
+    std::string msg_string = getSubsystemName(memorySubsystem(i));
+    msg_string.resize(53, '.');
+    log_printf(RESULT, "%s%10.2f MB", msg_string.c_str(), _usage[i] / 1.E6);
+  }
+
+  std::string msg_string = "Total";
+  msg_string.resize(53, '.');
+  log_printf(RESULT, "%s%10.2f MB", msg_string.c_str(),
+             getTotalUsage() / 1.E6);
+
+  msg_string = "Peak";
+  msg_string.resize(53, '.');
+  log_printf(RESULT, "%s%10.2f MB", msg_string.c_str(), _peak_usage / 1.E6);
+
+  if (_budget > 0) {
+    msg_string = "Budget";
+    msg_string.resize(53, '.');
+    log_printf(RESULT, "%s%10.2f MB", msg_string.c_str(), _budget / 1.E6);
+  }
+
+  log_printf(SEPARATOR, "-");
+}
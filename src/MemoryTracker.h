@@ -0,0 +1,132 @@
+/**
+ * @file MemoryTracker.h
+ * @brief The MemoryTracker class.
+ * @date October 18, 2026
+ */
+
+#ifndef MEMORYTRACKER_H_
+#define MEMORYTRACKER_H_
+
+#ifdef __cplusplus
+#include "log.h"
+#include <stddef.h>
+#include <string>
+#endif
+
+
+/** The number of subsystems for which memory is recorded */
+#define NUM_MEMORY_SUBSYSTEMS 6
+
+
+/**
+ * @enum memorySubsystem
+ * @brief The subsystems for which the MemoryTracker records memory.
+ */
+enum memorySubsystem {
+
+  /** The Tracks and their segments */
+  TRACK_MEMORY,
+
+  /** The FSR key maps and characteristic points of the Geometry */
+  GEOMETRY_MEMORY,
+
+  /** The Solver's flux, source and FSR arrays */
+  SOLVER_MEMORY,
+
+  /** The history vectors of Anderson acceleration, Chebyshev extrapolation
+   *  or the Newton-Krylov solver */
+  ACCELERATION_MEMORY,
+
+  /** The CMFD matrices, vectors and surface currents */
+  CMFD_MEMORY,
+
+  /** The exponential linear interpolation table */
+  EXP_TABLE_MEMORY
+};
+
+
+/**
+ * @class MemoryTracker MemoryTracker.h "src/MemoryTracker.h"
+ * @brief Records the memory used by each subsystem and enforces a budget.
+ * @details The largest data structures of a calculation are recorded in
+ *          bytes by the objects which own them, with allocate(...) before
+ *          they are allocated and release(...) after they are deleted. If a
+ *          memory budget has been set, an allocation which would exceed it
+ *          raises an error before any memory is allocated, rather than
+ *          running out of memory part way through a calculation. The usage
+ *          is estimated from the sizes of the arrays and containers, and
+ *          does not include small objects such as Materials and Cells.
+ *
+ *          The MemoryTracker is shared by all objects in the process and is
+ *          used from Python as follows:
+ *
+ * @code
+ *          tracker = openmoc.MemoryTracker.Get()
+ *          tracker.setBudget(8 * 1024**3)
+ *          solver.computeEigenvalue()
+ *          tracker.printReport()
+ * @endcode
+ */
+class MemoryTracker {
+
+private:
+
+  /** The bytes in use by each subsystem */
+  size_t _usage[NUM_MEMORY_SUBSYSTEMS];
+
+  /** The largest total number of bytes in use at once */
+  size_t _peak_usage;
+
+  /** The maximum number of bytes which may be in use (0 for no limit) */
+  size_t _budget;
+
+  MemoryTracker();
+
+  /**
+   * @brief Assignment operator for static referencing of the MemoryTracker.
+   * @param & the MemoryTracker static class object
+   * @return a pointer to the MemoryTracker static class object
+   */
+  MemoryTracker &operator=(const MemoryTracker &) { return *this; }
+
+  /**
+   * @brief MemoryTracker copy constructor.
+   * @param & The MemoryTracker static reference pointer.
+   */
+  MemoryTracker(const MemoryTracker &) { }
+
+public:
+
+  /**
+   * @brief Returns a static instance of the MemoryTracker class.
+   * @return a pointer to the static MemoryTracker class
+   */
+  static MemoryTracker *Get() {
+    static MemoryTracker instance;
+    return &instance;
+  }
+
+  /* Get parameters */
+  size_t getBudget();
+  size_t getUsage(memorySubsystem subsystem);
+  size_t getTotalUsage();
+  size_t getPeakUsage();
+  const char* getSubsystemName(memorySubsystem subsystem);
+
+  /* Set parameters */
+  void setBudget(size_t num_bytes);
+
+  /* Worker functions */
+  bool fitsBudget(size_t num_bytes);
+  void allocate(memorySubsystem subsystem, size_t num_bytes);
+  void release(memorySubsystem subsystem, size_t num_bytes);
+#ifndef SWIG
+  void update(memorySubsystem subsystem, size_t& num_bytes,
+              size_t new_num_bytes);
+#endif
+  void resetPeakUsage();
+  void printReport();
+};
+
+
+#endif /* MEMORYTRACKER_H_ */
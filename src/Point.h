@@ -9,7 +9,6 @@
 #define POINT_H_
 
 #ifdef __cplusplus
-#include "Python.h"
 #include "log.h"
 #include <math.h>
 #include <sstream>
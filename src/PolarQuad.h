@@ -13,7 +13,6 @@
 #define POLARQUAD_H_
 
 #ifdef __cplusplus
-#include "Python.h"
 #include "constants.h"
 #include "log.h"
 #include <sstream>
@@ -42,8 +42,44 @@ Solver::Solver(TrackGenerator* track_generator) {
 
   _num_iterations = 0;
   _converge_thresh = 1E-5;
+  _warm_start = false;
+  _restart = false;
+  _start_iteration = 0;
+  _checkpoint_interval = 0;
+
+  _krylov_restart = 20;
+  _krylov_tolerance = 1E-1;
+  _krylov_power_iterations = 3;
+
+  _anderson_depth = 0;
+  _anderson_num_iterations = 0;
+  _anderson_num_stored = 0;
+  _anderson_index = 0;
+  _anderson_residual = 0.;
+  _anderson_x = NULL;
+  _anderson_g = NULL;
+  _anderson_f = NULL;
+  _anderson_delta_g = NULL;
+  _anderson_delta_f = NULL;
+
+  _chebyshev_order = 0;
+  _chebyshev_step = 0;
+  _chebyshev_num_iterations = 0;
+  _chebyshev_num_power_iterations = 0;
+  _chebyshev_cycle_residual = 0.;
+  _chebyshev_residual = 0.;
+  _chebyshev_x = NULL;
+  _chebyshev_x_old = NULL;
+  _dominance_ratio = 0.;
 
   _timer = new Timer();
+  _sweep_time = 0.;
+  _num_sweeps = 0;
+  _tot_num_segments = 0;
+  _history_file = NULL;
+
+  for (int i=0; i < NUM_MEMORY_SUBSYSTEMS; i++)
+    _memory_usage[i] = 0;
 }
 
 
@@ -85,6 +121,25 @@ Solver::~Solver() {
 
   if (_polar_quad != NULL && !_user_polar_quad)
     delete _polar_quad;
+
+  if (_anderson_x != NULL) {
+    delete [] _anderson_x;
+    delete [] _anderson_g;
+    delete [] _anderson_f;
+    delete [] _anderson_delta_g;
+    delete [] _anderson_delta_f;
+  }
+
+  if (_chebyshev_x != NULL) {
+    delete [] _chebyshev_x;
+    delete [] _chebyshev_x_old;
+  }
+
+  if (_history_file != NULL)
+    fclose(_history_file);
+
+  for (int i=0; i < NUM_MEMORY_SUBSYSTEMS; i++)
+    MemoryTracker::Get()->release(memorySubsystem(i), _memory_usage[i]);
 }
 
 
@@ -213,6 +268,164 @@ bool Solver::isUsingExponentialInterpolation() {
 }
 
 
+/**
+ * @brief Returns whether eigenvalue calculations start from the current
+ *        fluxes and eigenvalue.
+ * @return true if using warm starts; false otherwise
+ */
+bool Solver::isUsingWarmStart() {
+  return _warm_start;
+}
+
+
+/**
+ * @brief Returns the number of previous iterates mixed by Anderson
+ *        acceleration.
+ * @return the Anderson depth (0 if Anderson acceleration is not used)
+ */
+int Solver::getAndersonDepth() {
+  return _anderson_depth;
+}
+
+
+/**
+ * @brief Returns the number of steps in each cycle of Chebyshev
+ *        extrapolation.
+ * @return the Chebyshev order (0 if Chebyshev extrapolation is not used)
+ */
+int Solver::getChebyshevOrder() {
+  return _chebyshev_order;
+}
+
+
+/**
+ * @brief Returns the dominance ratio estimated in the last eigenvalue
+ *        calculation.
+ * @details With Chebyshev extrapolation, this is the dominance ratio fit to
+ *          the error reduction of each Chebyshev cycle. Otherwise it is the
+ *          asymptotic ratio of successive residuals, which is the spectral
+ *          radius of the source iteration as accelerated by CMFD or
+ *          Anderson acceleration (if either is in use), and is zero if the
+ *          calculation took fewer than six source iterations.
+ * @return the estimated dominance ratio
+ */
+double Solver::getDominanceRatio() {
+  return _dominance_ratio;
+}
+
+
+/**
+ * @brief Returns the number of iterations recorded in the convergence
+ *        history of the last calculation.
+ * @return the number of iterations in the convergence history
+ */
+int Solver::getNumHistoryIterations() {
+  return _history.size() / NUM_HISTORY_QUANTITIES;
+}
+
+
+/**
+ * @brief Fills an array with the convergence history of the last
+ *        calculation.
+ * @details The history is indexed by iteration and then historyQuantity
+ *          (e.g., HISTORY_K_EFF or HISTORY_SWEEP_TIME). A row is recorded
+ *          for each source iteration, and for each Newton iteration of a
+ *          Newton-Krylov calculation. This method may be called from Python
+ *          as follows:
+ *
+ * @code
+ *          num_values = solver.getNumHistoryIterations() * 8
+ *          history = solver.getConvergenceHistory(num_values).reshape(-1, 8)
+ * @endcode
+ *
+ * @param history an array to store the convergence history
+ * @param num_values the number of values (iterations times quantities)
+ */
+void Solver::getConvergenceHistory(double* history, int num_values) {
+
+  if (num_values != int(_history.size()))
+    log_printf(ERROR, "Unable to get %d values of the convergence history "
+               "since %d were recorded", num_values, int(_history.size()));
+
+  for (int i=0; i < num_values; i++)
+    history[i] = _history[i];
+}
+
+
+/**
+ * @brief Predicts the memory which the Solver will use for an eigenvalue
+ *        calculation.
+ * @details The prediction is computed from the number of FSRs, Tracks,
+ *          energy groups and polar angles before any flux arrays are
+ *          allocated, and includes the memory for Anderson acceleration or
+ *          Chebyshev extrapolation, CMFD and the exponential table. It does
+ *          not include the Tracks and Geometry, which are recorded with the
+ *          MemoryTracker when the Tracks are generated. This method may be
+ *          called from Python as follows:
+ *
+ * @code
+ *          num_bytes = solver.predictMemoryUsage()
+ * @endcode
+ *
+ * @return the number of bytes used by the Solver
+ */
+size_t Solver::predictMemoryUsage() {
+
+  if (_track_generator == NULL)
+    log_printf(ERROR, "Unable to predict the Solver's memory usage since it "
+               "does not contain a TrackGenerator");
+
+  size_t num_bytes[NUM_MEMORY_SUBSYSTEMS];
+  countMemoryUsage(num_bytes);
+
+  size_t total = 0;
+  for (int i=0; i < NUM_MEMORY_SUBSYSTEMS; i++)
+    total += num_bytes[i];
+
+  return total;
+}
+
+
+/**
+ * @brief Returns the number of source iterations for which the hardware
+ *        counts of the transport sweep were recorded in the last
+ *        calculation.
+ * @details Hardware counts are only recorded once they are turned on with
+ *          Timer::setHardwareCounters(true).
+ * @return the number of source iterations with hardware counts
+ */
+int Solver::getNumCounterIterations() {
+  return _sweep_counters.size() / NUM_HARDWARE_COUNTERS;
+}
+
+
+/**
+ * @brief Fills an array with the hardware counts of the transport sweep in
+ *        each source iteration of the last calculation.
+ * @details The counts are summed over all threads and indexed by iteration
+ *          and then hardwareCounter (CYCLES, INSTRUCTIONS, LLC_MISSES and
+ *          VECTOR_INSTRUCTIONS). Counters which are unavailable are zero.
+ *          This method may be called from Python as follows:
+ *
+ * @code
+ *          num_values = solver.getNumCounterIterations() * 4
+ *          counters = solver.getSweepCounters(num_values).reshape(-1, 4)
+ * @endcode
+ *
+ * @param counters an array to store the hardware counts
+ * @param num_values the number of counts (iterations times counters)
+ */
+void Solver::getSweepCounters(double* counters, int num_values) {
+
+  if (num_values != int(_sweep_counters.size()))
+    log_printf(ERROR, "Unable to get %d hardware counts since %d were "
+               "recorded", num_values, int(_sweep_counters.size()));
+
+  for (int i=0; i < num_values; i++)
+    counters[i] = _sweep_counters[i];
+}
+
+
 /**
  * @brief Returns the scalar flux for some FSR and energy group.
  * @param fsr_id the ID for the FSR of interest
@@ -478,6 +691,391 @@ void Solver::setFixedSourceByMaterial(Material* material, int group,
 }
 
 
+/**
+ * @brief Replaces a Material everywhere it fills the Geometry.
+ * @details This updates the TrackGenerator's segments and the Solver's
+ *          FSR Materials in place, so that a subsequent eigenvalue
+ *          calculation uses the new cross-sections without any ray tracing
+ *          or Track file I/O. This can be called from Python as follows:
+ *
+ * @code
+ *          solver.rebindMaterial(fuel.getId(), hot_fuel)
+ *          solver.computeEigenvalue()
+ * @endcode
+ *
+ * @param material_id the ID of the Material to replace
+ * @param material a pointer to the new Material
+ */
+void Solver::rebindMaterial(int material_id, Material* material) {
+
+  if (_track_generator == NULL)
+    log_printf(ERROR, "Unable to rebind Material %d since the Solver does "
+               "not contain a TrackGenerator", material_id);
+
+  _track_generator->rebindMaterial(material_id, material);
+
+  /* Update the FSR Materials if they have been initialized */
+  if (_FSR_materials != NULL) {
+    for (int r=0; r < _num_FSRs; r++) {
+      if (_FSR_materials[r]->getId() == material_id)
+        _FSR_materials[r] = material;
+    }
+
+    countFissionableFSRs();
+  }
+}
+
+
+/**
+ * @brief Assigns a Material to some FSRs.
+ * @details The TrackGenerator's segments and the Solver's FSR Materials
+ *          are updated in place for the next eigenvalue calculation.
+ * @param fsr_ids an array of FSR IDs
+ * @param num_fsr_ids the number of FSR IDs
+ * @param material a pointer to the Material to fill the FSRs
+ */
+void Solver::rebindFSRMaterials(int* fsr_ids, int num_fsr_ids,
+                                Material* material) {
+
+  if (_track_generator == NULL)
+    log_printf(ERROR, "Unable to rebind FSR Materials since the Solver does "
+               "not contain a TrackGenerator");
+
+  _track_generator->rebindFSRMaterials(fsr_ids, num_fsr_ids, material);
+
+  /* Update the FSR Materials if they have been initialized */
+  if (_FSR_materials != NULL) {
+    for (int i=0; i < num_fsr_ids; i++)
+      _FSR_materials[fsr_ids[i]] = material;
+
+    countFissionableFSRs();
+  }
+}
+
+
+/**
+ * @brief Copies the scalar flux in each FSR and energy group into an array.
+ * @details The array is indexed by FSR and then energy group, and must
+ *          hold the scalar flux for all FSRs in a whole number of groups.
+ * @param out_fluxes an array to store the scalar fluxes
+ * @param num_fluxes the number of FSRs times the number of energy groups
+ */
+void Solver::getFluxes(FP_PRECISION* out_fluxes, int num_fluxes) {
+
+  if (_scalar_flux == NULL)
+    log_printf(ERROR, "Unable to get the scalar fluxes since they "
+               "have not yet been computed");
+
+  int num_groups = num_fluxes / std::max(_num_FSRs, 1);
+
+  if (num_groups * _num_FSRs != num_fluxes || num_groups > _num_groups)
+    log_printf(ERROR, "Unable to get %d scalar fluxes for %d FSRs and %d "
+               "energy groups", num_fluxes, _num_FSRs, _num_groups);
+
+  #pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int e=0; e < num_groups; e++)
+      out_fluxes[r*num_groups+e] = _scalar_flux(r,e);
+  }
+}
+
+
+/**
+ * @brief Sets the scalar flux in each FSR and energy group from an array.
+ * @details This is used to provide an initial guess for an eigenvalue
+ *          calculation with warm starts. The flux arrays must have been
+ *          allocated by an earlier calculation with the same TrackGenerator.
+ * @param in_fluxes an array of scalar fluxes indexed by FSR and group
+ * @param num_fluxes the number of FSRs times the number of energy groups
+ */
+void Solver::setFluxes(FP_PRECISION* in_fluxes, int num_fluxes) {
+
+  if (_scalar_flux == NULL)
+    log_printf(ERROR, "Unable to set the scalar fluxes since they "
+               "have not yet been allocated");
+
+  int num_groups = num_fluxes / std::max(_num_FSRs, 1);
+
+  if (num_groups * _num_FSRs != num_fluxes || num_groups > _num_groups)
+    log_printf(ERROR, "Unable to set %d scalar fluxes for %d FSRs and %d "
+               "energy groups", num_fluxes, _num_FSRs, _num_groups);
+
+  #pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int e=0; e < num_groups; e++)
+      _scalar_flux(r,e) = in_fluxes[r*num_groups+e];
+  }
+}
+
+
+/**
+ * @brief Returns the number of Track boundary angular fluxes.
+ * @details This is the size of the arrays for getBoundaryFluxes(...) and
+ *          setBoundaryFluxes(...), which is the number of Tracks times two
+ *          directions, the number of polar angles and the number of energy
+ *          groups.
+ * @return the number of boundary angular fluxes
+ */
+int Solver::getNumBoundaryFluxes() {
+
+  long num_fluxes = 2 * long(_tot_num_tracks) * _num_polar *
+                    _geometry->getNumEnergyGroups();
+
+  if (num_fluxes > std::numeric_limits<int>::max())
+    log_printf(ERROR, "Unable to get the number of boundary fluxes since "
+               "%ld fluxes exceed the range of an integer", num_fluxes);
+
+  return num_fluxes;
+}
+
+
+/**
+ * @brief Copies the angular flux at each end of each Track into an array.
+ * @details The array is indexed by Track, direction (forward and reverse),
+ *          polar angle and then energy group, and must hold
+ *          getNumBoundaryFluxes() values.
+ * @param out_fluxes an array to store the boundary angular fluxes
+ * @param num_fluxes the number of boundary angular fluxes
+ */
+void Solver::getBoundaryFluxes(FP_PRECISION* out_fluxes, int num_fluxes) {
+
+  if (_boundary_flux == NULL)
+    log_printf(ERROR, "Unable to get the boundary fluxes since they "
+               "have not yet been computed");
+
+  if (num_fluxes != getNumBoundaryFluxes())
+    log_printf(ERROR, "Unable to get %d boundary fluxes since there are "
+               "%d boundary fluxes", num_fluxes, getNumBoundaryFluxes());
+
+  int num_groups = _geometry->getNumEnergyGroups();
+
+  #pragma omp parallel for schedule(guided)
+  for (int i=0; i < _tot_num_tracks; i++) {
+    for (int j=0; j < 2; j++) {
+      for (int p=0; p < _num_polar; p++) {
+        for (int e=0; e < num_groups; e++)
+          out_fluxes[((long(i)*2+j)*_num_polar + p)*num_groups + e] =
+              _boundary_flux(i,j,p,e);
+      }
+    }
+  }
+}
+
+
+/**
+ * @brief Sets the angular flux at each end of each Track from an array.
+ * @details This is used with Solver::setFluxes(...) to provide a consistent
+ *          initial guess for an eigenvalue calculation with warm starts. The
+ *          array is indexed as for Solver::getBoundaryFluxes(...).
+ * @param in_fluxes an array of boundary angular fluxes
+ * @param num_fluxes the number of boundary angular fluxes
+ */
+void Solver::setBoundaryFluxes(FP_PRECISION* in_fluxes, int num_fluxes) {
+
+  if (_boundary_flux == NULL)
+    log_printf(ERROR, "Unable to set the boundary fluxes since they "
+               "have not yet been allocated");
+
+  if (num_fluxes != getNumBoundaryFluxes())
+    log_printf(ERROR, "Unable to set %d boundary fluxes since there are "
+               "%d boundary fluxes", num_fluxes, getNumBoundaryFluxes());
+
+  int num_groups = _geometry->getNumEnergyGroups();
+
+  #pragma omp parallel for schedule(guided)
+  for (int i=0; i < _tot_num_tracks; i++) {
+    for (int j=0; j < 2; j++) {
+      for (int p=0; p < _num_polar; p++) {
+        for (int e=0; e < num_groups; e++)
+          _boundary_flux(i,j,p,e) =
+              in_fluxes[((long(i)*2+j)*_num_polar + p)*num_groups + e];
+      }
+    }
+  }
+}
+
+
+/**
+ * @brief Sets the eigenvalue used as the initial guess for warm starts.
+ * @param k_eff the eigenvalue
+ */
+void Solver::setKeff(FP_PRECISION k_eff) {
+
+  if (k_eff <= 0.)
+    log_printf(ERROR, "Unable to set k_eff to %f since it is not a positive "
+               "number", k_eff);
+
+  _k_eff = k_eff;
+}
+
+
+/**
+ * @brief Sets whether eigenvalue calculations start from the current
+ *        fluxes and eigenvalue.
+ * @details With warm starts, Solver::computeEigenvalue(...) keeps the scalar
+ *          and boundary fluxes and \f$ k_{eff} \f$ from the previous
+ *          calculation (or those given by Solver::setFluxes(...) and
+ *          Solver::setKeff(...)) rather than starting from a flat flux.
+ *          The first calculation, before any fluxes exist, is always cold.
+ * @param warm_start whether to use warm starts
+ */
+void Solver::setWarmStart(bool warm_start) {
+  _warm_start = warm_start;
+}
+
+
+/**
+ * @brief Sets the Solver to write a checkpoint every few source iterations.
+ * @details Each checkpoint overwrites the previous one, so that a long
+ *          eigenvalue calculation which is interrupted may be resumed from
+ *          the last checkpoint with Solver::readCheckpoint(...) as follows:
+ *
+ * @code
+ *          solver.setCheckpointInterval(10, 'checkpoint.data')
+ *          solver.computeEigenvalue()
+ *
+ *          # After an interruption, in a new process
+ *          solver.readCheckpoint('checkpoint.data')
+ *          solver.computeEigenvalue()
+ * @endcode
+ *
+ * @param num_iterations the number of source iterations between
+ *        checkpoints (0 to turn off checkpointing)
+ * @param filename the name of the checkpoint file
+ */
+void Solver::setCheckpointInterval(int num_iterations, const char* filename) {
+
+  if (num_iterations < 0)
+    log_printf(ERROR, "Unable to set the checkpoint interval to %d "
+               "iterations since it is negative", num_iterations);
+
+  _checkpoint_interval = num_iterations;
+  _checkpoint_filename = filename;
+}
+
+
+/**
+ * @brief Sets a file to which each iteration of the convergence history is
+ *        written as it is recorded.
+ * @details The file is rewritten at the start of each calculation, and each
+ *          iteration is flushed to it as soon as it is recorded so that a
+ *          running calculation may be monitored. Files ending in ".csv" are
+ *          written as comma separated values with a header line, and other
+ *          files as one JSON object per line. An empty filename stops
+ *          writing the history to a file. This method may be called from
+ *          Python as follows:
+ *
+ * @code
+ *          solver.setHistoryFile('convergence.jsonl')
+ *          solver.computeEigenvalue()
+ * @endcode
+ *
+ * @param filename the name of the convergence history file
+ */
+void Solver::setHistoryFile(const char* filename) {
+  _history_filename = filename;
+}
+
+
+/**
+ * @brief Sets the number of GMRES iterations before each restart in
+ *        Solver::computeEigenvalueNewtonKrylov(...).
+ * @param restart the GMRES restart length (20 by default)
+ */
+void Solver::setKrylovRestart(int restart) {
+
+  if (restart < 1)
+    log_printf(ERROR, "Unable to set the Krylov restart length to %d since "
+               "it is not a positive integer", restart);
+
+  _krylov_restart = restart;
+}
+
+
+/**
+ * @brief Sets the tolerance for GMRES in each Newton iteration of
+ *        Solver::computeEigenvalueNewtonKrylov(...).
+ * @details GMRES iterates until its residual is reduced by this factor
+ *          relative to the Newton-Krylov residual.
+ * @param tolerance the relative GMRES tolerance (0.1 by default)
+ */
+void Solver::setKrylovTolerance(FP_PRECISION tolerance) {
+
+  if (tolerance <= 0. || tolerance >= 1.)
+    log_printf(ERROR, "Unable to set the Krylov tolerance to %f since it is "
+               "not between 0 and 1", tolerance);
+
+  _krylov_tolerance = tolerance;
+}
+
+
+/**
+ * @brief Sets the number of power iterations which provide the initial
+ *        guess for Solver::computeEigenvalueNewtonKrylov(...).
+ * @param num_iters the number of power iterations (3 by default)
+ */
+void Solver::setKrylovPowerIterations(int num_iters) {
+
+  if (num_iters < 0)
+    log_printf(ERROR, "Unable to set the number of Krylov power iterations "
+               "to %d since it is negative", num_iters);
+
+  _krylov_power_iterations = num_iters;
+}
+
+
+/**
+ * @brief Sets the number of previous iterates mixed by Anderson
+ *        acceleration of the scalar flux between source iterations.
+ * @details Anderson acceleration replaces each source iterate with the
+ *          combination of the last depth+1 iterates which minimizes the
+ *          difference between successive iterates, in
+ *          Solver::computeEigenvalue(...) and Solver::computeSource(...),
+ *          with or without CMFD. A depth of 2 to 5 is typical:
+ *
+ * @code
+ *          solver.setAndersonDepth(3)
+ *          solver.computeEigenvalue()
+ * @endcode
+ *
+ * @param depth the Anderson depth (0 to turn off Anderson acceleration)
+ */
+void Solver::setAndersonDepth(int depth) {
+
+  if (depth < 0)
+    log_printf(ERROR, "Unable to set the Anderson depth to %d since it is "
+               "negative", depth);
+
+  _anderson_depth = depth;
+}
+
+
+/**
+ * @brief Sets the number of steps in each cycle of Chebyshev extrapolation
+ *        of the source iteration in Solver::computeEigenvalue(...).
+ * @details The dominance ratio is first estimated from the ratio of
+ *          successive residuals of a few power iterations and is refit to
+ *          the error reduction at the end of each cycle. Cycles of 4 to 8
+ *          steps are typical:
+ *
+ * @code
+ *          solver.setChebyshevOrder(6)
+ *          solver.computeEigenvalue()
+ *          print solver.getDominanceRatio()
+ * @endcode
+ *
+ * @param order the Chebyshev order (0 to turn off Chebyshev extrapolation)
+ */
+void Solver::setChebyshevOrder(int order) {
+
+  if (order < 0)
+    log_printf(ERROR, "Unable to set the Chebyshev order to %d since it is "
+               "negative", order);
+
+  _chebyshev_order = order;
+}
+
+
 /**
  * @brief Set the maximum allowable optical length for a track segment
  * @param max_optical_length The max optical length
@@ -651,28 +1249,226 @@ void Solver::initializeCmfd(){
 
 
 /**
- * @brief Computes the scalar flux distribution by performing a series of 
- *        transport sweeps.
- * @details This is the main method exposed to the user through the Python
- *          interface to compute the scalar flux distribution, e.g., for a 
- *          fixed source calculation. This routine makes an initial guess for
- *          scalar and boundary fluxes and performs transport sweep until 
- *          convergence. 
- *
- *          By default, this method will perform a maximum of 1000 transport
- *          sweeps with a 1E-5 threshold on the average FSR scalar flux. These
- *          values may be freely modified by the user at runtime.
- *
- *          The only_fixed_source runtime parameter may be used to control
- *          the type of source distribution used in the calculation. By 
- *          default, this paramter is true and only the fixed sources specified
- *          by the user will be considered. Alternatively, when the parameter
- *          is false, the source will be computed as the scattering and fission
- *          sources resulting from a previously computed flux distribution
- *          (e.g., an eigenvalue calculation) in addition to any user-defined
- *          fixed sources.
- *
- *          This method may be called by the user to compute the scalar flux 
+ * @brief Computes the memory used by the Solver's arrays for each subsystem.
+ * @details The memory is computed from the number of FSRs, Tracks, energy
+ *          groups and polar angles so that it may be checked against the
+ *          memory budget before the arrays are allocated. Subclasses which
+ *          allocate other arrays add them to the counts.
+ * @param num_bytes an array to store the bytes for each memorySubsystem
+ * @param newton_krylov whether to count the Newton-Krylov vectors rather
+ *        than Anderson acceleration or Chebyshev extrapolation
+ */
+void Solver::countMemoryUsage(size_t* num_bytes, bool newton_krylov) {
+
+  for (int i=0; i < NUM_MEMORY_SUBSYSTEMS; i++)
+    num_bytes[i] = 0;
+
+  size_t fp_size = sizeof(FP_PRECISION);
+  size_t num_fluxes = size_t(_num_FSRs) * _num_groups;
+  size_t num_boundary_fluxes = size_t(2) * _tot_num_tracks * _num_polar *
+                               _num_groups;
+
+  /* The boundary fluxes and leakages, the scalar fluxes, old scalar fluxes,
+   * reduced and fixed sources, and the FSR volumes and Materials */
+  num_bytes[SOLVER_MEMORY] = (2 * num_boundary_fluxes + 4 * num_fluxes +
+                              _num_FSRs + _num_azim * _num_polar) * fp_size +
+                             _num_FSRs * sizeof(Material*);
+
+  /* The history vectors of the scalar and boundary fluxes */
+  size_t size = num_fluxes + num_boundary_fluxes;
+
+  if (newton_krylov)
+    num_bytes[ACCELERATION_MEMORY] = (_krylov_restart + 9) * (size + 1) *
+                                     sizeof(double);
+  else if (_anderson_depth > 0)
+    num_bytes[ACCELERATION_MEMORY] = (2 * _anderson_depth + 3) * size *
+                                     fp_size;
+  else if (_chebyshev_order > 0)
+    num_bytes[ACCELERATION_MEMORY] = 2 * size * fp_size;
+
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn() && !newton_krylov)
+    num_bytes[CMFD_MEMORY] = _cmfd->predictMemoryUsage();
+
+  /* The exponential table for the longest optical length it may cover */
+  if (_exp_evaluator->isUsingInterpolation()) {
+    int num_values = _exp_evaluator->getMaxOpticalLength() *
+                     sqrt(1. / (8. * _exp_evaluator->getExpPrecision()));
+    num_bytes[EXP_TABLE_MEMORY] = 2 * _num_polar * (num_values + 1) * fp_size;
+  }
+}
+
+
+/**
+ * @brief Checks that the Solver's arrays fit in the memory budget before
+ *        they are allocated, and records them with the MemoryTracker.
+ * @details If the arrays would exceed the budget set with
+ *          MemoryTracker::setBudget(...), the options which reduce the
+ *          memory are reported with the memory each would save, and an
+ *          error is raised which names the first option that alone would
+ *          fit the budget. The options are ordered from the least to the
+ *          most effect on the accuracy of the solution.
+ * @param newton_krylov whether the arrays are for a Newton-Krylov
+ *        calculation
+ */
+void Solver::checkMemoryBudget(bool newton_krylov) {
+
+  MemoryTracker* tracker = MemoryTracker::Get();
+  size_t num_bytes[NUM_MEMORY_SUBSYSTEMS];
+  countMemoryUsage(num_bytes, newton_krylov);
+
+  size_t total = 0;
+  size_t recorded = 0;
+
+  for (int i=0; i < NUM_MEMORY_SUBSYSTEMS; i++) {
+    total += num_bytes[i];
+    recorded += _memory_usage[i];
+  }
+
+  log_printf(INFO, "The Solver requires %1.2E MB for fluxes and sources, "
+             "%1.2E MB for acceleration, %1.2E MB for CMFD and %1.2E MB for "
+             "the exponential table", num_bytes[SOLVER_MEMORY] / 1.E6,
+             num_bytes[ACCELERATION_MEMORY] / 1.E6,
+             num_bytes[CMFD_MEMORY] / 1.E6, num_bytes[EXP_TABLE_MEMORY] / 1.E6);
+
+  /* The memory in use without the arrays already recorded by this Solver */
+  size_t in_use = tracker->getTotalUsage() - recorded;
+  size_t budget = tracker->getBudget();
+
+  if (budget > 0 && in_use + total > budget) {
+
+    size_t excess = in_use + total - budget;
+    size_t fp_size = sizeof(FP_PRECISION);
+    size_t num_fluxes = size_t(_num_FSRs) * _num_groups;
+    size_t num_boundary_fluxes = size_t(2) * _tot_num_tracks * _num_polar *
+                                 _num_groups;
+    size_t boundary_bytes = 2 * num_boundary_fluxes * fp_size;
+    size_t history_bytes = (num_fluxes + num_boundary_fluxes) * fp_size;
+    std::vector< std::pair<std::string, size_t> > options;
+    std::stringstream option;
+
+    if (num_bytes[EXP_TABLE_MEMORY] > 0)
+      options.push_back(std::make_pair(std::string("use the exponential "
+        "intrinsic with useExponentialIntrinsic()"),
+        num_bytes[EXP_TABLE_MEMORY]));
+
+    /* Shorten or turn off the acceleration history */
+    if (newton_krylov) {
+      size_t vector_bytes = history_bytes / fp_size * sizeof(double);
+      int restart = _krylov_restart - (excess + vector_bytes - 1) /
+                    vector_bytes;
+      option.str("");
+      if (restart >= 1)
+        option << "use a Krylov restart of " << restart
+               << " with setKrylovRestart(" << restart << ")";
+      else
+        option << "use computeEigenvalue(...) instead of Newton-Krylov";
+      options.push_back(std::make_pair(option.str(), restart >= 1 ?
+        (_krylov_restart - restart) * vector_bytes :
+        num_bytes[ACCELERATION_MEMORY]));
+    }
+    else if (_anderson_depth > 0) {
+      int depth = _anderson_depth - (excess + 2 * history_bytes - 1) /
+                  (2 * history_bytes);
+      depth = std::max(depth, 0);
+      option.str("");
+      option << "use an Anderson depth of " << depth
+             << " with setAndersonDepth(" << depth << ")";
+      options.push_back(std::make_pair(option.str(), depth >= 1 ?
+        2 * (_anderson_depth - depth) * history_bytes :
+        num_bytes[ACCELERATION_MEMORY]));
+    }
+    else if (_chebyshev_order > 0)
+      options.push_back(std::make_pair(std::string("turn off Chebyshev "
+        "extrapolation with setChebyshevOrder(0)"),
+        num_bytes[ACCELERATION_MEMORY]));
+
+    /* Single precision halves each floating point array */
+    if (fp_size == sizeof(double)) {
+      size_t fp_bytes = boundary_bytes + (4 * num_fluxes + _num_FSRs) *
+                        fp_size + num_bytes[EXP_TABLE_MEMORY];
+      if (!newton_krylov)
+        fp_bytes += num_bytes[ACCELERATION_MEMORY];
+      options.push_back(std::make_pair(std::string("build OpenMOC in single "
+        "precision with --fp=single"), fp_bytes / 2));
+    }
+
+    if (num_bytes[CMFD_MEMORY] > 0)
+      options.push_back(std::make_pair(std::string("use a CMFD mesh with "
+        "half as many cells along x and y"), 3 * num_bytes[CMFD_MEMORY] / 4));
+
+    /* The boundary fluxes are proportional to the number of polar angles */
+    size_t polar_bytes = boundary_bytes / _num_polar;
+    int num_polar = _num_polar - (excess + polar_bytes - 1) / polar_bytes;
+    if (num_polar >= 1) {
+      option.str("");
+      option << "use " << num_polar << " polar angles with "
+             << "setPolarQuadrature(...)";
+      options.push_back(std::make_pair(option.str(),
+                                       (_num_polar - num_polar) * polar_bytes));
+    }
+
+    /* The Tracks and boundary fluxes are inversely proportional to the
+     * track spacing */
+    options.push_back(std::make_pair(std::string("double the track spacing "
+      "and regenerate the Tracks"),
+      (tracker->getUsage(TRACK_MEMORY) + boundary_bytes) / 2));
+
+    std::string suggestion;
+
+    for (size_t i=0; i < options.size(); i++) {
+      bool fits = options[i].second >= excess;
+      log_printf(WARNING, "To reduce memory, %s (saves %.1f MB%s)",
+                 options[i].first.c_str(), options[i].second / 1.E6,
+                 fits ? ", fits the budget" : "");
+      if (fits && suggestion.empty())
+        suggestion = options[i].first;
+    }
+
+    if (suggestion.empty())
+      suggestion = "combine the options above";
+
+    log_printf(ERROR, "The Solver requires %.1f MB in addition to the %.1f MB "
+               "in use, which exceeds the memory budget of %.1f MB by %.1f "
+               "MB. To fit the budget, %s.", total / 1.E6, in_use / 1.E6,
+               budget / 1.E6, excess / 1.E6, suggestion.c_str());
+  }
+
+  /* Replace the arrays recorded by this Solver with the new ones */
+  for (int i=0; i < NUM_MEMORY_SUBSYSTEMS; i++) {
+    tracker->release(memorySubsystem(i), _memory_usage[i]);
+    _memory_usage[i] = 0;
+  }
+
+  for (int i=0; i < NUM_MEMORY_SUBSYSTEMS; i++) {
+    tracker->allocate(memorySubsystem(i), num_bytes[i]);
+    _memory_usage[i] = num_bytes[i];
+  }
+}
+
+
+/**
+ * @brief Computes the scalar flux distribution by performing a series of 
+ *        transport sweeps.
+ * @details This is the main method exposed to the user through the Python
+ *          interface to compute the scalar flux distribution, e.g., for a 
+ *          fixed source calculation. This routine makes an initial guess for
+ *          scalar and boundary fluxes and performs transport sweep until 
+ *          convergence. 
+ *
+ *          By default, this method will perform a maximum of 1000 transport
+ *          sweeps with a 1E-5 threshold on the average FSR scalar flux. These
+ *          values may be freely modified by the user at runtime.
+ *
+ *          The only_fixed_source runtime parameter may be used to control
+ *          the type of source distribution used in the calculation. By 
+ *          default, this paramter is true and only the fixed sources specified
+ *          by the user will be considered. Alternatively, when the parameter
+ *          is false, the source will be computed as the scattering and fission
+ *          sources resulting from a previously computed flux distribution
+ *          (e.g., an eigenvalue calculation) in addition to any user-defined
+ *          fixed sources.
+ *
+ *          This method may be called by the user to compute the scalar flux 
  *          for a fixed source distribution from Python as follows:
  *
  * @code
@@ -710,8 +1506,11 @@ void Solver::computeFlux(int max_iters, bool only_fixed_source) {
 
   log_printf(NORMAL, "Computing the flux...");
 
+  ScopedTimer timer("computeFlux");
+
   /* Clear all timing data from a previous simulation run */
   clearTimerSplits();
+  initializeHistory();
 
   /* Start the timer to record the total time to converge the flux */
   _timer->startTimer();
@@ -719,8 +1518,10 @@ void Solver::computeFlux(int max_iters, bool only_fixed_source) {
   FP_PRECISION residual;
 
   /* Initialize data structures */
+  _timer->startPhase("initialize");
   initializePolarQuadrature();
   initializeExpEvaluator();
+  checkMemoryBudget();
 
   /* Initialize new flux arrays if a) the user requested the use of 
    * only fixed sources or b) no previous simulation was performed which
@@ -734,19 +1535,33 @@ void Solver::computeFlux(int max_iters, bool only_fixed_source) {
   initializeFSRs();
   countFissionableFSRs();
   zeroTrackFluxes();
+  _timer->stopPhase();
 
   /* Compute the sum of fixed, total and scattering sources */
+  _timer->startPhase("computeFSRSources");
   computeFSRSources();
+  _timer->stopPhase();
 
   /* Source iteration loop */
   for (int i=0; i < max_iters; i++) {
 
+    _timer->startPhase("transportSweep");
     transportSweep();
+    _sweep_time += _timer->stopPhase();
+    _num_sweeps++;
+
+    _timer->startPhase("addSourceToScalarFlux");
     addSourceToScalarFlux();
+    _timer->stopPhase();
+
+    _timer->startPhase("computeResidual");
     residual = computeResidual(SCALAR_FLUX);
+    _timer->stopPhase();
+
     storeFSRFluxes();
 
     log_printf(NORMAL, "Iteration %d:\tres = %1.3E", i, residual);
+    recordIteration(i, residual, 0., 0);
 
     /* Check for convergence of the fission source distribution */
     if (i > 1 && residual < _converge_thresh) {
@@ -813,8 +1628,11 @@ void Solver::computeSource(int max_iters, double k_eff, residualType res_type) {
 
   log_printf(NORMAL, "Computing the source...");
 
+  ScopedTimer timer("computeSource");
+
   /* Clear all timing data from a previous simulation run */
   clearTimerSplits();
+  initializeHistory();
 
   /* Start the timer to record the total time to converge the flux */
   _timer->startTimer();
@@ -823,8 +1641,10 @@ void Solver::computeSource(int max_iters, double k_eff, residualType res_type) {
   FP_PRECISION residual;
 
   /* Initialize data structures */
+  _timer->startPhase("initialize");
   initializePolarQuadrature();
   initializeExpEvaluator();
+  checkMemoryBudget();
   initializeFluxArrays();
   initializeSourceArrays();
   initializeFSRs();
@@ -832,17 +1652,36 @@ void Solver::computeSource(int max_iters, double k_eff, residualType res_type) {
   /* Guess unity scalar flux for each region */
   flattenFSRFluxes(1.0);
   zeroTrackFluxes();
+  initializeAnderson();
+  _timer->stopPhase();
 
   /* Source iteration loop */
   for (int i=0; i < max_iters; i++) {
 
+    _timer->startPhase("computeFSRSources");
     computeFSRSources();
+    _timer->stopPhase();
+
+    _timer->startPhase("transportSweep");
     transportSweep();
+    _sweep_time += _timer->stopPhase();
+    _num_sweeps++;
+
+    _timer->startPhase("addSourceToScalarFlux");
     addSourceToScalarFlux();
+    _timer->stopPhase();
+
+    _timer->startPhase("computeResidual");
     residual = computeResidual(res_type);
+    _timer->stopPhase();
+
     storeFSRFluxes();
 
+    if (_anderson_depth > 0)
+      accelerateAnderson(false);
+
     log_printf(NORMAL, "Iteration %d:\tres = %1.3E", i, residual);
+    recordIteration(i, residual, 0., 0);
 
     /* Check for convergence of the fission source distribution */
     if (i > 1 && residual < _converge_thresh) {
@@ -890,83 +1729,1317 @@ void Solver::computeEigenvalue(int max_iters, residualType res_type) {
     log_printf(ERROR, "The Solver is unable to compute the eigenvalue "
                "since it does not contain a TrackGenerator");
 
+  if (_anderson_depth > 0 && _chebyshev_order > 0)
+    log_printf(ERROR, "Unable to compute the eigenvalue with both Anderson "
+               "acceleration and Chebyshev extrapolation");
+
   log_printf(NORMAL, "Computing the eigenvalue...");
 
+  ScopedTimer timer("computeEigenvalue");
+
   /* Clear all timing data from a previous simulation run */
   clearTimerSplits();
+  initializeHistory();
 
   /* Start the timer to record the total time to converge the source */
   _timer->startTimer();
 
   FP_PRECISION residual;
+  std::vector<FP_PRECISION> residuals;
+  int start_iteration = initializeEigenvalue();
+  initializeAnderson();
+  initializeChebyshev();
+
+  /* Source iteration loop */
+  for (int i=start_iteration; i < max_iters; i++) {
+
+    residual = computeSourceIteration(i, res_type);
+    residuals.push_back(residual);
+
+    if (_anderson_depth > 0)
+      accelerateAnderson(true);
+    else if (_chebyshev_order > 0)
+      accelerateChebyshev();
+
+    /* Estimate the dominance ratio from the last few residuals */
+    if (_chebyshev_order == 0)
+      _dominance_ratio = residual_dominance_ratio(&residuals[0],
+                                                  residuals.size());
+
+    /* Check for convergence of the fission source distribution */
+    if (i > 1 && residual < _converge_thresh) {
+      log_printf(INFO, "Estimated dominance ratio = %f", _dominance_ratio);
+      _num_iterations = i;
+      _timer->stopTimer();
+      _timer->recordSplit("Total time");
+      return;
+    }
+
+    /* Write a checkpoint of the completed iterations */
+    if (_checkpoint_interval > 0 && (i+1) % _checkpoint_interval == 0) {
+      _num_iterations = i+1;
+      dumpCheckpoint(_checkpoint_filename.c_str());
+    }
+  }
+
+  log_printf(WARNING, "Unable to converge the source distribution");
+  log_printf(INFO, "Estimated dominance ratio = %f", _dominance_ratio);
+
+  _num_iterations = max_iters;
+  _timer->stopTimer();
+  _timer->recordSplit("Total time");
+}
+
+
+/**
+ * @brief Initializes the data structures and the initial guess for the
+ *        fluxes and eigenvalue for an eigenvalue calculation.
+ * @details The initial guess is a flat flux with \f$ k_{eff} = 1 \f$ unless
+ *          warm starts are used or a checkpoint has been read.
+ * @param newton_krylov whether the calculation uses Newton-Krylov
+ * @return the source iteration from which to start
+ */
+int Solver::initializeEigenvalue(bool newton_krylov) {
+
+  ScopedTimer timer("initializeEigenvalue");
+
+  /* Keep the fluxes from a previous calculation or a checkpoint */
+  bool warm_start = (_warm_start || _restart) && _scalar_flux != NULL &&
+                    _boundary_flux != NULL;
+  int start_iteration = _restart ? _start_iteration : 0;
+  _restart = false;
+  _start_iteration = 0;
 
   /* An initial guess for the eigenvalue */
-  _k_eff = 1.0;
+  if (!warm_start)
+    _k_eff = 1.0;
 
   /* Initialize data structures */
+  _timer->startPhase("initializePolarQuadrature");
   initializePolarQuadrature();
+  _timer->stopPhase();
+
+  _timer->startPhase("initializeExpEvaluator");
   initializeExpEvaluator();
-  initializeFluxArrays();
+  _timer->stopPhase();
+
+  checkMemoryBudget(newton_krylov);
+
+  if (!warm_start) {
+    _timer->startPhase("initializeFluxArrays");
+    initializeFluxArrays();
+    _timer->stopPhase();
+  }
+
+  _timer->startPhase("initializeSourceArrays");
   initializeSourceArrays();
+  _timer->stopPhase();
+
+  _timer->startPhase("initializeFSRs");
   initializeFSRs();
   countFissionableFSRs();
+  _timer->stopPhase();
 
-  if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn()) {
+    _timer->startPhase("initializeCmfd");
     initializeCmfd();
+    _timer->stopPhase();
+  }
 
   /* Set scalar flux to unity for each region */
-  flattenFSRFluxes(1.0);
-  zeroTrackFluxes();
+  if (!warm_start) {
+    flattenFSRFluxes(1.0);
+    zeroTrackFluxes();
+  }
+  else if (start_iteration > 0)
+    log_printf(NORMAL, "Resuming from iteration %d with k_eff = %f",
+               start_iteration, _k_eff);
+  else
+    log_printf(INFO, "Starting from the previous fluxes and k_eff = %f",
+               _k_eff);
+
+  return start_iteration;
+}
 
-  /* Source iteration loop */
-  for (int i=0; i < max_iters; i++) {
 
+/**
+ * @brief Performs one source iteration of the power method.
+ * @details The fluxes are normalized, the sources are updated with the
+ *          current fluxes and \f$ k_{eff} \f$, a transport sweep is
+ *          performed and \f$ k_{eff} \f$ is updated, with CMFD acceleration
+ *          if it is in use.
+ * @param iteration the index of the source iteration
+ * @param res_type the type of residual used for the convergence criterion
+ * @return the residual between this and the previous source iteration
+ */
+FP_PRECISION Solver::computeSourceIteration(int iteration,
+                                            residualType res_type) {
+
+  normalizeFluxes();
+
+  _timer->startPhase("computeFSRSources");
+  computeFSRSources();
+  _timer->stopPhase();
+
+  /* Record the hardware counts of the sweep summed over all threads */
+  bool record_counters = _timer->isRecordingHardwareCounters();
+  std::string sweep_path = _timer->getRunningPhasePath() + "/transportSweep";
+  long counters[NUM_HARDWARE_COUNTERS];
+
+  for (int c=0; c < NUM_HARDWARE_COUNTERS && record_counters; c++)
+    counters[c] = _timer->getPhaseCounter(sweep_path.c_str(),
+                                          hardwareCounter(c));
+
+  _timer->startPhase("transportSweep");
+  transportSweep();
+  _sweep_time += _timer->stopPhase();
+  _num_sweeps++;
+
+  for (int c=0; c < NUM_HARDWARE_COUNTERS && record_counters; c++)
+    _sweep_counters.push_back(_timer->getPhaseCounter(sweep_path.c_str(),
+                              hardwareCounter(c)) - counters[c]);
+
+  _timer->startPhase("addSourceToScalarFlux");
+  addSourceToScalarFlux();
+  _timer->stopPhase();
+
+  _timer->startPhase("computeResidual");
+  FP_PRECISION residual = computeResidual(res_type);
+  _timer->stopPhase();
+
+  storeFSRFluxes();
+
+  /* Solve CMFD diffusion problem and update MOC flux */
+  _timer->startPhase("computeKeff");
+
+  FP_PRECISION cmfd_k_eff = 0.;
+  int num_cmfd_iterations = 0;
+
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn()){
+    cmfd_k_eff = _cmfd->computeKeff(iteration);
+    num_cmfd_iterations = _cmfd->getNumIterations();
+    _k_eff = cmfd_k_eff;
+    _cmfd->updateBoundaryFlux(_tracks, _boundary_flux, _tot_num_tracks);
+  }
+  else
+    computeKeff();
+
+  _timer->stopPhase();
+
+  recordIteration(iteration, residual, cmfd_k_eff, num_cmfd_iterations);
+
+  log_printf(NORMAL, "Iteration %d:\tk_eff = %1.6f"
+             "\tres = %1.3E", iteration, _k_eff, residual);
+
+  return residual;
+}
+
+
+/**
+ * @brief Allocates and resets the history for Anderson acceleration.
+ * @details The iterates mixed by Anderson acceleration are the scalar fluxes
+ *          for each FSR and energy group followed by the boundary angular
+ *          fluxes for each Track. The history holds 2*depth+3 iterates.
+ */
+void Solver::initializeAnderson() {
+
+  _anderson_num_iterations = 0;
+  _anderson_num_stored = 0;
+  _anderson_index = 0;
+  _anderson_residual = 0.;
+
+  if (_anderson_x != NULL) {
+    delete [] _anderson_x;
+    delete [] _anderson_g;
+    delete [] _anderson_f;
+    delete [] _anderson_delta_g;
+    delete [] _anderson_delta_f;
+    _anderson_x = NULL;
+  }
+
+  if (_anderson_depth == 0)
+    return;
+
+  if (_scalar_flux == NULL || _boundary_flux == NULL)
+    log_printf(ERROR, "Unable to use Anderson acceleration since this "
+               "Solver does not store its fluxes on the host");
+
+  long size = _num_FSRs * _num_groups +
+              2 * long(_tot_num_tracks) * _polar_times_groups;
+
+  try {
+    _anderson_x = new FP_PRECISION[size];
+    _anderson_g = new FP_PRECISION[size];
+    _anderson_f = new FP_PRECISION[size];
+    _anderson_delta_g = new FP_PRECISION[_anderson_depth * size];
+    _anderson_delta_f = new FP_PRECISION[_anderson_depth * size];
+  }
+  catch (std::exception &e) {
+    log_printf(ERROR, "Could not allocate memory for Anderson acceleration");
+  }
+
+  log_printf(INFO, "Anderson acceleration history requires %1.2E MB",
+             (2 * _anderson_depth + 3) * size * sizeof(FP_PRECISION) / 1.E6);
+}
+
+
+/**
+ * @brief Replaces the fluxes from the last source iteration with their
+ *        Anderson mixture with the previous iterates.
+ * @details For the source iteration \f$ x_{k+1} = G(x_k) \f$ with residual
+ *          \f$ f_k = G(x_k) - x_k \f$, the new iterate is
+ *          \f$ x_{k+1} = G(x_k) - \Delta G \gamma \f$, where the columns
+ *          of \f$ \Delta G \f$ and \f$ \Delta F \f$ are the differences
+ *          between successive unaccelerated iterates and residuals and
+ *          \f$ \gamma \f$ minimizes \f$ \| f_k - \Delta F \gamma \| \f$.
+ *          The iterates include the boundary angular fluxes so that the
+ *          next transport sweep starts from a consistent state.
+ *
+ *          The history is discarded and the unaccelerated iterate is used
+ *          if the residual grows to twice its smallest value since the last
+ *          restart, the least squares problem is singular or the mixture has
+ *          negative fluxes, so that the iteration falls back to the plain
+ *          source iteration when the acceleration stagnates.
+ * @param normalize whether to normalize the fluxes to the total fission
+ *        source before mixing (true for eigenvalue calculations)
+ */
+void Solver::accelerateAnderson(bool normalize) {
+
+  long num_fluxes = _num_FSRs * _num_groups;
+  long size = num_fluxes + 2 * long(_tot_num_tracks) * _polar_times_groups;
+  size_t num_bytes = num_fluxes * sizeof(FP_PRECISION);
+  size_t num_boundary_bytes = (size - num_fluxes) * sizeof(FP_PRECISION);
+
+  if (normalize)
     normalizeFluxes();
-    computeFSRSources();
-    transportSweep();
-    addSourceToScalarFlux();
-    residual = computeResidual(res_type);
-    storeFSRFluxes();
 
-    /* Solve CMFD diffusion problem and update MOC flux */
-    if (_cmfd != NULL && _cmfd->isFluxUpdateOn()){
-      _k_eff = _cmfd->computeKeff(i);
-      _cmfd->updateBoundaryFlux(_tracks, _boundary_flux, _tot_num_tracks);
+  /* The first iterate has no residual */
+  if (_anderson_num_iterations++ == 0) {
+    memcpy(_anderson_x, _scalar_flux, num_bytes);
+    memcpy(&_anderson_x[num_fluxes], _boundary_flux, num_boundary_bytes);
+    memcpy(_anderson_g, _anderson_x, size * sizeof(FP_PRECISION));
+    memset(_anderson_f, 0, size * sizeof(FP_PRECISION));
+    return;
+  }
+
+  /* Load the new iterate into the next history slot, which is only kept
+   * if there is a previous residual to difference with */
+  bool store = (_anderson_num_iterations > 2);
+  FP_PRECISION* delta_g = &_anderson_delta_g[_anderson_index * size];
+  FP_PRECISION* delta_f = &_anderson_delta_f[_anderson_index * size];
+  memcpy(delta_g, _scalar_flux, num_bytes);
+  memcpy(&delta_g[num_fluxes], _boundary_flux, num_boundary_bytes);
+
+  double residual = 0.;
+
+  #pragma omp parallel for reduction(+:residual) schedule(guided)
+  for (long i=0; i < size; i++) {
+    FP_PRECISION g = delta_g[i];
+    FP_PRECISION f = g - _anderson_x[i];
+    delta_g[i] = g - _anderson_g[i];
+    delta_f[i] = f - _anderson_f[i];
+    _anderson_g[i] = g;
+    _anderson_f[i] = f;
+    residual += double(f) * f;
+  }
+
+  residual = sqrt(residual);
+
+  if (store) {
+    _anderson_index = (_anderson_index + 1) % _anderson_depth;
+    _anderson_num_stored = std::min(_anderson_num_stored + 1,
+                                    _anderson_depth);
+  }
+
+  /* Restart from the unaccelerated iterate if the residual stagnates */
+  bool restart = (store && residual > 2. * _anderson_residual);
+
+  if (!store || residual < _anderson_residual)
+    _anderson_residual = residual;
+
+  /* Solve the normal equations for the mixing coefficients */
+  int n = _anderson_num_stored;
+  std::vector<double> A(n*n), gamma(n);
+
+  for (int j=0; j < n && !restart; j++) {
+    FP_PRECISION* delta_f_j = &_anderson_delta_f[j * size];
+    gamma[j] = vector_dot(delta_f_j, _anderson_f, size);
+
+    for (int l=0; l <= j; l++) {
+      A[j*n+l] = vector_dot(delta_f_j, &_anderson_delta_f[l * size], size);
+      A[l*n+j] = A[j*n+l];
     }
-    else
-      computeKeff();
+  }
 
-    log_printf(NORMAL, "Iteration %d:\tk_eff = %1.6f"
-               "\tres = %1.3E", i, _k_eff, residual);
+  if (!restart && n > 0)
+    restart = !dense_solve(&A[0], &gamma[0], n);
+
+  /* Mix the previous iterates */
+  int num_negative = 0;
+
+  if (!restart && n > 0) {
+    #pragma omp parallel for reduction(+:num_negative) schedule(guided)
+    for (long i=0; i < size; i++) {
+      double x = _anderson_g[i];
+      for (int j=0; j < n; j++)
+        x -= gamma[j] * _anderson_delta_g[j * size + i];
+      _anderson_x[i] = x;
+      if (x < 0.)
+        num_negative++;
+    }
 
-    /* Check for convergence of the fission source distribution */
-    if (i > 1 && residual < _converge_thresh) {
-      _num_iterations = i;
-      _timer->stopTimer();
-      _timer->recordSplit("Total time");
-      return;
+    restart = (num_negative > 0);
+  }
+
+  if (restart) {
+    log_printf(DEBUG, "Restarting Anderson acceleration with residual %1.3E",
+               residual);
+    _anderson_num_stored = 0;
+    _anderson_index = 0;
+    _anderson_residual = residual;
+  }
+
+  if (restart || n == 0)
+    memcpy(_anderson_x, _anderson_g, size * sizeof(FP_PRECISION));
+  else {
+    memcpy(_scalar_flux, _anderson_x, num_bytes);
+    memcpy(_boundary_flux, &_anderson_x[num_fluxes], num_boundary_bytes);
+  }
+}
+
+
+/**
+ * @brief Allocates and resets the previous iterates for Chebyshev
+ *        extrapolation.
+ * @details As for Anderson acceleration, the iterates are the scalar fluxes
+ *          for each FSR and energy group followed by the boundary angular
+ *          fluxes for each Track.
+ */
+void Solver::initializeChebyshev() {
+
+  _chebyshev_step = 0;
+  _chebyshev_num_iterations = 0;
+  _chebyshev_num_power_iterations = 0;
+  _chebyshev_cycle_residual = 0.;
+  _chebyshev_residual = 0.;
+  _dominance_ratio = 0.;
+
+  if (_chebyshev_x != NULL) {
+    delete [] _chebyshev_x;
+    delete [] _chebyshev_x_old;
+    _chebyshev_x = NULL;
+  }
+
+  if (_chebyshev_order == 0)
+    return;
+
+  if (_scalar_flux == NULL || _boundary_flux == NULL)
+    log_printf(ERROR, "Unable to use Chebyshev extrapolation since this "
+               "Solver does not store its fluxes on the host");
+
+  long size = _num_FSRs * _num_groups +
+              2 * long(_tot_num_tracks) * _polar_times_groups;
+
+  try {
+    _chebyshev_x = new FP_PRECISION[size];
+    _chebyshev_x_old = new FP_PRECISION[size];
+  }
+  catch (std::exception &e) {
+    log_printf(ERROR, "Could not allocate memory for Chebyshev extrapolation");
+  }
+}
+
+
+/**
+ * @brief Computes the squared norm of the difference between two arrays.
+ * @param x the first array
+ * @param y the second array
+ * @param size the number of values in each array
+ * @return the squared norm of the difference
+ */
+static double difference_norm_squared(FP_PRECISION* x, FP_PRECISION* y,
+                                      long size) {
+
+  double norm = 0.;
+
+  #pragma omp parallel for reduction(+:norm) schedule(guided)
+  for (long i=0; i < size; i++)
+    norm += double(x[i] - y[i]) * (x[i] - y[i]);
+
+  return norm;
+}
+
+
+/**
+ * @brief Replaces the fluxes from the last source iteration with their
+ *        Chebyshev extrapolation.
+ * @details Each iterate is extrapolated as \f$ x_{n+1} = x_n + \alpha_p
+ *          (G(x_n) - x_n) + \beta_p (x_n - x_{n-1}) \f$ with the coefficients
+ *          of the p-th step of a Chebyshev cycle for the estimated dominance
+ *          ratio, unless chebyshev_next_step(...) calls for a power
+ *          iteration to estimate the dominance ratio after a restart.
+ *          Extrapolation is also restarted if the extrapolated fluxes are
+ *          negative.
+ */
+void Solver::accelerateChebyshev() {
+
+  long num_fluxes = _num_FSRs * _num_groups;
+  long num_boundary_fluxes = 2 * long(_tot_num_tracks) * _polar_times_groups;
+  long size = num_fluxes + num_boundary_fluxes;
+  size_t num_bytes = num_fluxes * sizeof(FP_PRECISION);
+  size_t num_boundary_bytes = num_boundary_fluxes * sizeof(FP_PRECISION);
+
+  normalizeFluxes();
+
+  /* The first iterate has no residual */
+  if (_chebyshev_num_iterations++ == 0) {
+    memcpy(_chebyshev_x, _scalar_flux, num_bytes);
+    memcpy(&_chebyshev_x[num_fluxes], _boundary_flux, num_boundary_bytes);
+    return;
+  }
+
+  double residual = sqrt(
+      difference_norm_squared(_scalar_flux, _chebyshev_x, num_fluxes) +
+      difference_norm_squared(_boundary_flux, &_chebyshev_x[num_fluxes],
+                              num_boundary_fluxes));
+  int last_step = _chebyshev_step;
+  _chebyshev_step = chebyshev_next_step(last_step, _chebyshev_order,
+                                        &_chebyshev_num_power_iterations,
+                                        residual, &_chebyshev_residual,
+                                        &_chebyshev_cycle_residual,
+                                        &_dominance_ratio);
+  bool restart = (last_step > 0 && _chebyshev_step == 0);
+
+  /* Extrapolate into the oldest iterate */
+  int num_negative = 0;
+
+  if (_chebyshev_step > 0) {
+
+    double alpha, beta;
+    chebyshev_coefficients(_chebyshev_step, _dominance_ratio, &alpha, &beta);
+
+    #pragma omp parallel for reduction(+:num_negative) schedule(guided)
+    for (long i=0; i < size; i++) {
+      FP_PRECISION g = (i < num_fluxes) ? _scalar_flux[i] :
+                       _boundary_flux[i - num_fluxes];
+      FP_PRECISION x = _chebyshev_x[i];
+      _chebyshev_x_old[i] = x + alpha * (g - x) +
+                            beta * (x - _chebyshev_x_old[i]);
+      if (_chebyshev_x_old[i] < 0.)
+        num_negative++;
+    }
+
+    if (num_negative > 0) {
+      restart = true;
+      _chebyshev_step = 0;
+      _chebyshev_num_power_iterations = 0;
     }
   }
 
-  log_printf(WARNING, "Unable to converge the source distribution");
+  if (restart)
+    log_printf(DEBUG, "Restarting Chebyshev extrapolation with residual "
+               "%1.3E", residual);
 
-  _num_iterations = max_iters;
+  /* Keep the unaccelerated iterate for power iterations */
+  if (_chebyshev_step == 0) {
+    memcpy(_chebyshev_x_old, _scalar_flux, num_bytes);
+    memcpy(&_chebyshev_x_old[num_fluxes], _boundary_flux, num_boundary_bytes);
+  }
+  else {
+    memcpy(_scalar_flux, _chebyshev_x_old, num_bytes);
+    memcpy(_boundary_flux, &_chebyshev_x_old[num_fluxes], num_boundary_bytes);
+  }
+
+  std::swap(_chebyshev_x, _chebyshev_x_old);
+}
+
+
+/**
+ * @brief Computes keff with a Jacobian-free Newton-Krylov (JFNK) method.
+ * @details One transport sweep is treated as the application of a nonlinear
+ *          operator to the state \f$ x = (\Phi, \psi_b, k_{eff}) \f$ of
+ *          FSR scalar fluxes, Track boundary angular fluxes and eigenvalue.
+ *          The eigenvalue problem is solved as the root of the residual
+ *          \f$ F(x) = (\Phi - \Phi', \psi_b - \psi_b',
+ *          1 - \sum \nu\Sigma_f\Phi V) \f$ where \f$ \Phi' \f$ and
+ *          \f$ \psi_b' \f$ are the fluxes after one sweep, and the last
+ *          component normalizes the fission source as in the power method.
+ *
+ *          A few power iterations first give Newton's method a good initial
+ *          guess. Each Newton step is then found with restarted GMRES, in
+ *          which each Jacobian-vector product is a finite difference of the
+ *          residual that costs one transport sweep. A step which increases
+ *          the residual is halved up to three times, and is replaced by a
+ *          power iteration if none of the shorter steps reduces the
+ *          residual. The restart length,
+ *          GMRES tolerance and number of power iterations may be set with
+ *          Solver::setKrylovRestart(...), Solver::setKrylovTolerance(...)
+ *          and Solver::setKrylovPowerIterations(...). The convergence
+ *          criterion is the same as for Solver::computeEigenvalue(...), and
+ *          the number of iterations reported by Solver::getNumIterations()
+ *          is the total number of transport sweeps so the two methods may be
+ *          compared directly:
+ *
+ * @code
+ *          solver.setKrylovRestart(30)
+ *          solver.computeEigenvalueNewtonKrylov(max_iters=1000)
+ *          print solver.getNumIterations()
+ * @endcode
+ *
+ *          GMRES stores restart+1 vectors as large as the boundary fluxes.
+ *          CMFD acceleration is not used by this method.
+ *
+ * @param max_iters the maximum number of transport sweeps to allow
+ * @param res_type the type of residual used for the convergence criterion
+ */
+void Solver::computeEigenvalueNewtonKrylov(int max_iters,
+                                           residualType res_type) {
+
+  if (_track_generator == NULL)
+    log_printf(ERROR, "The Solver is unable to compute the eigenvalue "
+               "since it does not contain a TrackGenerator");
+
+  log_printf(NORMAL, "Computing the eigenvalue with Newton-Krylov...");
+
+  ScopedTimer timer("computeEigenvalueNewtonKrylov");
+
+  /* Clear all timing data from a previous simulation run */
+  clearTimerSplits();
+  initializeHistory();
+
+  /* Start the timer to record the total time to converge the source */
+  _timer->startTimer();
+
+  /* Turn off CMFD acceleration, which would change the sweep operator */
+  bool cmfd_flux_update = (_cmfd != NULL && _cmfd->isFluxUpdateOn());
+  if (cmfd_flux_update) {
+    log_printf(WARNING, "CMFD acceleration is not used with Newton-Krylov");
+    _cmfd->setFluxUpdateOn(false);
+  }
+
+  FP_PRECISION residual = 0.;
+  int num_sweeps = initializeEigenvalue(true);
+
+  if (_scalar_flux == NULL || _boundary_flux == NULL)
+    log_printf(ERROR, "Unable to use Newton-Krylov since this Solver does "
+               "not store its fluxes on the host");
+
+  /* Power iterations for an initial guess */
+  int num_power_iters = std::min(num_sweeps + _krylov_power_iterations,
+                                 max_iters);
+  for (; num_sweeps < num_power_iters; num_sweeps++)
+    residual = computeSourceIteration(num_sweeps, res_type);
+
+  /* The state and residual vectors */
+  size_t num_fluxes = size_t(_num_FSRs) * _num_groups;
+  size_t size = num_fluxes + size_t(2) * _tot_num_tracks *
+                _polar_times_groups + 1;
+  std::vector<double> x(size), F(size), dx(size), x_new(size), F_new(size);
+
+  normalizeFluxes();
+  getNewtonState(&x[0], size);
+
+  bool converged = false;
+  int num_newton_iters = 0;
+
+  if (num_sweeps < max_iters) {
+    computeNewtonResidual(&x[0], &F[0], size);
+    residual = computeResidual(res_type);
+    num_sweeps++;
+    converged = (num_sweeps > 2 && residual < _converge_thresh);
+  }
+
+  /* Newton iterations */
+  while (!converged && num_sweeps < max_iters) {
+
+    double F_norm = vector_norm(&F[0], size);
+
+    /* Solve J dx = -F for the Newton step */
+    num_sweeps += solveNewtonStep(&x[0], &F[0], &dx[0], size,
+                                  max_iters - num_sweeps - 1);
+
+    /* Take the full Newton step, or a fraction of it if the residual grows */
+    double step = 1.;
+    double F_new_norm;
+
+    do {
+      #pragma omp parallel for schedule(guided)
+      for (long i=0; i < long(size); i++)
+        x_new[i] = x[i] + step * dx[i];
+
+      computeNewtonResidual(&x_new[0], &F_new[0], size);
+      F_new_norm = vector_norm(&F_new[0], size);
+      num_sweeps++;
+      step *= 0.5;
+    } while (F_new_norm > F_norm && step > 0.1 && num_sweeps < max_iters);
+
+    /* Fall back to a power iteration if no step reduces the residual */
+    if (F_new_norm > F_norm) {
+
+      log_printf(INFO, "Rejecting Newton iteration %d since no step along "
+                 "it reduces the residual", num_newton_iters + 1);
+
+      setNewtonState(&x[0], size);
+      if (num_sweeps + 2 > max_iters)
+        break;
+
+      storeFSRFluxes();
+      computeSourceIteration(num_sweeps, res_type);
+      normalizeFluxes();
+      getNewtonState(&x_new[0], size);
+      computeNewtonResidual(&x_new[0], &F_new[0], size);
+      num_sweeps += 2;
+    }
+
+    x.swap(x_new);
+    F.swap(F_new);
+    num_newton_iters++;
+
+    residual = computeResidual(res_type);
+    converged = (residual < _converge_thresh);
+
+    log_printf(NORMAL, "Newton iteration %d (%d sweeps):\tk_eff = %1.6f"
+               "\tres = %1.3E", num_newton_iters, num_sweeps, _k_eff,
+               residual);
+    recordIteration(num_sweeps-1, residual, 0., 0);
+  }
+
+  if (cmfd_flux_update)
+    _cmfd->setFluxUpdateOn(true);
+
+  /* The Newton-Krylov vectors are deleted on return */
+  MemoryTracker::Get()->update(ACCELERATION_MEMORY,
+                               _memory_usage[ACCELERATION_MEMORY], 0);
+
+  if (!converged)
+    log_printf(WARNING, "Unable to converge the source distribution");
+
+  _num_iterations = std::min(num_sweeps, max_iters);
   _timer->stopTimer();
   _timer->recordSplit("Total time");
 }
 
 
+/**
+ * @brief Copies the fluxes and eigenvalue into a Newton-Krylov state vector.
+ * @param x an array to store the state vector of scalar fluxes, boundary
+ *        fluxes and k_eff
+ * @param size the size of the state vector
+ */
+void Solver::getNewtonState(double* x, size_t size) {
+
+  long num_fluxes = long(_num_FSRs) * _num_groups;
+
+  #pragma omp parallel for schedule(guided)
+  for (long i=0; i < num_fluxes; i++)
+    x[i] = _scalar_flux[i];
+
+  #pragma omp parallel for schedule(guided)
+  for (long i=num_fluxes; i < long(size)-1; i++)
+    x[i] = _boundary_flux[i-num_fluxes];
+
+  x[size-1] = _k_eff;
+}
+
+
+/**
+ * @brief Sets the fluxes and eigenvalue from a Newton-Krylov state vector.
+ * @param x the state vector of scalar fluxes, boundary fluxes and k_eff
+ * @param size the size of the state vector
+ */
+void Solver::setNewtonState(double* x, size_t size) {
+
+  long num_fluxes = long(_num_FSRs) * _num_groups;
+
+  #pragma omp parallel for schedule(guided)
+  for (long i=0; i < num_fluxes; i++)
+    _scalar_flux[i] = x[i];
+
+  #pragma omp parallel for schedule(guided)
+  for (long i=num_fluxes; i < long(size)-1; i++)
+    _boundary_flux[i-num_fluxes] = x[i];
+
+  _k_eff = x[size-1];
+}
+
+
+/**
+ * @brief Computes the Newton-Krylov residual for a state vector.
+ * @details The fluxes and eigenvalue are set from the state vector, which
+ *          are then updated by one transport sweep. The state's scalar flux
+ *          is stored as the old scalar flux so that the residual between the
+ *          state and the swept fluxes may then be found with
+ *          computeResidual(...).
+ * @param x the state vector of scalar fluxes, boundary fluxes and k_eff
+ * @param F an array to store the residual
+ * @param size the size of the state vector
+ */
+void Solver::computeNewtonResidual(double* x, double* F, size_t size) {
+
+  long num_fluxes = long(_num_FSRs) * _num_groups;
+
+  setNewtonState(x, size);
+
+  /* Sweep the fluxes */
+  storeFSRFluxes();
+
+  _timer->startPhase("computeFSRSources");
+  computeFSRSources();
+  _timer->stopPhase();
+
+  _timer->startPhase("transportSweep");
+  transportSweep();
+  _sweep_time += _timer->stopPhase();
+  _num_sweeps++;
+
+  _timer->startPhase("addSourceToScalarFlux");
+  addSourceToScalarFlux();
+  _timer->stopPhase();
+
+  /* Compute the total fission source of the state's scalar flux */
+  double fission_source = 0.;
+
+  #pragma omp parallel for reduction(+:fission_source) schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    FP_PRECISION* nu_sigma_f = _FSR_materials[r]->getNuSigmaF();
+    for (int e=0; e < _num_groups; e++)
+      fission_source += nu_sigma_f[e] * x[r*_num_groups+e] * _FSR_volumes[r];
+  }
+
+  #pragma omp parallel for schedule(guided)
+  for (long i=0; i < num_fluxes; i++)
+    F[i] = x[i] - _scalar_flux[i];
+
+  #pragma omp parallel for schedule(guided)
+  for (long i=num_fluxes; i < long(size)-1; i++)
+    F[i] = x[i] - _boundary_flux[i-num_fluxes];
+
+  F[size-1] = 1. - fission_source;
+}
+
+
+/**
+ * @brief Finds a Newton step with restarted GMRES.
+ * @details Solves \f$ J \Delta x = -F \f$ until the GMRES residual is
+ *          less than the Krylov tolerance times the norm of F, where each
+ *          product of the Jacobian with a vector is approximated by a
+ *          forward finite difference of the Newton-Krylov residual.
+ * @param x the current state vector
+ * @param F the Newton-Krylov residual of the current state
+ * @param dx an array to store the Newton step
+ * @param size the size of the state vector
+ * @param max_sweeps the maximum number of transport sweeps to use
+ * @return the number of transport sweeps used
+ */
+int Solver::solveNewtonStep(double* x, double* F, double* dx, size_t size,
+                            int max_sweeps) {
+
+  int m = _krylov_restart;
+  int num_sweeps = 0;
+
+  double F_norm = vector_norm(F, size);
+  double x_norm = vector_norm(x, size);
+  double tolerance = _krylov_tolerance * F_norm;
+
+  /* The finite difference step relative to the precision of the sweep */
+  double epsilon = sqrt(std::numeric_limits<FP_PRECISION>::epsilon()) *
+                   (1. + x_norm);
+
+  /* The Krylov basis, Hessenberg matrix and Givens rotations */
+  std::vector< std::vector<double> > V(m+1, std::vector<double>(size));
+  std::vector<double> H((m+1)*m), cs(m), sn(m), g(m+1), y(m);
+  std::vector<double> x_eps(size), F_eps(size), r(size);
+
+  /* The initial GMRES residual is -F since the initial guess is zero */
+  std::fill(dx, dx+size, 0.);
+
+  #pragma omp parallel for schedule(guided)
+  for (long i=0; i < long(size); i++)
+    r[i] = -F[i];
+
+  double beta = F_norm;
+
+  while (beta > tolerance && num_sweeps < max_sweeps) {
+
+    #pragma omp parallel for schedule(guided)
+    for (long i=0; i < long(size); i++)
+      V[0][i] = r[i] / beta;
+
+    std::fill(g.begin(), g.end(), 0.);
+    g[0] = beta;
+    int k = 0;
+
+    /* Build the Krylov basis with modified Gram-Schmidt */
+    for (; k < m && num_sweeps < max_sweeps; k++) {
+
+      /* Approximate J v_k with a finite difference */
+      #pragma omp parallel for schedule(guided)
+      for (long i=0; i < long(size); i++)
+        x_eps[i] = x[i] + epsilon * V[k][i];
+
+      computeNewtonResidual(&x_eps[0], &F_eps[0], size);
+      num_sweeps++;
+
+      #pragma omp parallel for schedule(guided)
+      for (long i=0; i < long(size); i++)
+        V[k+1][i] = (F_eps[i] - F[i]) / epsilon;
+
+      for (int j=0; j <= k; j++) {
+        double h = vector_dot(&V[k+1][0], &V[j][0], size);
+        H[j*m+k] = h;
+
+        #pragma omp parallel for schedule(guided)
+        for (long i=0; i < long(size); i++)
+          V[k+1][i] -= h * V[j][i];
+      }
+
+      double h_next = vector_norm(&V[k+1][0], size);
+
+      if (h_next > 0.) {
+        #pragma omp parallel for schedule(guided)
+        for (long i=0; i < long(size); i++)
+          V[k+1][i] /= h_next;
+      }
+
+      /* Apply the previous Givens rotations to the new column */
+      for (int j=0; j < k; j++) {
+        double h = cs[j] * H[j*m+k] + sn[j] * H[(j+1)*m+k];
+        H[(j+1)*m+k] = -sn[j] * H[j*m+k] + cs[j] * H[(j+1)*m+k];
+        H[j*m+k] = h;
+      }
+
+      /* Compute a new Givens rotation to zero the subdiagonal */
+      double denom = sqrt(H[k*m+k] * H[k*m+k] + h_next * h_next);
+      cs[k] = (denom > 0.) ? H[k*m+k] / denom : 1.;
+      sn[k] = (denom > 0.) ? h_next / denom : 0.;
+      H[k*m+k] = denom;
+      H[(k+1)*m+k] = 0.;
+      g[k+1] = -sn[k] * g[k];
+      g[k] = cs[k] * g[k];
+
+      log_printf(DEBUG, "GMRES iteration %d: residual = %1.3E",
+                 k, fabs(g[k+1]));
+
+      if (fabs(g[k+1]) < tolerance || h_next == 0.) {
+        k++;
+        break;
+      }
+    }
+
+    /* Solve the upper triangular system and update the step */
+    for (int i=k-1; i >= 0; i--) {
+      y[i] = g[i];
+      for (int j=i+1; j < k; j++)
+        y[i] -= H[i*m+j] * y[j];
+      y[i] /= H[i*m+i];
+    }
+
+    for (int j=0; j < k; j++) {
+      #pragma omp parallel for schedule(guided)
+      for (long i=0; i < long(size); i++)
+        dx[i] += y[j] * V[j][i];
+    }
+
+    beta = fabs(g[k]);
+
+    /* Recompute the GMRES residual -F - J dx before a restart */
+    if (beta > tolerance && num_sweeps < max_sweeps) {
+
+      double dx_norm = vector_norm(dx, size);
+
+      #pragma omp parallel for schedule(guided)
+      for (long i=0; i < long(size); i++)
+        x_eps[i] = x[i] + epsilon * dx[i] / dx_norm;
+
+      computeNewtonResidual(&x_eps[0], &F_eps[0], size);
+      num_sweeps++;
+
+      #pragma omp parallel for schedule(guided)
+      for (long i=0; i < long(size); i++)
+        r[i] = -F[i] - dx_norm * (F_eps[i] - F[i]) / epsilon;
+
+      beta = vector_norm(&r[0], size);
+    }
+  }
+
+  return num_sweeps;
+}
+
+
+/**
+ * @brief Writes the state of an eigenvalue calculation to a binary file.
+ * @details The checkpoint contains the FSR scalar fluxes from this and the
+ *          previous source iteration, the Track boundary angular fluxes,
+ *          \f$ k_{eff} \f$, the number of completed source iterations and
+ *          the CMFD surface diffusion coefficient corrections.
+ *          The file is first written under a temporary name and then renamed
+ *          so that an interrupted write never replaces a valid checkpoint.
+ * @param filename the name of the checkpoint file
+ */
+void Solver::dumpCheckpoint(const char* filename) {
+
+  if (_scalar_flux == NULL || _boundary_flux == NULL)
+    log_printf(ERROR, "Unable to dump a checkpoint to %s since the fluxes "
+               "have not yet been computed", filename);
+
+  log_printf(INFO, "Dumping a checkpoint to %s...", filename);
+
+  int num_groups = _geometry->getNumEnergyGroups();
+  int num_polar_times_groups = _num_polar * num_groups;
+  uint64_t num_scalar_fluxes = uint64_t(_num_FSRs) * num_groups;
+  uint64_t num_boundary_fluxes = uint64_t(_tot_num_tracks) * 2 *
+                                 num_polar_times_groups;
+
+  checkpoint_file_header header;
+  memset(&header, 0, sizeof(header));
+  strncpy(header._magic, CHECKPOINT_FILE_MAGIC, sizeof(header._magic));
+  header._byte_order = CHECKPOINT_FILE_BYTE_ORDER;
+  header._version = CHECKPOINT_FILE_VERSION;
+  header._precision = sizeof(FP_PRECISION);
+  header._num_FSRs = _num_FSRs;
+  header._num_groups = num_groups;
+  header._num_polar = _num_polar;
+  header._num_tracks = _tot_num_tracks;
+  header._num_iterations = _num_iterations;
+  header._k_eff = _k_eff;
+  header._geometry_hash = _geometry->getStructuralHash();
+  header._material_hash = _geometry->getMaterialHash();
+
+  /* Copy the fluxes without any padding energy groups */
+  std::vector<FP_PRECISION> scalar_flux(num_scalar_fluxes);
+  std::vector<FP_PRECISION> old_scalar_flux(num_scalar_fluxes);
+  std::vector<FP_PRECISION> packed_boundary_flux;
+  FP_PRECISION* boundary_flux = _boundary_flux;
+
+  #pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int e=0; e < num_groups; e++) {
+      scalar_flux[r*num_groups+e] = _scalar_flux(r,e);
+      old_scalar_flux[r*num_groups+e] = _old_scalar_flux(r,e);
+    }
+  }
+
+  if (num_groups != _num_groups) {
+    packed_boundary_flux.resize(num_boundary_fluxes);
+    boundary_flux = &packed_boundary_flux[0];
+
+    #pragma omp parallel for schedule(guided)
+    for (int i=0; i < _tot_num_tracks; i++) {
+      for (int j=0; j < 2; j++) {
+        for (int p=0; p < _num_polar; p++) {
+          for (int e=0; e < num_groups; e++)
+            boundary_flux[(uint64_t(i)*2+j)*num_polar_times_groups +
+                          p*num_groups + e] = _boundary_flux(i,j,p,e);
+        }
+      }
+    }
+  }
+
+  std::vector<FP_PRECISION> dif_tildes;
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn()) {
+    header._num_dif_tildes = _cmfd->getNumDifTildes();
+    dif_tildes.resize(header._num_dif_tildes);
+    _cmfd->getDifTildes(&dif_tildes[0], header._num_dif_tildes);
+  }
+
+  size_t sizes[4] = {num_scalar_fluxes * sizeof(FP_PRECISION),
+                     num_scalar_fluxes * sizeof(FP_PRECISION),
+                     num_boundary_fluxes * sizeof(FP_PRECISION),
+                     dif_tildes.size() * sizeof(FP_PRECISION)};
+  const void* arrays[4] = {&scalar_flux[0], &old_scalar_flux[0],
+                           boundary_flux,
+                           dif_tildes.empty() ? NULL : &dif_tildes[0]};
+
+  header._checksum = fnv1a_checksum(NULL, 0);
+  for (int i=0; i < 4; i++)
+    header._checksum = fnv1a_checksum(arrays[i], sizes[i],
+                                           header._checksum);
+
+  /* Write to a temporary file which replaces the checkpoint once complete */
+  std::string tmp_filename = std::string(filename) + ".tmp";
+  FILE* out = fopen(tmp_filename.c_str(), "wb");
+
+  if (out == NULL)
+    log_printf(ERROR, "Unable to open %s to dump a checkpoint",
+               tmp_filename.c_str());
+
+  bool written = (fwrite(&header, sizeof(header), 1, out) == 1);
+  for (int i=0; i < 4; i++) {
+    if (sizes[i] > 0)
+      written = written && (fwrite(arrays[i], sizes[i], 1, out) == 1);
+  }
+
+  written = (fclose(out) == 0) && written;
+
+  if (!written || rename(tmp_filename.c_str(), filename) != 0) {
+    remove(tmp_filename.c_str());
+    log_printf(ERROR, "Unable to dump a checkpoint to %s", filename);
+  }
+}
+
+
+/**
+ * @brief Reads the state of an eigenvalue calculation from a binary file.
+ * @details The checkpoint must have been written by Solver::dumpCheckpoint(...)
+ *          for the same Geometry, Tracks, energy groups, polar angles and
+ *          floating point precision. The next call to
+ *          Solver::computeEigenvalue(...) starts from the fluxes and
+ *          \f$ k_{eff} \f$ in the checkpoint. When resuming, the
+ *          calculation continues from the checkpoint's iteration with the
+ *          checkpoint's CMFD state, such that the maximum number of
+ *          iterations includes the iterations before the checkpoint.
+ *          Otherwise the checkpoint is only used as a warm start, which is
+ *          useful to start a calculation with new Materials.
+ * @param filename the name of the checkpoint file
+ * @param resume whether to resume the iterations (true) or only use the
+ *        checkpoint as an initial guess (false)
+ */
+void Solver::readCheckpoint(const char* filename, bool resume) {
+
+  if (_track_generator == NULL)
+    log_printf(ERROR, "Unable to read a checkpoint since the Solver does not "
+               "contain a TrackGenerator");
+
+  log_printf(NORMAL, "Reading a checkpoint from %s...", filename);
+
+  FILE* in = fopen(filename, "rb");
+
+  if (in == NULL)
+    log_printf(ERROR, "Unable to open checkpoint file %s", filename);
+
+  checkpoint_file_header header;
+  if (fread(&header, sizeof(header), 1, in) != 1 ||
+      strncmp(header._magic, CHECKPOINT_FILE_MAGIC, sizeof(header._magic))) {
+    fclose(in);
+    log_printf(ERROR, "Unable to read %s since it is not a checkpoint file",
+               filename);
+  }
+
+  if (header._byte_order == 0x04030201) {
+    fclose(in);
+    log_printf(ERROR, "Unable to read checkpoint %s since it was written on "
+               "a machine with a different byte order", filename);
+  }
+
+  int num_groups = _geometry->getNumEnergyGroups();
+  int num_dif_tildes = 0;
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
+    num_dif_tildes = _cmfd->getNumDifTildes();
+
+  const char* mismatch = NULL;
+  if (header._byte_order != CHECKPOINT_FILE_BYTE_ORDER ||
+      header._version != CHECKPOINT_FILE_VERSION)
+    mismatch = "file format version";
+  else if (header._precision != sizeof(FP_PRECISION))
+    mismatch = "floating point precision";
+  else if (header._geometry_hash != _geometry->getStructuralHash() ||
+           header._num_FSRs != _num_FSRs)
+    mismatch = "Geometry";
+  else if (header._num_groups != num_groups)
+    mismatch = "number of energy groups";
+  else if (header._num_tracks != uint64_t(_tot_num_tracks))
+    mismatch = "Tracks";
+  else if (header._num_polar != _num_polar)
+    mismatch = "number of polar angles";
+
+  if (mismatch != NULL) {
+    fclose(in);
+    log_printf(ERROR, "Unable to read checkpoint %s since its %s does not "
+               "match the Solver", filename, mismatch);
+  }
+
+  if (resume && header._material_hash != _geometry->getMaterialHash())
+    log_printf(WARNING, "Resuming from checkpoint %s with different "
+               "Materials than those used to write it", filename);
+
+  /* Read the fluxes and CMFD state and verify the checksum */
+  int num_polar_times_groups = _num_polar * num_groups;
+  std::vector<FP_PRECISION> scalar_flux(uint64_t(_num_FSRs) * num_groups);
+  std::vector<FP_PRECISION> old_scalar_flux(scalar_flux.size());
+  std::vector<FP_PRECISION> boundary_flux(uint64_t(_tot_num_tracks) * 2 *
+                                          num_polar_times_groups);
+  std::vector<FP_PRECISION> dif_tildes(header._num_dif_tildes);
+
+  std::vector<FP_PRECISION>* arrays[4] = {&scalar_flux, &old_scalar_flux,
+                                          &boundary_flux, &dif_tildes};
+  uint64_t checksum = fnv1a_checksum(NULL, 0);
+  bool valid = true;
+
+  for (int i=0; i < 4 && valid; i++) {
+    size_t num_bytes = arrays[i]->size() * sizeof(FP_PRECISION);
+    if (num_bytes == 0)
+      continue;
+    valid = (fread(&(*arrays[i])[0], num_bytes, 1, in) == 1);
+    checksum = fnv1a_checksum(&(*arrays[i])[0], num_bytes, checksum);
+  }
+
+  fclose(in);
+
+  if (!valid || checksum != header._checksum)
+    log_printf(ERROR, "Unable to read checkpoint %s since it is truncated "
+               "or corrupted", filename);
+
+  /* Allocate the flux arrays, zeroing any padding energy groups */
+  initializePolarQuadrature();
+  checkMemoryBudget();
+  initializeFluxArrays();
+
+  if (_scalar_flux == NULL || _boundary_flux == NULL)
+    log_printf(ERROR, "Unable to read checkpoint %s since this Solver does "
+               "not store its fluxes on the host", filename);
+
+  flattenFSRFluxes(0.0);
+  zeroTrackFluxes();
+
+  #pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int e=0; e < num_groups; e++) {
+      _scalar_flux(r,e) = scalar_flux[r*num_groups+e];
+      _old_scalar_flux(r,e) = old_scalar_flux[r*num_groups+e];
+    }
+  }
+
+  #pragma omp parallel for schedule(guided)
+  for (int i=0; i < _tot_num_tracks; i++) {
+    for (int j=0; j < 2; j++) {
+      for (int p=0; p < _num_polar; p++) {
+        for (int e=0; e < num_groups; e++)
+          _boundary_flux(i,j,p,e) =
+              boundary_flux[(uint64_t(i)*2+j)*num_polar_times_groups +
+                            p*num_groups + e];
+      }
+    }
+  }
+
+  /* Restore the CMFD state if the checkpoint has one for this CMFD mesh */
+  if (resume && num_dif_tildes > 0) {
+    if (header._num_dif_tildes == num_dif_tildes)
+      _cmfd->setDifTildes(&dif_tildes[0], num_dif_tildes);
+    else
+      log_printf(WARNING, "Unable to restore the CMFD state from checkpoint "
+                 "%s since it was written for a different CMFD mesh",
+                 filename);
+  }
+
+  _k_eff = header._k_eff;
+  _num_iterations = header._num_iterations;
+  _restart = true;
+  _start_iteration = resume ? header._num_iterations : 0;
+}
+
+
 /**
  * @brief Deletes the Timer's timing entries for each timed code section
  *        code in the source convergence loop.
  */
 void Solver::clearTimerSplits() {
   _timer->clearSplit("Total time");
+  _sweep_counters.clear();
+}
+
+
+/**
+ * @brief Clears the convergence history of a previous calculation and opens
+ *        the convergence history file if one has been set.
+ */
+void Solver::initializeHistory() {
+
+  _history.clear();
+  _sweep_time = 0.;
+  _num_sweeps = 0;
+  _tot_num_segments = _track_generator->getNumSegments();
+
+  if (_history_file != NULL) {
+    fclose(_history_file);
+    _history_file = NULL;
+  }
+
+  if (_history_filename.empty())
+    return;
+
+  _history_file = fopen(_history_filename.c_str(), "w");
+
+  if (_history_file == NULL) {
+    log_printf(WARNING, "Unable to open the convergence history file %s",
+               _history_filename.c_str());
+    return;
+  }
+
+  /* Write the header of a CSV file */
+  size_t length = _history_filename.length();
+  if (length >= 4 && _history_filename.compare(length-4, 4, ".csv") == 0)
+    fprintf(_history_file, "iteration,k_eff,residual,cmfd_k_eff,"
+            "cmfd_iterations,sweep_time,segment_rate,integration_rate\n");
+}
+
+
+/**
+ * @brief Records an iteration in the convergence history and writes it to
+ *        the convergence history file if one is open.
+ * @details The sweep time and rates are those of the transport sweeps since
+ *          the last iteration was recorded.
+ * @param iteration the index of the iteration
+ * @param residual the residual of the iteration
+ * @param cmfd_k_eff the CMFD eigenvalue (0 without CMFD acceleration)
+ * @param num_cmfd_iterations the number of CMFD power iterations
+ */
+void Solver::recordIteration(int iteration, FP_PRECISION residual,
+                             FP_PRECISION cmfd_k_eff,
+                             int num_cmfd_iterations) {
+
+  double values[NUM_HISTORY_QUANTITIES];
+  double segment_rate = 0.;
+
+  if (_sweep_time > 0.)
+    segment_rate = 2. * _tot_num_segments * _num_sweeps / _sweep_time;
+
+  values[HISTORY_ITERATION] = iteration;
+  values[HISTORY_K_EFF] = _k_eff;
+  values[HISTORY_RESIDUAL] = residual;
+  values[HISTORY_CMFD_K_EFF] = cmfd_k_eff;
+  values[HISTORY_CMFD_ITERATIONS] = num_cmfd_iterations;
+  values[HISTORY_SWEEP_TIME] = _sweep_time;
+  values[HISTORY_SEGMENT_RATE] = segment_rate;
+  values[HISTORY_INTEGRATION_RATE] = segment_rate * _polar_times_groups;
+
+  _history.insert(_history.end(), values, values + NUM_HISTORY_QUANTITIES);
+  _sweep_time = 0.;
+  _num_sweeps = 0;
+
+  if (_history_file == NULL)
+    return;
+
+  /* Write a CSV line or a JSON object */
+  const char* names[NUM_HISTORY_QUANTITIES] = {"iteration", "k_eff",
+    "residual", "cmfd_k_eff", "cmfd_iterations", "sweep_time",
+    "segment_rate", "integration_rate"};
+  size_t length = _history_filename.length();
+  bool csv = (length >= 4 &&
+              _history_filename.compare(length-4, 4, ".csv") == 0);
+
+  for (int i=0; i < NUM_HISTORY_QUANTITIES; i++) {
+    if (csv)
+      fprintf(_history_file, "%s%.10g", (i == 0) ? "" : ",", values[i]);
+    else if (std::isfinite(values[i]))
+      fprintf(_history_file, "%s\"%s\": %.10g", (i == 0) ? "{" : ", ",
+              names[i], values[i]);
+    else
+      fprintf(_history_file, "%s\"%s\": null", (i == 0) ? "{" : ", ",
+              names[i]);
+  }
+
+  fprintf(_history_file, csv ? "\n" : "}\n");
+  fflush(_history_file);
 }
 
 
 /**
  * @brief Prints a report of the timing statistics to the console.
+ * @details The report ends with the inclusive and exclusive times of each
+ *          phase recorded by the Timer (e.g., track generation and each step
+ *          of the source iterations). The phase times accumulate over all
+ *          calculations until they are cleared with Timer::clearPhases(),
+ *          and may be queried from Python with Timer::getPhaseTime(...).
  */
 void Solver::printTimerReport() {
 
@@ -1024,4 +3097,8 @@ void Solver::printTimerReport() {
 
   log_printf(RESULT, "%s", msg.str().c_str());
   log_printf(SEPARATOR, "-");
+
+  /* Inclusive and exclusive times of each phase */
+  _timer->printPhases();
+  log_printf(SEPARATOR, "-");
 }
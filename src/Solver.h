@@ -10,16 +10,33 @@
 
 #ifdef __cplusplus
 #define _USE_MATH_DEFINES
-#include "Python.h"
 #include "constants.h"
 #include "Timer.h"
 #include "PolarQuad.h"
 #include "TrackGenerator.h"
 #include "Cmfd.h"
 #include "ExpEvaluator.h"
+#include "MemoryTracker.h"
 #include <math.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
 #endif
 
+/** The magic string at the start of each binary Solver checkpoint file */
+#define CHECKPOINT_FILE_MAGIC "OMOCCHK"
+
+/** The version of the binary Solver checkpoint file format */
+#define CHECKPOINT_FILE_VERSION 3
+
+/** The byte order marker of a binary Solver checkpoint file, which reads as
+ *  0x04030201 on a machine with the opposite byte order to the writer */
+#define CHECKPOINT_FILE_BYTE_ORDER 0x01020304
+
 /** Indexing macro for the scalar flux in each FSR and energy group */
 #define _scalar_flux(r,e) (_scalar_flux[(r)*_num_groups + (e)])
 
@@ -58,6 +75,45 @@
 #define scatter_sources(r,e) (scatter_sources[(r)*_num_groups + (e)])
 
 
+/** The number of quantities recorded for each iteration in the
+ *  convergence history */
+#define NUM_HISTORY_QUANTITIES 8
+
+
+/**
+ * @enum historyQuantity
+ * @brief The quantities recorded for each iteration in the convergence
+ *        history.
+ */
+enum historyQuantity {
+
+  /** The index of the iteration */
+  HISTORY_ITERATION,
+
+  /** The eigenvalue after the iteration */
+  HISTORY_K_EFF,
+
+  /** The residual of the iteration */
+  HISTORY_RESIDUAL,
+
+  /** The CMFD eigenvalue (0 without CMFD acceleration) */
+  HISTORY_CMFD_K_EFF,
+
+  /** The number of CMFD power iterations (0 without CMFD acceleration) */
+  HISTORY_CMFD_ITERATIONS,
+
+  /** The time (seconds) spent in transport sweeps during the iteration */
+  HISTORY_SWEEP_TIME,
+
+  /** The number of segments swept per second */
+  HISTORY_SEGMENT_RATE,
+
+  /** The number of segment integrations (for each polar angle and energy
+   *  group) per second */
+  HISTORY_INTEGRATION_RATE
+};
+
+
 /**
  * @enum residualType
  * @brief The type of residual used for the convergence criterion.
@@ -75,6 +131,64 @@ enum residualType {
 };
 
 
+/**
+ * @struct checkpoint_file_header
+ * @brief The fixed size header at the start of a binary Solver checkpoint.
+ * @details The header is followed by the FSR scalar fluxes, the FSR scalar
+ *          fluxes from the previous source iteration, the Track boundary
+ *          angular fluxes and the CMFD surface diffusion coefficient
+ *          corrections, each stored as a contiguous array of FP_PRECISION
+ *          values without any padding energy groups.
+ */
+struct checkpoint_file_header {
+
+  /** The magic string identifying the file format */
+  char _magic[8];
+
+  /** The byte order marker (CHECKPOINT_FILE_BYTE_ORDER) */
+  uint32_t _byte_order;
+
+  /** The version of the file format */
+  uint32_t _version;
+
+  /** The size in bytes of each floating point value (4 or 8) */
+  uint32_t _precision;
+
+  /** Padding to align the next field to 8 bytes */
+  uint32_t _padding;
+
+  /** The number of FSRs */
+  int32_t _num_FSRs;
+
+  /** The number of energy groups */
+  int32_t _num_groups;
+
+  /** The number of polar angles */
+  int32_t _num_polar;
+
+  /** The number of CMFD surface diffusion coefficient corrections */
+  int32_t _num_dif_tildes;
+
+  /** The total number of Tracks */
+  uint64_t _num_tracks;
+
+  /** The number of source iterations completed */
+  uint64_t _num_iterations;
+
+  /** The eigenvalue after the last completed source iteration */
+  double _k_eff;
+
+  /** The structural hash of the Geometry */
+  uint64_t _geometry_hash;
+
+  /** The Material hash of the Geometry */
+  uint64_t _material_hash;
+
+  /** The checksum of the arrays which follow the header */
+  uint64_t _checksum;
+};
+
+
 /**
  * @class Solver Solver.h "src/Solver.h"
  * @brief This is an abstract base class which different Solver subclasses
@@ -160,6 +274,93 @@ protected:
   /** The number of source iterations needed to reach convergence */
   int _num_iterations;
 
+  /** Whether to start each eigenvalue calculation from the current scalar
+   *  and boundary fluxes and eigenvalue (true) or a flat flux (false) */
+  bool _warm_start;
+
+  /** Whether the next eigenvalue calculation starts from a checkpoint */
+  bool _restart;
+
+  /** The source iteration from which to resume the next eigenvalue
+   *  calculation after reading a checkpoint */
+  int _start_iteration;
+
+  /** The number of source iterations between checkpoints (0 for none) */
+  int _checkpoint_interval;
+
+  /** The file to which checkpoints are written every few iterations */
+  std::string _checkpoint_filename;
+
+  /** The number of GMRES iterations before a restart for Newton-Krylov */
+  int _krylov_restart;
+
+  /** The GMRES tolerance relative to the Newton-Krylov residual */
+  FP_PRECISION _krylov_tolerance;
+
+  /** The number of power iterations before Newton-Krylov iterations */
+  int _krylov_power_iterations;
+
+  /** The number of previous iterates mixed by Anderson acceleration
+   *  (0 for no acceleration) */
+  int _anderson_depth;
+
+  /** The number of source iterations seen by Anderson acceleration */
+  int _anderson_num_iterations;
+
+  /** The number of stored Anderson history vectors */
+  int _anderson_num_stored;
+
+  /** The slot for the next Anderson history vector */
+  int _anderson_index;
+
+  /** The smallest norm of the Anderson residual since the last restart */
+  double _anderson_residual;
+
+  /** The last accelerated scalar and boundary fluxes */
+  FP_PRECISION* _anderson_x;
+
+  /** The last unaccelerated scalar and boundary fluxes */
+  FP_PRECISION* _anderson_g;
+
+  /** The last Anderson residual for the scalar and boundary fluxes */
+  FP_PRECISION* _anderson_f;
+
+  /** The differences between successive unaccelerated scalar and boundary
+   *  fluxes for each history vector */
+  FP_PRECISION* _anderson_delta_g;
+
+  /** The differences between successive Anderson residuals for each
+   *  history vector */
+  FP_PRECISION* _anderson_delta_f;
+
+  /** The number of steps in each cycle of Chebyshev extrapolation
+   *  (0 for no extrapolation) */
+  int _chebyshev_order;
+
+  /** The step in the current Chebyshev cycle (0 for a power iteration) */
+  int _chebyshev_step;
+
+  /** The number of source iterations seen by Chebyshev extrapolation */
+  int _chebyshev_num_iterations;
+
+  /** The number of power iterations since the last Chebyshev restart */
+  int _chebyshev_num_power_iterations;
+
+  /** The norm of the residual at the start of the Chebyshev cycle */
+  double _chebyshev_cycle_residual;
+
+  /** The norm of the last residual seen by Chebyshev extrapolation */
+  double _chebyshev_residual;
+
+  /** The last extrapolated scalar and boundary fluxes */
+  FP_PRECISION* _chebyshev_x;
+
+  /** The extrapolated scalar and boundary fluxes before the last ones */
+  FP_PRECISION* _chebyshev_x_old;
+
+  /** The estimated dominance ratio of the source iteration */
+  double _dominance_ratio;
+
   /** The tolerance for converging the source/flux */
   FP_PRECISION _converge_thresh;
 
@@ -169,9 +370,38 @@ protected:
   /** A timer to record timing data for a simulation */
   Timer* _timer;
 
+  /** The hardware counts of the transport sweep in each source iteration,
+   *  indexed by iteration and then hardwareCounter */
+  std::vector<long> _sweep_counters;
+
+  /** The time (seconds) spent in transport sweeps since the last iteration
+   *  was recorded in the convergence history */
+  double _sweep_time;
+
+  /** The number of transport sweeps since the last iteration was recorded
+   *  in the convergence history */
+  int _num_sweeps;
+
+  /** The total number of segments swept by each transport sweep */
+  int _tot_num_segments;
+
+  /** The quantities recorded for each iteration of the last calculation,
+   *  indexed by iteration and then historyQuantity */
+  std::vector<double> _history;
+
+  /** The file to which each iteration is written as it is recorded in the
+   *  convergence history (empty for none) */
+  std::string _history_filename;
+
+  /** The open convergence history file (NULL if none is open) */
+  FILE* _history_file;
+
   /** A pointer to a Coarse Mesh Finite Difference (CMFD) acceleration object */
   Cmfd* _cmfd;
 
+  /** The bytes recorded with the MemoryTracker for each memorySubsystem */
+  size_t _memory_usage[NUM_MEMORY_SUBSYSTEMS];
+
   /**
    * @brief Initializes Track boundary angular flux and leakage and
    *        FSR scalar flux arrays.
@@ -188,6 +418,19 @@ protected:
   virtual void initializeFSRs();
   virtual void countFissionableFSRs();
   virtual void initializeCmfd();
+  virtual void countMemoryUsage(size_t* num_bytes, bool newton_krylov=false);
+  void checkMemoryBudget(bool newton_krylov=false);
+  int initializeEigenvalue(bool newton_krylov=false);
+  void initializeAnderson();
+  void accelerateAnderson(bool normalize);
+  void initializeChebyshev();
+  void accelerateChebyshev();
+  FP_PRECISION computeSourceIteration(int iteration, residualType res_type);
+  void getNewtonState(double* x, size_t size);
+  void setNewtonState(double* x, size_t size);
+  void computeNewtonResidual(double* x, double* F, size_t size);
+  int solveNewtonStep(double* x, double* F, double* dx, size_t size,
+                      int max_sweeps);
 
   /**
    * @brief Zero each Track's boundary fluxes for each energy group and polar
@@ -244,6 +487,9 @@ protected:
   virtual void transportSweep() =0;
 
   void clearTimerSplits();
+  void initializeHistory();
+  void recordIteration(int iteration, FP_PRECISION residual,
+                       FP_PRECISION cmfd_k_eff, int num_cmfd_iterations);
 
 public:
   Solver(TrackGenerator* track_generator=NULL);
@@ -262,17 +508,43 @@ public:
   FP_PRECISION getMaxOpticalLength();
   bool isUsingDoublePrecision();
   bool isUsingExponentialInterpolation();
+  bool isUsingWarmStart();
+  int getAndersonDepth();
+  int getChebyshevOrder();
+  double getDominanceRatio();
+  int getNumCounterIterations();
+  void getSweepCounters(double* counters, int num_values);
+  int getNumHistoryIterations();
+  void getConvergenceHistory(double* history, int num_values);
+  size_t predictMemoryUsage();
 
   virtual FP_PRECISION getFSRScalarFlux(int fsr_id, int group);
   virtual FP_PRECISION getFSRSource(int fsr_id, int group);
+  virtual void getFluxes(FP_PRECISION* out_fluxes, int num_fluxes);
+  int getNumBoundaryFluxes();
+  virtual void getBoundaryFluxes(FP_PRECISION* out_fluxes, int num_fluxes);
 
   virtual void setTrackGenerator(TrackGenerator* track_generator);
   virtual void setPolarQuadrature(PolarQuad* polar_quad);
   virtual void setConvergenceThreshold(FP_PRECISION threshold);
+  virtual void setFluxes(FP_PRECISION* in_fluxes, int num_fluxes);
+  virtual void setBoundaryFluxes(FP_PRECISION* in_fluxes, int num_fluxes);
+  void setKeff(FP_PRECISION k_eff);
+  void setWarmStart(bool warm_start);
+  void setCheckpointInterval(int num_iterations, const char* filename);
+  void setHistoryFile(const char* filename);
+  void setKrylovRestart(int restart);
+  void setKrylovTolerance(FP_PRECISION tolerance);
+  void setKrylovPowerIterations(int num_iters);
+  void setAndersonDepth(int depth);
+  void setChebyshevOrder(int order);
   virtual void setFixedSourceByFSR(int fsr_id, int group, FP_PRECISION source);
   void setFixedSourceByCell(Cell* cell, int group, FP_PRECISION source);
   void setFixedSourceByMaterial(Material* material, int group, 
                                 FP_PRECISION source);
+  virtual void rebindMaterial(int material_id, Material* material);
+  virtual void rebindFSRMaterials(int* fsr_ids, int num_fsr_ids,
+                                  Material* material);
   void setMaxOpticalLength(FP_PRECISION max_optical_length);
   void setExpPrecision(FP_PRECISION precision);
   void useExponentialInterpolation();
@@ -283,6 +555,11 @@ public:
                      residualType res_type=TOTAL_SOURCE);
   void computeEigenvalue(int max_iters=1000, 
                          residualType res_type=FISSION_SOURCE);
+  void computeEigenvalueNewtonKrylov(int max_iters=1000,
+                                     residualType res_type=FISSION_SOURCE);
+
+  void dumpCheckpoint(const char* filename);
+  void readCheckpoint(const char* filename, bool resume=true);
 
  /**
   * @brief Computes the volume-weighted, energy integrated fission rate in
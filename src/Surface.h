@@ -10,7 +10,6 @@
 #define SURFACE_H_
 
 #ifdef __cplusplus
-#include "Python.h"
 #include "constants.h"
 #include "LocalCoords.h"
 #include "boundary_type.h"
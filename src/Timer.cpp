@@ -3,6 +3,25 @@
 
 std::map<std::string, double> Timer::_timer_splits;
 std::vector<double> Timer::_start_times;
+std::vector<timerPhase> Timer::_phases;
+int Timer::_master_phase = -1;
+thread_local std::vector<runningPhase> Timer::_phase_stack;
+bool Timer::_counters_on = false;
+std::vector<int> Timer::_counter_fds;
+int Timer::_counters_generation = 0;
+thread_local int Timer::_counters_opened = -1;
+thread_local int Timer::_counter_group = -1;
+thread_local int Timer::_counter_slots[NUM_HARDWARE_COUNTERS];
+
+
+/**
+ * @brief Destructor closes the hardware counters of all threads.
+ * @details The counters are opened again by each thread which next starts
+ *          a phase while they are recorded.
+ */
+Timer::~Timer() {
+  closeHardwareCounters();
+}
 
 
 /**
@@ -136,3 +155,669 @@ void Timer::clearSplit(const char* msg) {
 void Timer::clearSplits() {
   _timer_splits.clear();
 }
+
+
+/**
+ * @brief Finds the phase with some name nested within a phase, adding it to
+ *        the tree of phases if it does not yet exist.
+ * @details This must only be called within the timer_phases critical
+ *          section.
+ * @param parent the index of the enclosing phase (-1 for a top-level phase)
+ * @param name the name of the phase
+ * @return the index of the phase
+ */
+int Timer::findChildPhase(int parent, const char* name) {
+
+  if (parent == -1) {
+    for (int i=0; i < int(_phases.size()); i++)
+      if (_phases[i]._parent == -1 && _phases[i]._name == name)
+        return i;
+  }
+  else {
+    std::vector<int>& children = _phases[parent]._children;
+    for (int i=0; i < int(children.size()); i++)
+      if (_phases[children[i]]._name == name)
+        return children[i];
+  }
+
+  timerPhase phase;
+  phase._name = name;
+  phase._path = name;
+  phase._parent = parent;
+
+  if (parent != -1) {
+    phase._path = _phases[parent]._path + "/" + phase._path;
+    _phases[parent]._children.push_back(_phases.size());
+  }
+
+  _phases.push_back(phase);
+  return _phases.size() - 1;
+}
+
+
+/**
+ * @brief Finds the phase with some path (e.g.,
+ *        "computeEigenvalue/transportSweep").
+ * @param path the names of the enclosing phases and the phase separated
+ *        by '/'
+ * @return the index of the phase (-1 if it does not exist)
+ */
+int Timer::findPhase(const char* path) {
+
+  int index = -1;
+
+  #pragma omp critical (timer_phases)
+  {
+    for (int i=0; i < int(_phases.size()); i++) {
+      if (_phases[i]._path == path) {
+        index = i;
+        break;
+      }
+    }
+  }
+
+  return index;
+}
+
+
+/**
+ * @brief Starts a phase of a calculation on this thread.
+ * @details The phase is nested within the phase this thread is running, or
+ *          if it is not running one, within the phase the master thread is
+ *          running outside of parallel regions. This method may be called
+ *          by any thread.
+ * @param name the name of the phase
+ * @return the number of phases this thread was running before this one
+ */
+int Timer::startPhase(const char* name) {
+
+  int parent = _master_phase;
+  int depth = _phase_stack.size();
+  int phase;
+
+  if (depth > 0)
+    parent = _phase_stack.back()._phase;
+
+  #pragma omp critical (timer_phases)
+  phase = findChildPhase(parent, name);
+
+  if (!omp_in_parallel())
+    _master_phase = phase;
+
+  runningPhase running;
+  running._phase = phase;
+  readHardwareCounters(running._counters);
+  running._counters_generation = _counters_opened;
+  running._start_time = omp_get_wtime();
+  _phase_stack.push_back(running);
+  return depth;
+}
+
+
+/**
+ * @brief Stops the phase this thread started most recently and adds its
+ *        elapsed time to the thread's time for the phase.
+ * @return the time elapsed since the phase was started (seconds)
+ */
+double Timer::stopPhase() {
+
+  if (_phase_stack.empty()) {
+    log_printf(WARNING, "Unable to stop a phase since none has been started");
+    return 0.;
+  }
+
+  double time = omp_get_wtime() - _phase_stack.back()._start_time;
+  long counters[NUM_HARDWARE_COUNTERS];
+  readHardwareCounters(counters);
+
+  runningPhase& running = _phase_stack.back();
+  int phase = running._phase;
+  int thread = omp_get_thread_num();
+
+  /* Counters which were closed and opened again during the phase are not
+   * comparable with those read at its start */
+  for (int c=0; c < NUM_HARDWARE_COUNTERS; c++) {
+    if (running._counters_generation == _counters_opened)
+      counters[c] -= running._counters[c];
+    else
+      counters[c] = 0;
+  }
+
+  _phase_stack.pop_back();
+
+  #pragma omp critical (timer_phases)
+  {
+    timerPhase& curr_phase = _phases[phase];
+
+    if (int(curr_phase._thread_times.size()) <= thread) {
+      curr_phase._thread_times.resize(thread+1, 0.);
+      curr_phase._thread_calls.resize(thread+1, 0);
+      curr_phase._thread_counters.resize((thread+1) * NUM_HARDWARE_COUNTERS,
+                                         0);
+    }
+
+    curr_phase._thread_times[thread] += time;
+    curr_phase._thread_calls[thread]++;
+
+    for (int c=0; c < NUM_HARDWARE_COUNTERS; c++)
+      curr_phase._thread_counters[thread*NUM_HARDWARE_COUNTERS+c] +=
+          counters[c];
+
+    if (!omp_in_parallel())
+      _master_phase = curr_phase._parent;
+  }
+
+  return time;
+}
+
+
+/**
+ * @brief Stops the phases this thread is running until it is running some
+ *        number of phases.
+ * @param depth the number of phases to leave running
+ */
+void Timer::stopPhases(int depth) {
+  while (int(_phase_stack.size()) > depth)
+    stopPhase();
+}
+
+
+/**
+ * @brief Returns the number of phases which have been started.
+ * @return the number of phases
+ */
+int Timer::getNumPhases() {
+  return _phases.size();
+}
+
+
+/**
+ * @brief Returns the path of a phase (e.g.,
+ *        "computeEigenvalue/transportSweep").
+ * @param phase the index of the phase in the order it was first started
+ * @return the names of the enclosing phases and the phase separated by '/'
+ */
+const char* Timer::getPhasePath(int phase) {
+
+  if (phase < 0 || phase >= int(_phases.size()))
+    log_printf(ERROR, "Unable to get the path of phase %d since there are "
+               "only %d phases", phase, int(_phases.size()));
+
+  return _phases[phase]._path.c_str();
+}
+
+
+/**
+ * @brief Returns the path of the phase which the calling thread is running.
+ * @details The path is returned by value since the tree of phases may grow
+ *          and move the paths stored in it.
+ * @return the names of the enclosing phases and the phase separated by '/'
+ *         (an empty string if the thread is not running a phase)
+ */
+std::string Timer::getRunningPhasePath() {
+
+  if (_phase_stack.empty())
+    return "";
+
+  std::string path;
+
+  #pragma omp critical (timer_phases)
+  path = _phases[_phase_stack.back()._phase]._path;
+
+  return path;
+}
+
+
+/**
+ * @brief Returns the inclusive time of a phase, which is the largest time
+ *        spent in the phase by any one thread.
+ * @param phase the index of the phase
+ * @return the inclusive time (seconds)
+ */
+double Timer::getInclusiveTime(int phase) {
+
+  std::vector<double>& thread_times = _phases[phase]._thread_times;
+  double time = 0.;
+
+  for (int i=0; i < int(thread_times.size()); i++)
+    time = std::max(time, thread_times[i]);
+
+  return time;
+}
+
+
+/**
+ * @brief Returns the time spent in a phase.
+ * @details The inclusive time of a phase includes the phases nested within
+ *          it, while the exclusive time does not. If a phase was run by
+ *          several threads, its inclusive time is that of the slowest
+ *          thread. If the phase does not exist, returns 0.
+ * @param path the names of the enclosing phases and the phase separated
+ *        by '/' (e.g., "computeEigenvalue/transportSweep")
+ * @param exclusive whether to exclude the time of nested phases
+ * @return the time spent in the phase (seconds)
+ */
+double Timer::getPhaseTime(const char* path, bool exclusive) {
+
+  int phase = findPhase(path);
+
+  if (phase == -1)
+    return 0.;
+
+  double time = getInclusiveTime(phase);
+
+  if (exclusive) {
+    std::vector<int>& children = _phases[phase]._children;
+    for (int i=0; i < int(children.size()); i++)
+      time -= getInclusiveTime(children[i]);
+  }
+
+  return std::max(time, 0.);
+}
+
+
+/**
+ * @brief Returns the time spent in a phase by one thread.
+ * @details If the phase does not exist or was not run by the thread,
+ *          returns 0.
+ * @param path the names of the enclosing phases and the phase separated
+ *        by '/' (e.g., "computeEigenvalue/transportSweep/sweepTracks")
+ * @param thread the OpenMP thread number
+ * @return the time spent in the phase by the thread (seconds)
+ */
+double Timer::getPhaseThreadTime(const char* path, int thread) {
+
+  int phase = findPhase(path);
+
+  if (phase == -1 || thread < 0 ||
+      thread >= int(_phases[phase]._thread_times.size()))
+    return 0.;
+
+  return _phases[phase]._thread_times[thread];
+}
+
+
+/**
+ * @brief Returns the number of times a phase was run by all threads.
+ * @param path the names of the enclosing phases and the phase separated
+ *        by '/'
+ * @return the number of times the phase was run (0 if it does not exist)
+ */
+long Timer::getPhaseNumCalls(const char* path) {
+
+  int phase = findPhase(path);
+  long num_calls = 0;
+
+  if (phase == -1)
+    return 0;
+
+  std::vector<long>& thread_calls = _phases[phase]._thread_calls;
+  for (int i=0; i < int(thread_calls.size()); i++)
+    num_calls += thread_calls[i];
+
+  return num_calls;
+}
+
+
+/**
+ * @brief Returns the hardware count of a thread in a phase.
+ * @details If the thread did not run the phase itself, its counts in the
+ *          phases nested within it are summed instead (e.g., a thread in a
+ *          parallel region which only ran a nested phase).
+ * @param phase the index of the phase
+ * @param thread the OpenMP thread number
+ * @param counter the hardwareCounter
+ * @return the number of events counted
+ */
+long Timer::getThreadCounter(int phase, int thread, int counter) {
+
+  timerPhase& curr_phase = _phases[phase];
+
+  if (thread < int(curr_phase._thread_calls.size()) &&
+      curr_phase._thread_calls[thread] > 0)
+    return curr_phase._thread_counters[thread*NUM_HARDWARE_COUNTERS+counter];
+
+  long count = 0;
+  for (int i=0; i < int(curr_phase._children.size()); i++)
+    count += getThreadCounter(curr_phase._children[i], thread, counter);
+
+  return count;
+}
+
+
+/**
+ * @brief Returns the hardware count of a phase summed over all threads.
+ * @details The count includes the phases nested within the phase. If the
+ *          phase does not exist or the counter is unavailable, returns 0.
+ * @param path the names of the enclosing phases and the phase separated
+ *        by '/' (e.g., "computeEigenvalue/transportSweep")
+ * @param counter the hardwareCounter (e.g., CYCLES)
+ * @return the number of events counted
+ */
+long Timer::getPhaseCounter(const char* path, hardwareCounter counter) {
+
+  int phase = findPhase(path);
+  long count = 0;
+
+  if (phase == -1)
+    return 0;
+
+  int num_threads = 0;
+  for (int i=0; i < int(_phases.size()); i++)
+    num_threads = std::max(num_threads, int(_phases[i]._thread_calls.size()));
+
+  for (int t=0; t < num_threads; t++)
+    count += getThreadCounter(phase, t, counter);
+
+  return count;
+}
+
+
+/**
+ * @brief Prints the inclusive and exclusive times of a phase and the phases
+ *        nested within it to the console.
+ * @param phase the index of the phase
+ * @param depth the number of phases enclosing the phase
+ * @param counters whether to print the hardware counts rather than times
+ */
+void Timer::printPhase(int phase, int depth, bool counters) {
+
+  timerPhase& curr_phase = _phases[phase];
+  int num_threads = 0;
+
+  for (int i=0; i < int(curr_phase._thread_calls.size()); i++)
+    if (curr_phase._thread_calls[i] > 0)
+      num_threads++;
+
+  if (num_threads == 0)
+    return;
+
+  std::stringstream msg;
+  msg << std::string(2*depth, ' ') << curr_phase._name;
+  if (num_threads > 1)
+    msg << " [" << num_threads << " threads]";
+
+  std::string msg_string = msg.str();
+  const char* path = curr_phase._path.c_str();
+
+  if (counters) {
+    msg_string.resize(25, '.');
+    log_printf(RESULT, "%s%1.3E %1.3E %1.3E %1.3E", msg_string.c_str(),
+               double(getPhaseCounter(path, CYCLES)),
+               double(getPhaseCounter(path, INSTRUCTIONS)),
+               double(getPhaseCounter(path, LLC_MISSES)),
+               double(getPhaseCounter(path, VECTOR_INSTRUCTIONS)));
+  }
+  else {
+    msg_string.resize(41, '.');
+    log_printf(RESULT, "%s%1.4E    %1.4E", msg_string.c_str(),
+               getPhaseTime(path, false), getPhaseTime(path, true));
+  }
+
+  for (int i=0; i < int(curr_phase._children.size()); i++)
+    printPhase(curr_phase._children[i], depth+1, counters);
+}
+
+
+/**
+ * @brief Prints the inclusive and exclusive times of each phase to the
+ *        console, with nested phases indented beneath their enclosing
+ *        phase.
+ * @details Phases run by several threads are reported with the time of the
+ *          slowest thread. If hardware counters are recorded, the counts of
+ *          each phase summed over all threads are printed as well.
+ */
+void Timer::printPhases() {
+
+  std::string msg_string = "Phase times (sec)";
+  msg_string.resize(41, ' ');
+  log_printf(RESULT, "%sInclusive     Exclusive", msg_string.c_str());
+
+  for (int i=0; i < int(_phases.size()); i++)
+    if (_phases[i]._parent == -1)
+      printPhase(i, 0, false);
+
+  if (!_counters_on)
+    return;
+
+  msg_string = "Phase counts";
+  msg_string.resize(25, ' ');
+  log_printf(RESULT, "%sCycles    Instrs    LLC miss  Vector",
+             msg_string.c_str());
+
+  for (int i=0; i < int(_phases.size()); i++)
+    if (_phases[i]._parent == -1)
+      printPhase(i, 0, true);
+}
+
+
+/**
+ * @brief Clears the times of all phases.
+ * @details The tree of phases is kept such that phases which are running
+ *          may still be stopped.
+ */
+void Timer::clearPhases() {
+
+  #pragma omp critical (timer_phases)
+  {
+    for (int i=0; i < int(_phases.size()); i++) {
+      _phases[i]._thread_times.clear();
+      _phases[i]._thread_calls.clear();
+      _phases[i]._thread_counters.clear();
+    }
+  }
+}
+
+
+#ifdef __linux__
+/**
+ * @brief Opens a Linux perf event to count a hardware event in user space
+ *        on the calling thread.
+ * @param type the perf event type
+ * @param config the perf event configuration
+ * @param group_fd the file descriptor of the group leader (-1 for a leader)
+ * @return the file descriptor of the perf event (-1 if it is unavailable)
+ */
+static int open_perf_event(uint32_t type, uint64_t config, int group_fd) {
+
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+
+  return syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+
+/**
+ * @brief Returns whether the processor is made by Intel, for which the raw
+ *        event counting packed floating point instructions is known.
+ * @return whether the processor is made by Intel
+ */
+static bool is_intel_processor() {
+
+  FILE* cpuinfo = fopen("/proc/cpuinfo", "r");
+  char line[256];
+  bool intel = false;
+
+  if (cpuinfo == NULL)
+    return false;
+
+  while (fgets(line, sizeof(line), cpuinfo) != NULL) {
+    if (strncmp(line, "vendor_id", 9) == 0) {
+      intel = (strstr(line, "GenuineIntel") != NULL);
+      break;
+    }
+  }
+
+  fclose(cpuinfo);
+  return intel;
+}
+#endif
+
+
+/**
+ * @brief Opens the hardware counters of the calling thread as one perf
+ *        event group so that they may be read together.
+ * @details Counters which cannot be opened are skipped. Packed floating
+ *          point instructions are counted with the FP_ARITH_INST_RETIRED
+ *          event of Intel processors from Broadwell onwards.
+ */
+void Timer::openHardwareCounters() {
+
+  _counters_opened = _counters_generation;
+  _counter_group = -1;
+
+  for (int c=0; c < NUM_HARDWARE_COUNTERS; c++)
+    _counter_slots[c] = -1;
+
+#ifdef __linux__
+  static bool intel = is_intel_processor();
+
+  uint32_t types[NUM_HARDWARE_COUNTERS] = {PERF_TYPE_HARDWARE,
+    PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_RAW};
+  uint64_t configs[NUM_HARDWARE_COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, 0xFCC7};
+  int num_opened = 0;
+
+  for (int c=0; c < NUM_HARDWARE_COUNTERS; c++) {
+
+    if (c == VECTOR_INSTRUCTIONS && !intel)
+      continue;
+
+    int fd = open_perf_event(types[c], configs[c], _counter_group);
+
+    if (fd == -1)
+      continue;
+
+    #pragma omp critical (timer_counters)
+    _counter_fds.push_back(fd);
+
+    if (_counter_group == -1)
+      _counter_group = fd;
+
+    _counter_slots[c] = num_opened;
+    num_opened++;
+  }
+#endif
+}
+
+
+/**
+ * @brief Closes the hardware counters opened by all threads.
+ * @details Each thread opens its counters again the next time it reads
+ *          them.
+ */
+void Timer::closeHardwareCounters() {
+
+  #pragma omp critical (timer_counters)
+  {
+#ifdef __linux__
+    for (int i=0; i < int(_counter_fds.size()); i++)
+      close(_counter_fds[i]);
+#endif
+
+    _counter_fds.clear();
+    _counters_generation++;
+  }
+}
+
+
+/**
+ * @brief Reads the hardware counters of the calling thread.
+ * @details The counters are opened the first time they are read by each
+ *          thread. Counters which are unavailable or not recorded are zero.
+ * @param counters an array to store the count of each hardwareCounter
+ */
+void Timer::readHardwareCounters(long* counters) {
+
+  for (int c=0; c < NUM_HARDWARE_COUNTERS; c++)
+    counters[c] = 0;
+
+  if (!_counters_on)
+    return;
+
+  if (_counters_opened != _counters_generation)
+    openHardwareCounters();
+
+  if (_counter_group == -1)
+    return;
+
+#ifdef __linux__
+  uint64_t values[NUM_HARDWARE_COUNTERS+1];
+
+  if (read(_counter_group, values, sizeof(values)) <= 0)
+    return;
+
+  for (int c=0; c < NUM_HARDWARE_COUNTERS; c++)
+    if (_counter_slots[c] != -1 && uint64_t(_counter_slots[c]) < values[0])
+      counters[c] = values[_counter_slots[c]+1];
+#endif
+}
+
+
+/**
+ * @brief Sets whether to record hardware performance counters for each
+ *        phase.
+ * @details If the calling thread is unable to open any hardware counter
+ *          (e.g., perf events are not permitted or this is not Linux), a
+ *          warning is printed and the counters are not recorded.
+ * @param counters_on whether to record hardware counters
+ */
+void Timer::setHardwareCounters(bool counters_on) {
+
+  _counters_on = counters_on;
+
+  if (!counters_on) {
+    closeHardwareCounters();
+    return;
+  }
+
+  if (_counters_opened != _counters_generation)
+    openHardwareCounters();
+
+  if (_counter_group == -1) {
+    log_printf(WARNING, "Unable to record hardware counters since perf "
+               "events are unavailable");
+    _counters_on = false;
+    return;
+  }
+
+  const char* names[NUM_HARDWARE_COUNTERS] = {"cycles", "instructions",
+    "last level cache misses", "vector instructions"};
+
+  for (int c=0; c < NUM_HARDWARE_COUNTERS; c++)
+    if (_counter_slots[c] == -1)
+      log_printf(INFO, "The hardware counter for %s is unavailable",
+                 names[c]);
+}
+
+
+/**
+ * @brief Returns whether hardware counters are recorded for each phase.
+ * @return whether hardware counters are recorded
+ */
+bool Timer::isRecordingHardwareCounters() {
+  return _counters_on;
+}
+
+
+/**
+ * @brief Returns whether a hardware counter is recorded for each phase.
+ * @param counter the hardwareCounter (e.g., CYCLES)
+ * @return whether the counter is recorded
+ */
+bool Timer::isHardwareCounterAvailable(hardwareCounter counter) {
+
+  if (!_counters_on)
+    return false;
+
+  if (_counters_opened != _counters_generation)
+    openHardwareCounters();
+
+  return _counter_slots[counter] != -1;
+}
@@ -9,7 +9,6 @@
 #define TIMER_H_
 
 #ifdef __cplusplus
-#include "Python.h"
 #include "log.h"
 #include <time.h>
 #include <omp.h>
@@ -17,15 +16,114 @@
 #include <sstream>
 #include <iomanip>
 #include <utility>
+#include <algorithm>
 #include <map>
 #include <vector>
 #include <string>
+#include <string.h>
+#include <stdint.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
+
+/** The number of hardware performance counters recorded for each phase */
+#define NUM_HARDWARE_COUNTERS 4
+
+
+/**
+ * @enum hardwareCounter
+ * @brief The hardware performance counters recorded for each phase.
+ */
+enum hardwareCounter {
+
+  /** The number of CPU cycles */
+  CYCLES,
+
+  /** The number of instructions retired */
+  INSTRUCTIONS,
+
+  /** The number of last level cache misses */
+  LLC_MISSES,
+
+  /** The number of packed (vector) floating point instructions retired */
+  VECTOR_INSTRUCTIONS
+};
+
+
+#ifndef SWIG
+/**
+ * @struct timerPhase
+ * @brief A phase of a calculation in the Timer's tree of nested phases.
+ */
+struct timerPhase {
+
+  /** The name of the phase */
+  std::string _name;
+
+  /** The names of the enclosing phases and this phase separated by '/' */
+  std::string _path;
+
+  /** The index of the enclosing phase (-1 for a top-level phase) */
+  int _parent;
+
+  /** The indices of the phases nested within this phase */
+  std::vector<int> _children;
+
+  /** The time (seconds) spent in the phase by each thread */
+  std::vector<double> _thread_times;
+
+  /** The number of times each thread has entered the phase */
+  std::vector<long> _thread_calls;
+
+  /** The hardware counts of each thread in the phase, indexed by thread
+   *  and then hardwareCounter */
+  std::vector<long> _thread_counters;
+};
+
+
+/**
+ * @struct runningPhase
+ * @brief A phase which a thread is running.
+ */
+struct runningPhase {
+
+  /** The index of the phase */
+  int _phase;
+
+  /** The time when the thread started the phase */
+  double _start_time;
+
+  /** The hardware counts of the thread when it started the phase */
+  long _counters[NUM_HARDWARE_COUNTERS];
+
+  /** The generation of the hardware counters which were read */
+  int _counters_generation;
+};
 #endif
 
 
 /**
  * @class Timer Timer.h "src/Timer.cpp"
  * @brief The Timer class is for timing and profiling regions of code.
+ * @details Besides the stopwatch and splits, the Timer records the time
+ *          spent in a tree of nested phases of a calculation. A phase is
+ *          started and stopped by the thread which runs it, and is nested
+ *          within the phase which that thread is currently running. A phase
+ *          started by a thread in a parallel region which is not yet running
+ *          a phase is nested within the phase that the master thread was
+ *          running when the region began, such that each thread accumulates
+ *          its own time for the phase.
+ *
+ *          Hardware performance counters may also be recorded for each
+ *          phase with Linux perf events. The counters are opened for each
+ *          thread when it first starts a phase, and count only that
+ *          thread's user space events. Counters which are not supported by
+ *          the processor or kernel (or all counters if perf events are not
+ *          permitted) are left at zero.
  */
 class Timer {
 
@@ -44,6 +142,48 @@ private:
   /** A vector of the times and messages for each split */
   static std::map<std::string, double> _timer_splits;
 
+#ifndef SWIG
+  /** The tree of phases, indexed in the order they were first started */
+  static std::vector<timerPhase> _phases;
+
+  /** The phase run by the master thread outside of parallel regions */
+  static int _master_phase;
+
+  /** The phases which this thread is running and their start times */
+  static thread_local std::vector<runningPhase> _phase_stack;
+
+  /** Whether to record hardware counters for each phase */
+  static bool _counters_on;
+
+  /** The perf event file descriptors opened by all threads */
+  static std::vector<int> _counter_fds;
+
+  /** The generation of the hardware counters, which is incremented each
+   *  time the counters of all threads are closed */
+  static int _counters_generation;
+
+  /** The generation of the hardware counters this thread has opened (-1 if
+   *  it has not opened them) */
+  static thread_local int _counters_opened;
+
+  /** The perf event file descriptor which leads this thread's counters
+   *  (-1 if no counter could be opened) */
+  static thread_local int _counter_group;
+
+  /** The position of each counter in a read of the counter group
+   *  (-1 if the counter could not be opened) */
+  static thread_local int _counter_slots[NUM_HARDWARE_COUNTERS];
+
+  int findChildPhase(int parent, const char* name);
+  int findPhase(const char* path);
+  double getInclusiveTime(int phase);
+  long getThreadCounter(int phase, int thread, int counter);
+  void printPhase(int phase, int depth, bool counters);
+  void openHardwareCounters();
+  void closeHardwareCounters();
+  void readHardwareCounters(long* counters);
+#endif
+
   /**
    * @brief Assignment operator for static referencing of the Timer.
    * @param & the Timer static class object
@@ -66,10 +206,7 @@ public:
     _elapsed_time = 0;
   }
 
-  /**
-   * @brief Destructor
-   */
-  virtual ~Timer() { }
+  virtual ~Timer();
 
   /**
    * @brief Returns a static instance of the Timer class.
@@ -88,6 +225,58 @@ public:
   void printSplits();
   void clearSplit(const char* msg);
   void clearSplits();
+
+  int startPhase(const char* name);
+  double stopPhase();
+  void stopPhases(int depth);
+  int getNumPhases();
+  const char* getPhasePath(int phase);
+  std::string getRunningPhasePath();
+  double getPhaseTime(const char* path, bool exclusive=false);
+  double getPhaseThreadTime(const char* path, int thread);
+  long getPhaseNumCalls(const char* path);
+  long getPhaseCounter(const char* path, hardwareCounter counter);
+  void printPhases();
+  void clearPhases();
+
+  void setHardwareCounters(bool counters_on);
+  bool isRecordingHardwareCounters();
+  bool isHardwareCounterAvailable(hardwareCounter counter);
+};
+
+
+#ifndef SWIG
+/**
+ * @class ScopedTimer Timer.h "src/Timer.h"
+ * @brief Times a phase of a calculation from the construction of the
+ *        ScopedTimer until it goes out of scope.
+ * @details Any phases started after the ScopedTimer which have not been
+ *          stopped (e.g., if an exception is thrown) are stopped with it.
+ */
+class ScopedTimer {
+
+private:
+
+  /** The number of phases the thread was running before this one */
+  int _depth;
+
+public:
+
+  /**
+   * @brief Constructor starts the phase.
+   * @param name the name of the phase
+   */
+  ScopedTimer(const char* name) {
+    _depth = Timer::Get()->startPhase(name);
+  }
+
+  /**
+   * @brief Destructor stops the phase.
+   */
+  ~ScopedTimer() {
+    Timer::Get()->stopPhases(_depth);
+  }
 };
+#endif
 
 #endif /* TIMER_H_ */
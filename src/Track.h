@@ -9,7 +9,6 @@
 #define TRACK_H_
 
 #ifdef __cplusplus
-#include "Python.h"
 #include "Point.h"
 #include "Material.h"
 #include <vector>
@@ -18,6 +18,9 @@ TrackGenerator::TrackGenerator(Geometry* geometry, const int num_azim,
   _contains_tracks = false;
   _use_input_file = false;
   _tracks_filename = "";
+  _FSR_volumes = NULL;
+  _track_memory = 0;
+  _FSR_memory = 0;
 }
 
 
@@ -38,6 +41,11 @@ TrackGenerator::~TrackGenerator() {
 
     delete [] _tracks;
   }
+
+  clearFSRVolumes();
+
+  MemoryTracker::Get()->release(TRACK_MEMORY, _track_memory);
+  MemoryTracker::Get()->release(GEOMETRY_MEMORY, _FSR_memory);
 }
 
 
@@ -162,8 +170,9 @@ int TrackGenerator::getNumThreads() {
 
 /**
  * @brief Computes and returns an array of volumes indexed by FSR.
- * @details Note: It is the function caller's responsibility to deallocate
- *          the memory reserved for the FSR volume array.
+ * @details The volumes are computed once and cached by the TrackGenerator.
+ *          Note: It is the function caller's responsibility to deallocate
+ *          the memory reserved for the FSR volume array which is returned.
  * @return a pointer to the array of FSR volumes
  */
 FP_PRECISION* TrackGenerator::getFSRVolumes() {
@@ -172,35 +181,18 @@ FP_PRECISION* TrackGenerator::getFSRVolumes() {
     log_printf(ERROR, "Unable to get the FSR volumes since tracks "
                "have not yet been generated");
 
+  initializeFSRVolumes();
+
   int num_FSRs = _geometry->getNumFSRs();
   FP_PRECISION* FSR_volumes = new FP_PRECISION[num_FSRs];
-  memset(FSR_volumes, 0., num_FSRs*sizeof(FP_PRECISION));
-
-  int azim_index;
-  segment* curr_segment;
-  FP_PRECISION volume;
-
-  /* Calculate each FSR's "volume" by accumulating the total length of * 
-   * all Track segments multipled by the Track "widths" for each FSR.  */
-  for (int i=0; i < _num_azim; i++) {
-    for (int j=0; j < _num_tracks[i]; j++) {
-
-      azim_index = _tracks[i][j].getAzimAngleIndex();
-
-      for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
-        curr_segment = _tracks[i][j].getSegment(s);
-        volume = curr_segment->_length * _azim_weights[azim_index];
-        FSR_volumes[curr_segment->_region_id] += volume;
-      }
-    }
-  }
+  memcpy(FSR_volumes, _FSR_volumes, num_FSRs*sizeof(FP_PRECISION));
 
   return FSR_volumes;
 }
 
 
 /**
- * @brief Computes and returns the volume of an FSR.
+ * @brief Returns the volume of an FSR.
  * @param fsr_id the ID for the FSR of interest
  * @return the FSR volume
  */
@@ -208,29 +200,15 @@ FP_PRECISION TrackGenerator::getFSRVolume(int fsr_id) {
 
   if (!containsTracks())
     log_printf(ERROR, "Unable to get the FSR %d volume since tracks "
-               "have not yet been generated");
+               "have not yet been generated", fsr_id);
 
-  else if (fsr_id < 0 || fsr_id > _geometry->getNumFSRs())
+  else if (fsr_id < 0 || fsr_id >= _geometry->getNumFSRs())
     log_printf(ERROR, "Unable to get the volume for FSR %d since the FSR IDs "
-               "lie in the range (0, %d)", fsr_id, _geometry->getNumFSRs());
+               "lie in the range (0, %d)", fsr_id, _geometry->getNumFSRs()-1);
 
-  int azim_index;
-  segment* curr_segment;
-  FP_PRECISION volume;
-
-  /* Calculate the FSR's "volume" by accumulating the total length of * 
-   * all Track segments multipled by the Track "widths" for the FSR.  */
-  for (int i=0; i < _num_azim; i++) {
-    for (int j=0; j < _num_tracks[i]; j++) {
-      for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
-        curr_segment = _tracks[i][j].getSegment(s);
-        if (curr_segment->_region_id == fsr_id)
-          volume += curr_segment->_length * _azim_weights[azim_index];
-      }
-    }
-  }
+  initializeFSRVolumes();
 
-  return volume;
+  return _FSR_volumes[fsr_id];
 }
 
 
@@ -240,26 +218,39 @@ FP_PRECISION TrackGenerator::getFSRVolume(int fsr_id) {
  */
 FP_PRECISION TrackGenerator::getMaxOpticalLength() {
 
-  segment* curr_segment;
-  FP_PRECISION length;
-  Material* material;
-  FP_PRECISION* sigma_t;
   FP_PRECISION max_optical_length = 0.;
 
-  /* Iterate over all tracks, segments, groups to find max optical length */
-  for (int i=0; i < _num_azim; i++) {
-    for (int j=0; j < _num_tracks[i]; j++) {
-      for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
+  #pragma omp parallel
+  {
+    segment* curr_segment;
+    FP_PRECISION length;
+    Material* material;
+    FP_PRECISION* sigma_t;
+    FP_PRECISION thread_max = 0.;
 
-        curr_segment = _tracks[i][j].getSegment(s);
-        length = curr_segment->_length;
-        material = curr_segment->_material;
-        sigma_t = material->getSigmaT();
+    /* Iterate over all tracks, segments, groups to find max optical length */
+    for (int i=0; i < _num_azim; i++) {
 
-        for (int e=0; e < material->getNumEnergyGroups(); e++)
-          max_optical_length = std::max(max_optical_length, length*sigma_t[e]);
+      #pragma omp for schedule(guided) nowait
+      for (int j=0; j < _num_tracks[i]; j++) {
+        for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
+
+          curr_segment = _tracks[i][j].getSegment(s);
+          length = curr_segment->_length;
+          material = curr_segment->_material;
+          sigma_t = material->getSigmaT();
+
+          for (int e=0; e < material->getNumEnergyGroups(); e++)
+            thread_max = std::max(thread_max, length*sigma_t[e]);
+        }
       }
     }
+
+    /* Reduce the maximum optical length across threads */
+    #pragma omp critical
+    {
+      max_optical_length = std::max(max_optical_length, thread_max);
+    }
   }
 
   return max_optical_length;
@@ -463,6 +454,8 @@ void TrackGenerator::retrieveSegmentCoords(double* coords, int num_segments) {
  */
 void TrackGenerator::generateTracks() {
 
+  ScopedTimer timer("generateTracks");
+
   if (_geometry == NULL)
     log_printf(ERROR, "Unable to generate Tracks since no Geometry "
                "has been set for the TrackGenerator");
@@ -478,8 +471,12 @@ void TrackGenerator::generateTracks() {
       delete [] _tracks[i];
 
     delete [] _tracks;
+    _contains_tracks = false;
   }
 
+  MemoryTracker::Get()->update(TRACK_MEMORY, _track_memory, 0);
+
+  clearFSRVolumes();
   initializeTrackFileDirectory();
 
   /* If not Tracks input file exists, generate Tracks */
@@ -519,6 +516,7 @@ void TrackGenerator::generateTracks() {
   }
 
   initializeBoundaryConditions();
+  recordMemoryUsage();
   return;
 }
 
@@ -552,15 +550,19 @@ void TrackGenerator::initializeTrackFileDirectory() {
                   << _num_azim*2.0 << "_angles_"
                   << _spacing << "_cm_spacing_cmfd_"
                   << _geometry->getCmfd()->getNumX() 
-                  << "x" << _geometry->getCmfd()->getNumY()
-                  << ".data";
+                  << "x" << _geometry->getCmfd()->getNumY();
     }
   else{
     test_filename << directory.str() << "/"
                   << _num_azim*2.0 << "_angles_"
-                  << _spacing << "_cm_spacing.data";
+                  << _spacing << "_cm_spacing";
   }
 
+  /* Files from earlier versions of OpenMOC are not named by Geometry hash */
+  std::string legacy_filename = test_filename.str() + ".data";
+
+  test_filename << "_" << std::hex << _geometry->getStructuralHash()
+                << ".data";
   _tracks_filename = test_filename.str();
 
   /* Check to see if a Track file exists for this geometry, number of azimuthal
@@ -571,6 +573,17 @@ void TrackGenerator::initializeTrackFileDirectory() {
       _contains_tracks = true;
     }
   }
+  else if ((!stat(legacy_filename.c_str(), &buffer))) {
+    std::string tracks_filename = _tracks_filename;
+    _tracks_filename = legacy_filename;
+
+    if (readTracksFromFile()) {
+      _use_input_file = true;
+      _contains_tracks = true;
+    }
+
+    _tracks_filename = tracks_filename;
+  }
 }
 
 
@@ -1076,6 +1089,8 @@ void TrackGenerator::initializeBoundaryConditions() {
  */
 void TrackGenerator::segmentize() {
 
+  ScopedTimer timer("segmentize");
+
   log_printf(NORMAL, "Ray tracing for track segmentation...");
 
   Track* track;
@@ -1101,10 +1116,49 @@ void TrackGenerator::segmentize() {
 }
 
 
+/**
+ * @brief Rounds a byte count up to the next multiple of some alignment.
+ * @param num_bytes the number of bytes
+ * @param alignment the alignment in bytes
+ * @return the aligned number of bytes
+ */
+static uint64_t track_file_align(uint64_t num_bytes, uint64_t alignment) {
+  return ((num_bytes + alignment - 1) / alignment) * alignment;
+}
+
+
+/**
+ * @brief Writes a chunk of a section to a binary Track file.
+ * @param data a pointer to the chunk of data
+ * @param num_bytes the size of the chunk (a multiple of 8 bytes)
+ * @param section the section table entry whose checksum is updated
+ * @param out the Track file
+ */
+static void track_file_write(const void* data, size_t num_bytes,
+                             track_file_section* section, FILE* out) {
+
+  if (num_bytes == 0)
+    return;
+
+  if (fwrite(data, num_bytes, 1, out) != 1)
+    log_printf(ERROR, "Unable to write %d bytes to the Track file",
+               int(num_bytes));
+
+  section->_checksum = fnv1a_checksum(data, num_bytes, section->_checksum);
+}
+
+
 /**
  * @brief Writes all Track and segment data to a "*.tracks" binary file.
  * @details Storing Tracks in a binary file saves time by eliminating ray
  *          tracing for Track segmentation in commonly simulated geometries.
+ *          The file begins with a fixed size header and a section table
+ *          which gives the offset, size and checksum of each section. Each
+ *          section is a contiguous array of fixed size records aligned to
+ *          TRACK_FILE_ALIGNMENT bytes so that the file can be memory mapped
+ *          and read without parsing it one value at a time. The records are
+ *          written in the machine's byte order, which is recorded in the
+ *          header.
  */
 void TrackGenerator::dumpTracksToFile() {
 
@@ -1115,151 +1169,204 @@ void TrackGenerator::dumpTracksToFile() {
       "been generated for %d azimuthal angles and %f track spacing",
       _num_azim, _spacing);
 
-  FILE* out;
-  out = fopen(_tracks_filename.c_str(), "w");
+  Cmfd* cmfd = _geometry->getCmfd();
 
-  /* Get a string representation of the Geometry's attributes. This is used to
-   * check whether or not ray tracing has been performed for this Geometry */
-  std::string geometry_to_string = _geometry->toString();
-  int string_length = geometry_to_string.length() + 1;
+  /* Get FSR vector maps */
+  std::unordered_map<std::size_t, fsr_data> FSR_keys_map =
+    _geometry->getFSRKeysMap();
+  std::unordered_map<std::size_t, fsr_data>::iterator iter;
+  std::vector<std::size_t> FSRs_to_keys = _geometry->getFSRsToKeys();
+  std::vector<int> FSRs_to_material_IDs = _geometry->getFSRsToMaterialIDs();
+  int num_FSRs = _geometry->getNumFSRs();
 
-  /* Write geometry metadata to the Track file */
-  fwrite(&string_length, sizeof(int), 1, out);
-  fwrite(geometry_to_string.c_str(), sizeof(char)*string_length, 1, out);
+  /* Count the Tracks and segments */
+  uint64_t num_tracks = 0;
+  uint64_t num_segments = 0;
+  for (int i=0; i < _num_azim; i++) {
+    num_tracks += _num_tracks[i];
+    for (int j=0; j < _num_tracks[i]; j++)
+      num_segments += _tracks[i][j].getNumSegments();
+  }
 
-  /* Write ray tracing metadata to the Track file */
-  fwrite(&_num_azim, sizeof(int), 1, out);
-  fwrite(&_spacing, sizeof(double), 1, out);
-  fwrite(_num_tracks, sizeof(int), _num_azim, out);
-  fwrite(_num_x, sizeof(int), _num_azim, out);
-  fwrite(_num_y, sizeof(int), _num_azim, out);
+  /* Count the CMFD cells and the FSRs within them */
+  std::vector< std::vector<int> > cell_fsrs;
+  uint64_t num_cell_fsrs = 0;
+  if (cmfd != NULL) {
+    cell_fsrs = cmfd->getCellFSRs();
+    for (size_t cell=0; cell < cell_fsrs.size(); cell++)
+      num_cell_fsrs += cell_fsrs.at(cell).size();
+  }
 
-  /* Write the azimuthal angle quadrature weights to the Track file */
-  double* azim_weights = new double[_num_azim];
-  for (int i=0; i < _num_azim; i++)
-    azim_weights[i] = _azim_weights[i];
-  fwrite(azim_weights, sizeof(double), _num_azim, out);
-  free(azim_weights);
+  /* Initialize the section table */
+  int num_sections = (cmfd != NULL) ? CMFD_CELL_FSRS+1 : FSR_DATA+1;
+  track_file_section sections[CMFD_CELL_FSRS+1];
+  uint64_t record_sizes[CMFD_CELL_FSRS+1] =
+    {sizeof(azim_record), sizeof(track_record), sizeof(segment_record),
+     sizeof(fsr_record), sizeof(int32_t), sizeof(int32_t)};
+  uint64_t num_records[CMFD_CELL_FSRS+1] =
+    {uint64_t(_num_azim), num_tracks, num_segments, uint64_t(num_FSRs),
+     cell_fsrs.size(), num_cell_fsrs};
+
+  uint64_t offset = sizeof(track_file_header) +
+                    num_sections * sizeof(track_file_section);
+
+  for (int i=0; i < num_sections; i++) {
+    offset = track_file_align(offset, TRACK_FILE_ALIGNMENT);
+    sections[i]._type = i;
+    sections[i]._record_size = record_sizes[i];
+    sections[i]._offset = offset;
+    sections[i]._num_records = num_records[i];
+    sections[i]._num_bytes = track_file_align(record_sizes[i] * num_records[i],
+                                              sizeof(uint64_t));
+    sections[i]._checksum = fnv1a_checksum(NULL, 0);
+    offset += sections[i]._num_bytes;
+  }
 
-  Track* curr_track;
-  double x0, y0, x1, y1;
-  double phi;
-  int azim_angle_index;
-  int num_segments;
-  std::vector<segment*> _segments;
-  Cmfd* cmfd = _geometry->getCmfd();
+  FILE* out;
+  out = fopen(_tracks_filename.c_str(), "wb");
 
-  segment* curr_segment;
-  double length;
-  int material_id;
-  int region_id;
-  int cmfd_surface_fwd;
-  int cmfd_surface_bwd;
+  if (out == NULL) {
+    log_printf(WARNING, "Unable to open Track file %s for writing",
+               _tracks_filename.c_str());
+    return;
+  }
 
-  /* Loop over all Tracks */
+  /* Write the number of Tracks and quadrature weight for each angle */
+  std::vector<azim_record> azim_records(_num_azim);
   for (int i=0; i < _num_azim; i++) {
-    for (int j=0; j < _num_tracks[i]; j++) {
+    azim_records[i]._num_tracks = _num_tracks[i];
+    azim_records[i]._num_x = _num_x[i];
+    azim_records[i]._num_y = _num_y[i];
+    azim_records[i]._padding = 0;
+    azim_records[i]._azim_weight = _azim_weights[i];
+  }
 
-      /* Get data for this Track */
-      curr_track = &_tracks[i][j];
-      x0 = curr_track->getStart()->getX();
-      y0 = curr_track->getStart()->getY();
-      x1 = curr_track->getEnd()->getX();
-      y1 = curr_track->getEnd()->getY();
-      phi = curr_track->getPhi();
-      azim_angle_index = curr_track->getAzimAngleIndex();
-      num_segments = curr_track->getNumSegments();
-
-      /* Write data for this Track to the Track file */
-      fwrite(&x0, sizeof(double), 1, out);
-      fwrite(&y0, sizeof(double), 1, out);
-      fwrite(&x1, sizeof(double), 1, out);
-      fwrite(&y1, sizeof(double), 1, out);
-      fwrite(&phi, sizeof(double), 1, out);
-      fwrite(&azim_angle_index, sizeof(int), 1, out);
-      fwrite(&num_segments, sizeof(int), 1, out);
-
-      /* Loop over all segments for this Track */
-      for (int s=0; s < num_segments; s++) {
+  fseek(out, sections[AZIM_DATA]._offset, SEEK_SET);
+  track_file_write(azim_records.data(), sections[AZIM_DATA]._num_bytes,
+                   &sections[AZIM_DATA], out);
 
-        /* Get data for this segment */
-        curr_segment = curr_track->getSegment(s);
-        length = curr_segment->_length;
-        material_id = curr_segment->_material->getId();
-        region_id = curr_segment->_region_id;
+  /* Write the Tracks one azimuthal angle at a time */
+  std::vector<track_record> track_records;
+  uint64_t first_segment = 0;
+  Track* curr_track;
 
-        /* Write data for this segment to the Track file */
-        fwrite(&length, sizeof(double), 1, out);
-        fwrite(&material_id, sizeof(int), 1, out);
-        fwrite(&region_id, sizeof(int), 1, out);
+  fseek(out, sections[TRACK_DATA]._offset, SEEK_SET);
 
-        /* Write CMFD-related data for the Track if needed */
-        if (cmfd != NULL){
-          cmfd_surface_fwd = curr_segment->_cmfd_surface_fwd;
-          cmfd_surface_bwd = curr_segment->_cmfd_surface_bwd;
-          fwrite(&cmfd_surface_fwd, sizeof(int), 1, out);
-          fwrite(&cmfd_surface_bwd, sizeof(int), 1, out);
-        }
-      }
+  for (int i=0; i < _num_azim; i++) {
+
+    track_records.resize(_num_tracks[i]);
+
+    for (int j=0; j < _num_tracks[i]; j++) {
+      curr_track = &_tracks[i][j];
+      track_records[j]._x0 = curr_track->getStart()->getX();
+      track_records[j]._y0 = curr_track->getStart()->getY();
+      track_records[j]._x1 = curr_track->getEnd()->getX();
+      track_records[j]._y1 = curr_track->getEnd()->getY();
+      track_records[j]._phi = curr_track->getPhi();
+      track_records[j]._azim_index = curr_track->getAzimAngleIndex();
+      track_records[j]._num_segments = curr_track->getNumSegments();
+      track_records[j]._first_segment = first_segment;
+      first_segment += curr_track->getNumSegments();
     }
+
+    track_file_write(track_records.data(),
+                     _num_tracks[i] * sizeof(track_record),
+                     &sections[TRACK_DATA], out);
   }
 
-  /* Get FSR vector maps */
-  std::unordered_map<std::size_t, fsr_data> FSR_keys_map = _geometry->getFSRKeysMap();
-  std::unordered_map<std::size_t, fsr_data>::iterator iter;
-  std::vector<std::size_t> FSRs_to_keys = _geometry->getFSRsToKeys();
-  std::vector<int> FSRs_to_material_IDs = _geometry->getFSRsToMaterialIDs();
-  std::size_t fsr_key;
-  int fsr_id;
-  int fsr_counter = 0;
-  double x, y;
+  /* Write the segments one Track at a time */
+  std::vector<segment_record> segment_records;
+  segment* segments;
+  int num_track_segments;
 
-  /* Write number of FSRs */
-  int num_FSRs = _geometry->getNumFSRs();
-  fwrite(&num_FSRs, sizeof(int), 1, out);
+  fseek(out, sections[SEGMENT_DATA]._offset, SEEK_SET);
 
-  /* Write FSR vector maps to file */
-  for (iter = FSR_keys_map.begin(); iter != FSR_keys_map.end(); ++iter){
+  for (int i=0; i < _num_azim; i++) {
+    for (int j=0; j < _num_tracks[i]; j++) {
 
-    /* Write data to file from FSR_keys_map */
-    fsr_key = iter->first;
-    fsr_id = iter->second._fsr_id;
-    x = iter->second._point->getX();
-    y = iter->second._point->getY();
-    fwrite(&fsr_key, sizeof(std::size_t), 1, out);
-    fwrite(&fsr_id, sizeof(int), 1, out);
-    fwrite(&x, sizeof(double), 1, out);
-    fwrite(&y, sizeof(double), 1, out);
+      num_track_segments = _tracks[i][j].getNumSegments();
+      segments = _tracks[i][j].getSegments();
+      segment_records.resize(num_track_segments);
+
+      for (int s=0; s < num_track_segments; s++) {
+        segment_records[s]._length = segments[s]._length;
+        segment_records[s]._material_id = segments[s]._material->getId();
+        segment_records[s]._region_id = segments[s]._region_id;
+        segment_records[s]._cmfd_surface_fwd = segments[s]._cmfd_surface_fwd;
+        segment_records[s]._cmfd_surface_bwd = segments[s]._cmfd_surface_bwd;
+      }
 
-    /* Write data to file from FSRs_to_material_IDs */
-    fwrite(&(FSRs_to_material_IDs.at(fsr_counter)), sizeof(int), 1, out);
+      track_file_write(segment_records.data(),
+                       num_track_segments * sizeof(segment_record),
+                       &sections[SEGMENT_DATA], out);
+    }
+  }
 
-    /* Write data to file from FSRs_to_keys */
-    fwrite(&(FSRs_to_keys.at(fsr_counter)), sizeof(std::size_t), 1, out);
+  /* Write the FSR vector maps */
+  std::vector<fsr_record> fsr_records(num_FSRs);
+  int fsr_counter = 0;
 
-    /* Increment FSR ID counter */
+  for (iter = FSR_keys_map.begin(); iter != FSR_keys_map.end(); ++iter) {
+    fsr_records[fsr_counter]._key = iter->first;
+    fsr_records[fsr_counter]._fsr_id = iter->second._fsr_id;
+    fsr_records[fsr_counter]._x = iter->second._point->getX();
+    fsr_records[fsr_counter]._y = iter->second._point->getY();
+    fsr_records[fsr_counter]._material_id =
+      FSRs_to_material_IDs.at(fsr_counter);
+    fsr_records[fsr_counter]._FSR_to_key = FSRs_to_keys.at(fsr_counter);
     fsr_counter++;
   }
 
-  /* Write cmfd_fsrs vector of vectors to file */
-  if (cmfd != NULL){
-    std::vector< std::vector<int> > cell_fsrs = cmfd->getCellFSRs();
-    std::vector<int>::iterator iter;
-    int num_cells = cmfd->getNumCells();
-    fwrite(&num_cells, sizeof(int), 1, out);
+  fseek(out, sections[FSR_DATA]._offset, SEEK_SET);
+  track_file_write(fsr_records.data(), sections[FSR_DATA]._num_bytes,
+                   &sections[FSR_DATA], out);
 
-    /* Loop over CMFD cells */
-    for (int cell=0; cell < num_cells; cell++){
-      num_FSRs = cell_fsrs.at(cell).size();
-      fwrite(&num_FSRs, sizeof(int), 1, out);
+  /* Write the CMFD cell sizes and the FSR IDs in each cell */
+  if (cmfd != NULL) {
 
-      /* Loop over FSRs within cell */
-      for (iter = cell_fsrs.at(cell).begin(); iter != cell_fsrs.at(cell).end();
-          ++iter)
-        fwrite(&(*iter), sizeof(int), 1, out);
+    std::vector<int32_t> cell_sizes(sections[CMFD_CELL_SIZES]._num_bytes /
+                                    sizeof(int32_t), 0);
+    std::vector<int32_t> cell_fsr_ids(sections[CMFD_CELL_FSRS]._num_bytes /
+                                      sizeof(int32_t), 0);
+    int index = 0;
+
+    for (size_t cell=0; cell < cell_fsrs.size(); cell++) {
+      cell_sizes[cell] = cell_fsrs.at(cell).size();
+      for (size_t r=0; r < cell_fsrs.at(cell).size(); r++)
+        cell_fsr_ids[index++] = cell_fsrs.at(cell).at(r);
     }
+
+    fseek(out, sections[CMFD_CELL_SIZES]._offset, SEEK_SET);
+    track_file_write(cell_sizes.data(), sections[CMFD_CELL_SIZES]._num_bytes,
+                     &sections[CMFD_CELL_SIZES], out);
+
+    fseek(out, sections[CMFD_CELL_FSRS]._offset, SEEK_SET);
+    track_file_write(cell_fsr_ids.data(), sections[CMFD_CELL_FSRS]._num_bytes,
+                     &sections[CMFD_CELL_FSRS], out);
   }
 
+  /* Write the header and section table last since they need the checksums */
+  track_file_header header;
+  memset(&header, 0, sizeof(track_file_header));
+  strncpy(header._magic, TRACK_FILE_MAGIC, sizeof(header._magic));
+  header._byte_order = TRACK_FILE_BYTE_ORDER;
+  header._version = TRACK_FILE_VERSION;
+  header._num_sections = num_sections;
+  header._file_size = offset;
+  header._num_azim = _num_azim;
+  header._num_FSRs = num_FSRs;
+  header._spacing = _spacing;
+  header._geometry_hash = _geometry->getStructuralHash();
+  header._material_hash = _geometry->getMaterialHash();
+  header._num_tracks = num_tracks;
+  header._num_segments = num_segments;
+  header._checksum = fnv1a_checksum(sections,
+                     num_sections * sizeof(track_file_section));
+
+  fseek(out, 0, SEEK_SET);
+  fwrite(&header, sizeof(track_file_header), 1, out);
+  fwrite(sections, sizeof(track_file_section), num_sections, out);
+
   /* Close the Track file */
   fclose(out);
 
@@ -1274,12 +1381,341 @@ void TrackGenerator::dumpTracksToFile() {
 
 /**
  * @brief Reads Tracks in from a "*.tracks" binary file.
- * @details Storing Tracks in a binary file saves time by eliminating ray
- *          tracing for Track segmentation in commonly simulated geometries.
+ * @details This checks the start of the file for the versioned format
+ *          written by TrackGenerator::dumpTracksToFile() and otherwise
+ *          falls back to the legacy format of earlier OpenMOC versions.
  * @return true if able to read Tracks in from a file; false otherwise
  */
 bool TrackGenerator::readTracksFromFile() {
 
+  char magic[8];
+  FILE* in;
+  in = fopen(_tracks_filename.c_str(), "rb");
+
+  if (in == NULL)
+    return false;
+
+  size_t num_read = fread(magic, sizeof(char), sizeof(magic), in);
+  fclose(in);
+
+  if (num_read == sizeof(magic) &&
+      strncmp(magic, TRACK_FILE_MAGIC, sizeof(magic)) == 0)
+    return readMappedTracksFromFile();
+  else
+    return readLegacyTracksFromFile();
+}
+
+
+/**
+ * @brief Reads Tracks in from a memory mapped versioned binary Track file.
+ * @details The file is mapped read-only and the header, section table and
+ *          section checksums are validated before any data is used. The
+ *          Tracks and their segments are then built in parallel directly
+ *          from the contiguous records in the mapped file. Files with an
+ *          unsupported version, a different byte order or a bad checksum are
+ *          rejected so that the Tracks are regenerated.
+ * @return true if able to read Tracks in from the file; false otherwise
+ */
+bool TrackGenerator::readMappedTracksFromFile() {
+
+  int fd = open(_tracks_filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(track_file_header)) {
+    close(fd);
+    return false;
+  }
+
+  size_t file_size = st.st_size;
+  void* map = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if (map == MAP_FAILED) {
+    log_printf(WARNING, "Unable to memory map Track file %s",
+               _tracks_filename.c_str());
+    return false;
+  }
+
+  char* base = (char*) map;
+  track_file_header* header = (track_file_header*) base;
+  track_file_section* table = (track_file_section*)
+                              (base + sizeof(track_file_header));
+  track_file_section* sections[CMFD_CELL_FSRS+1] = {NULL};
+  uint64_t record_sizes[CMFD_CELL_FSRS+1] =
+    {sizeof(azim_record), sizeof(track_record), sizeof(segment_record),
+     sizeof(fsr_record), sizeof(int32_t), sizeof(int32_t)};
+  Cmfd* cmfd = _geometry->getCmfd();
+  const char* error = NULL;
+
+  /* Validate the header and section table */
+  if (header->_byte_order == 0x04030201)
+    error = "a different byte order from this machine";
+  else if (header->_byte_order != TRACK_FILE_BYTE_ORDER ||
+           header->_version != TRACK_FILE_VERSION)
+    error = "an unsupported file format version";
+  else if (header->_file_size != file_size)
+    error = "an incorrect file size";
+  else if (header->_num_sections > CMFD_CELL_FSRS+1 ||
+           sizeof(track_file_header) + header->_num_sections *
+           sizeof(track_file_section) > file_size)
+    error = "a corrupt section table";
+  else if (fnv1a_checksum(table, header->_num_sections *
+           sizeof(track_file_section)) != header->_checksum)
+    error = "a section table checksum mismatch";
+
+  /* Validate each section */
+  for (uint32_t i=0; i < header->_num_sections && error == NULL; i++) {
+    if (table[i]._type > CMFD_CELL_FSRS ||
+        table[i]._record_size != record_sizes[table[i]._type] ||
+        table[i]._offset % TRACK_FILE_ALIGNMENT != 0 ||
+        table[i]._offset + table[i]._num_bytes > file_size ||
+        table[i]._num_records * table[i]._record_size > table[i]._num_bytes)
+      error = "a corrupt section table";
+    else if (fnv1a_checksum(base + table[i]._offset, table[i]._num_bytes)
+             != table[i]._checksum)
+      error = "a section checksum mismatch";
+    else
+      sections[table[i]._type] = &table[i];
+  }
+
+  if (error == NULL) {
+    for (int i=0; i <= FSR_DATA; i++) {
+      if (sections[i] == NULL)
+        error = "a missing section";
+    }
+    if (cmfd != NULL &&
+        (sections[CMFD_CELL_SIZES] == NULL || sections[CMFD_CELL_FSRS] == NULL))
+      error = "missing CMFD data";
+  }
+
+  if (error != NULL) {
+    log_printf(WARNING, "Unable to import ray tracing data from %s due to %s",
+               _tracks_filename.c_str(), error);
+    munmap(map, file_size);
+    return false;
+  }
+
+  /* Check if our Geometry has the same structure as the Geometry in the
+   * Track file for this number of azimuthal angles and track spacing */
+  if (header->_geometry_hash != _geometry->getStructuralHash()) {
+    munmap(map, file_size);
+    return false;
+  }
+
+  bool same_materials =
+    (header->_material_hash == _geometry->getMaterialHash());
+
+  azim_record* azim_records = (azim_record*)
+                              (base + sections[AZIM_DATA]->_offset);
+  track_record* track_records = (track_record*)
+                                (base + sections[TRACK_DATA]->_offset);
+  segment_record* segment_records = (segment_record*)
+                                    (base + sections[SEGMENT_DATA]->_offset);
+  fsr_record* fsr_records = (fsr_record*)
+                            (base + sections[FSR_DATA]->_offset);
+  uint64_t num_tracks = sections[TRACK_DATA]->_num_records;
+  uint64_t num_segments = sections[SEGMENT_DATA]->_num_records;
+
+  /* Check that each Track's segments lie within the segment section */
+  bool valid = (sections[AZIM_DATA]->_num_records == uint64_t(header->_num_azim)
+                && num_tracks == header->_num_tracks
+                && num_segments == header->_num_segments
+                && sections[FSR_DATA]->_num_records ==
+                uint64_t(header->_num_FSRs));
+  uint64_t track_count = 0;
+
+  for (int i=0; i < header->_num_azim && valid; i++)
+    track_count += azim_records[i]._num_tracks;
+
+  valid = valid && (track_count == num_tracks);
+
+  for (uint64_t t=0; t < num_tracks && valid; t++)
+    valid = (track_records[t]._num_segments >= 0 &&
+             track_records[t]._first_segment +
+             track_records[t]._num_segments <= num_segments);
+
+  if (!valid) {
+    log_printf(WARNING, "Unable to import ray tracing data from %s due to "
+               "inconsistent Track data", _tracks_filename.c_str());
+    munmap(map, file_size);
+    return false;
+  }
+
+  /* Check that the FSRs of each CMFD cell lie within the cell_fsrs section */
+  if (cmfd != NULL) {
+
+    int32_t* cell_sizes = (int32_t*)
+                          (base + sections[CMFD_CELL_SIZES]->_offset);
+    int32_t* cell_fsr_ids = (int32_t*)
+                            (base + sections[CMFD_CELL_FSRS]->_offset);
+    uint64_t num_cell_fsrs = sections[CMFD_CELL_FSRS]->_num_records;
+    uint64_t cell_fsr_count = 0;
+
+    valid = (sections[CMFD_CELL_SIZES]->_num_records ==
+             uint64_t(cmfd->getNumX()) * cmfd->getNumY());
+
+    for (uint64_t cell=0; cell < sections[CMFD_CELL_SIZES]->_num_records &&
+         valid; cell++) {
+      valid = (cell_sizes[cell] >= 0);
+      cell_fsr_count += cell_sizes[cell];
+    }
+
+    valid = valid && (cell_fsr_count == num_cell_fsrs);
+
+    for (uint64_t i=0; i < num_cell_fsrs && valid; i++)
+      valid = (cell_fsr_ids[i] >= 0 && cell_fsr_ids[i] < header->_num_FSRs);
+
+    if (!valid) {
+      log_printf(WARNING, "Unable to import ray tracing data from %s due to "
+                 "inconsistent CMFD data", _tracks_filename.c_str());
+      munmap(map, file_size);
+      return false;
+    }
+  }
+
+  /* Check that the Tracks fit in the memory budget before building them */
+  MemoryTracker* tracker = MemoryTracker::Get();
+  size_t track_memory = header->_num_tracks * sizeof(Track) +
+                        header->_num_segments * sizeof(segment);
+
+  if (!tracker->fitsBudget(track_memory)) {
+    munmap(map, file_size);
+    log_printf(ERROR, "Unable to import %.1f MB of Tracks and segments from "
+               "%s since the %.1f MB in use would exceed the memory budget "
+               "of %.1f MB. Use a larger track spacing or fewer azimuthal "
+               "angles.", track_memory / 1.E6, _tracks_filename.c_str(),
+               tracker->getTotalUsage() / 1.E6, tracker->getBudget() / 1.E6);
+  }
+
+  log_printf(NORMAL, "Importing ray tracing data from file...");
+
+  /* Import ray tracing metadata from the Track file */
+  _num_azim = header->_num_azim;
+  _spacing = header->_spacing;
+
+  /* Initialize data structures for Tracks */
+  _num_tracks = new int[_num_azim];
+  _num_x = new int[_num_azim];
+  _num_y = new int[_num_azim];
+  _azim_weights = new FP_PRECISION[_num_azim];
+  _tracks = new Track*[_num_azim];
+
+  for (int i=0; i < _num_azim; i++) {
+    _num_tracks[i] = azim_records[i]._num_tracks;
+    _num_x[i] = azim_records[i]._num_x;
+    _num_y[i] = azim_records[i]._num_y;
+    _azim_weights[i] = azim_records[i]._azim_weight;
+  }
+
+  std::map<int, Material*> materials = _geometry->getAllMaterials();
+  int first_track = 0;
+
+  /* Build the Tracks and their segments from the mapped records */
+  for (int i=0; i < _num_azim; i++) {
+
+    _tracks[i] = new Track[_num_tracks[i]];
+
+    #pragma omp parallel for schedule(guided)
+    for (int j=0; j < _num_tracks[i]; j++) {
+
+      track_record* record = &track_records[first_track+j];
+      segment_record* curr_record;
+      std::map<int, Material*>::iterator material;
+      Track* curr_track = &_tracks[i][j];
+      segment curr_segment;
+
+      curr_track->setValues(record->_x0, record->_y0, record->_x1,
+                            record->_y1, record->_phi);
+      curr_track->setUid(first_track+j);
+      curr_track->setAzimAngleIndex(record->_azim_index);
+
+      for (int s=0; s < record->_num_segments; s++) {
+
+        curr_record = &segment_records[record->_first_segment+s];
+        material = materials.find(curr_record->_material_id);
+
+        curr_segment._length = curr_record->_length;
+        curr_segment._material = (material != materials.end()) ?
+                                 material->second : NULL;
+        curr_segment._region_id = curr_record->_region_id;
+        curr_segment._cmfd_surface_fwd = curr_record->_cmfd_surface_fwd;
+        curr_segment._cmfd_surface_bwd = curr_record->_cmfd_surface_bwd;
+
+        curr_track->addSegment(&curr_segment);
+      }
+    }
+
+    first_track += _num_tracks[i];
+  }
+
+  /* Create FSR vector maps */
+  std::unordered_map<std::size_t, fsr_data> FSR_keys_map;
+  std::vector<int> FSRs_to_material_IDs(header->_num_FSRs);
+  std::vector<std::size_t> FSRs_to_keys(header->_num_FSRs);
+
+  _geometry->setNumFSRs(header->_num_FSRs);
+
+  for (int r=0; r < header->_num_FSRs; r++) {
+    fsr_data fsr;
+    fsr._fsr_id = fsr_records[r]._fsr_id;
+    fsr._point = new Point();
+    fsr._point->setCoords(fsr_records[r]._x, fsr_records[r]._y);
+    FSR_keys_map[fsr_records[r]._key] = fsr;
+    FSRs_to_material_IDs[r] = fsr_records[r]._material_id;
+    FSRs_to_keys[r] = fsr_records[r]._FSR_to_key;
+  }
+
+  /* Set FSR vector maps */
+  _geometry->setFSRKeysMap(FSR_keys_map);
+  _geometry->setFSRsToMaterialIDs(FSRs_to_material_IDs);
+  _geometry->setFSRsToKeys(FSRs_to_keys);
+
+  /* Read CMFD cell_fsrs vector of vectors from the file */
+  if (cmfd != NULL) {
+
+    int32_t* cell_sizes = (int32_t*)
+                          (base + sections[CMFD_CELL_SIZES]->_offset);
+    int32_t* cell_fsr_ids = (int32_t*)
+                            (base + sections[CMFD_CELL_FSRS]->_offset);
+    int num_cells = sections[CMFD_CELL_SIZES]->_num_records;
+    std::vector< std::vector<int> > cell_fsrs(num_cells);
+    uint64_t index = 0;
+
+    for (int cell=0; cell < num_cells; cell++) {
+      cell_fsrs.at(cell).assign(cell_fsr_ids + index,
+                                cell_fsr_ids + index + cell_sizes[cell]);
+      index += cell_sizes[cell];
+    }
+
+    cmfd->setCellFSRs(cell_fsrs);
+  }
+
+  munmap(map, file_size);
+
+  /* Inform the rest of the class methods that Tracks have been initialized */
+  _contains_tracks = true;
+
+  /* The ray tracing data is still valid if only the Materials filling the
+   * Cells have changed, but the FSR and segment Materials must be updated */
+  if (!same_materials) {
+    log_printf(NORMAL, "Updating Materials for ray tracing data from file...");
+    resetFSRMaterials();
+  }
+
+  return true;
+}
+
+
+/**
+ * @brief Reads Tracks in from a legacy "*.tracks" binary file.
+ * @details This reads Track files written by earlier versions of OpenMOC
+ *          which store each value with a separate call to fwrite.
+ * @return true if able to read Tracks in from a file; false otherwise
+ */
+bool TrackGenerator::readLegacyTracksFromFile() {
+
   /* Deletes Tracks arrays if tracks have been generated */
   if (_contains_tracks) {
     delete [] _num_tracks;
@@ -1295,7 +1731,7 @@ bool TrackGenerator::readTracksFromFile() {
 
   int ret;
   FILE* in;
-  in = fopen(_tracks_filename.c_str(), "r");
+  in = fopen(_tracks_filename.c_str(), "rb");
 
   int string_length;
 
@@ -1306,8 +1742,11 @@ bool TrackGenerator::readTracksFromFile() {
 
   /* Check if our Geometry is exactly the same as the Geometry in the
    * Track file for this number of azimuthal angles and track spacing */
-  if (_geometry->toString().compare(std::string(geometry_to_string)) != 0)
+  if (_geometry->toString().compare(std::string(geometry_to_string)) != 0) {
+    delete [] geometry_to_string;
+    fclose(in);
     return false;
+  }
 
   delete [] geometry_to_string;
 
@@ -1482,6 +1921,123 @@ bool TrackGenerator::readTracksFromFile() {
 }
 
 
+/**
+ * @brief Computes and caches the volume of each FSR from the Track segments.
+ * @details Each FSR's "volume" is the total length of all Track segments
+ *          in the FSR multiplied by the Track "widths". Each thread tallies
+ *          into its own array of volumes which are then reduced, so no
+ *          atomics are needed. This is a no-op if the volumes are cached.
+ */
+void TrackGenerator::initializeFSRVolumes() {
+
+  if (_FSR_volumes != NULL)
+    return;
+
+  int num_FSRs = _geometry->getNumFSRs();
+  int num_threads = omp_get_max_threads();
+  FP_PRECISION* thread_volumes = NULL;
+
+  try {
+    _FSR_volumes = new FP_PRECISION[num_FSRs];
+    thread_volumes = new FP_PRECISION[num_threads * num_FSRs];
+  }
+  catch (std::exception &e) {
+    log_printf(ERROR, "Unable to allocate memory for the FSR volumes");
+  }
+
+  memset(thread_volumes, 0, num_threads * num_FSRs * sizeof(FP_PRECISION));
+
+  #pragma omp parallel
+  {
+    int tid = omp_get_thread_num();
+    FP_PRECISION* volumes = &thread_volumes[tid*num_FSRs];
+    segment* curr_segment;
+    FP_PRECISION weight;
+
+    for (int i=0; i < _num_azim; i++) {
+
+      #pragma omp for schedule(guided) nowait
+      for (int j=0; j < _num_tracks[i]; j++) {
+
+        weight = _azim_weights[_tracks[i][j].getAzimAngleIndex()];
+
+        for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
+          curr_segment = _tracks[i][j].getSegment(s);
+          volumes[curr_segment->_region_id] += curr_segment->_length * weight;
+        }
+      }
+    }
+
+    /* Wait for all threads to finish tallying before the reduction */
+    #pragma omp barrier
+
+    /* Reduce the thread-local volumes into the cached array */
+    #pragma omp for schedule(static)
+    for (int r=0; r < num_FSRs; r++) {
+      _FSR_volumes[r] = 0.;
+      for (int t=0; t < num_threads; t++)
+        _FSR_volumes[r] += thread_volumes[t*num_FSRs+r];
+    }
+  }
+
+  delete [] thread_volumes;
+}
+
+
+/**
+ * @brief Deletes the cached FSR volumes so they are recomputed on demand.
+ * @details This is called whenever the Tracks or segment lengths change.
+ */
+void TrackGenerator::clearFSRVolumes() {
+
+  if (_FSR_volumes != NULL)
+    delete [] _FSR_volumes;
+
+  _FSR_volumes = NULL;
+}
+
+
+/**
+ * @brief Updates the Material of each FSR and segment from the Geometry.
+ * @details This is used when Tracks are imported from a file generated for
+ *          a Geometry with the same structure but with different Materials
+ *          filling some Cells. The Cell containing each FSR is found from
+ *          the FSR's characteristic point.
+ */
+void TrackGenerator::resetFSRMaterials() {
+
+  int num_FSRs = _geometry->getNumFSRs();
+  std::vector<int> FSRs_to_material_IDs(num_FSRs);
+  std::vector<Material*> FSR_materials(num_FSRs);
+  Cell* cell;
+
+  for (int r=0; r < num_FSRs; r++) {
+    cell = _geometry->findCellContainingFSR(r);
+
+    if (cell == NULL || cell->getType() != MATERIAL)
+      log_printf(ERROR, "Unable to find the Material for FSR %d", r);
+
+    FSR_materials[r] = cell->getFillMaterial();
+    FSRs_to_material_IDs[r] = FSR_materials[r]->getId();
+  }
+
+  _geometry->setFSRsToMaterialIDs(FSRs_to_material_IDs);
+
+  /* Update the Material of each segment from its FSR */
+  for (int i=0; i < _num_azim; i++) {
+
+    #pragma omp parallel for schedule(guided)
+    for (int j=0; j < _num_tracks[i]; j++) {
+
+      segment* segments = _tracks[i][j].getSegments();
+
+      for (int s=0; s < _tracks[i][j].getNumSegments(); s++)
+        segments[s]._material = FSR_materials[segments[s]._region_id];
+    }
+  }
+}
+
+
 /**
  * @brief Assign a correct volume for some FSR.
  * @details This routine adjusts the length of each track segment crossing
@@ -1550,6 +2106,9 @@ void TrackGenerator::correctFSRVolume(int fsr_id, FP_PRECISION fsr_volume) {
       }
     }
   }
+
+  /* The segment lengths have changed so the cached volumes are stale */
+  clearFSRVolumes();
 }
 
 
@@ -1567,63 +2126,201 @@ void TrackGenerator::splitSegments(FP_PRECISION max_optical_length) {
     log_printf(ERROR, "Unable to split segments since "
 	       "tracks have not yet been generated");
 
-  int num_cuts, min_num_cuts;
-  segment* curr_segment;
-
-  FP_PRECISION length, tau;
-  int fsr_id;
-  Material* material;
-  FP_PRECISION* sigma_t;
-  int num_groups;
-
   /* Iterate over all Tracks */
   for (int i=0; i < _num_azim; i++) {
+
+    #pragma omp parallel for schedule(guided)
     for (int j=0; j < _num_tracks[i]; j++) {
-      for (int s=0; s < _tracks[i][j].getNumSegments(); s+=min_num_cuts) {
-
-        /* Extract data from this segment to compute it optical length */
-        curr_segment = _tracks[i][j].getSegment(s);
-        material = curr_segment->_material;
-        length = curr_segment->_length;
-        fsr_id = curr_segment->_region_id;
-        
-        /* Compute number of segments to split this segment into */
-        min_num_cuts = 1;
-        num_groups = material->getNumEnergyGroups();
+
+      Track* track = &_tracks[i][j];
+      int num_segments = track->getNumSegments();
+      segment* segments = track->getSegments();
+      std::vector<int> num_cuts(num_segments, 1);
+      int num_new_segments = 0;
+
+      FP_PRECISION length;
+      Material* material;
+      FP_PRECISION* sigma_t;
+
+      /* First pass: compute number of sub-segments for each segment */
+      for (int s=0; s < num_segments; s++) {
+
+        material = segments[s]._material;
+        length = segments[s]._length;
         sigma_t = material->getSigmaT();
 
-        for (int g=0; g < num_groups; g++) {
-          tau = length * sigma_t[g];
-          num_cuts = ceil(tau / max_optical_length);
-          min_num_cuts = std::max(num_cuts, min_num_cuts);
+        for (int g=0; g < material->getNumEnergyGroups(); g++) {
+          int cuts = ceil(length * sigma_t[g] / max_optical_length);
+          num_cuts[s] = std::max(num_cuts[s], cuts);
         }
 
-        /* If the segment does not need subdivisions, go to next segment */
-        if (min_num_cuts == 1)
-          continue;
+        num_new_segments += num_cuts[s];
+      }
+
+      /* If no segment needs subdivisions, go to next Track */
+      if (num_new_segments == num_segments)
+        continue;
+
+      /* Second pass: fill a new segment array with the sub-segments */
+      std::vector<segment> new_segments(num_new_segments);
+      int index = 0;
 
-        /* Split the segment into sub-segments */
-        for (int k=0; k < min_num_cuts; k++) {
+      for (int s=0; s < num_segments; s++) {
+        for (int k=0; k < num_cuts[s]; k++) {
 
-          /* Create a new Track segment */
-          segment* new_segment = new segment;
-          new_segment->_material = material;
-          new_segment->_length = length / FP_PRECISION(min_num_cuts);
-          new_segment->_region_id = fsr_id;
+          segment* new_segment = &new_segments[index++];
+          new_segment->_material = segments[s]._material;
+          new_segment->_length = segments[s]._length / num_cuts[s];
+          new_segment->_region_id = segments[s]._region_id;
 
           /* Assign CMFD surface boundaries */
           if (k == 0)
-            new_segment->_cmfd_surface_bwd = curr_segment->_cmfd_surface_bwd;
+            new_segment->_cmfd_surface_bwd = segments[s]._cmfd_surface_bwd;
 
-          if (k == min_num_cuts-1)
-            new_segment->_cmfd_surface_fwd = curr_segment->_cmfd_surface_fwd;
-
-          /* Insert the new segment to the Track */
-          _tracks[i][j].insertSegment(s+k+1, new_segment);
+          if (k == num_cuts[s]-1)
+            new_segment->_cmfd_surface_fwd = segments[s]._cmfd_surface_fwd;
         }
+      }
+
+      /* Replace the Track's segments with the new segment array */
+      track->clearSegments();
+      for (int s=0; s < num_new_segments; s++)
+        track->addSegment(&new_segments[s]);
+    }
+  }
+
+  clearFSRVolumes();
+  recordMemoryUsage();
+}
+
+
+/**
+ * @brief Records the memory used by the Tracks and segments and by the
+ *        Geometry's FSR maps with the MemoryTracker.
+ * @details The FSR maps are recorded here since they are filled as the
+ *          Tracks are segmented or read from a Track file. The MemoryTracker
+ *          raises an error if the Tracks exceed the memory budget.
+ */
+void TrackGenerator::recordMemoryUsage() {
+
+  size_t num_bytes = _num_azim * (3 * sizeof(int) + sizeof(FP_PRECISION) +
+                                  sizeof(Track*));
+
+  for (int i=0; i < _num_azim; i++) {
+    num_bytes += _num_tracks[i] * sizeof(Track);
+    for (int j=0; j < _num_tracks[i]; j++)
+      num_bytes += _tracks[i][j].getNumSegments() * sizeof(segment);
+  }
+
+  MemoryTracker* tracker = MemoryTracker::Get();
+  tracker->update(GEOMETRY_MEMORY, _FSR_memory,
+                  _geometry->getFSRMemoryUsage());
+  tracker->update(TRACK_MEMORY, _track_memory, num_bytes);
 
-        /* Remove the original segment from the Track */
-        _tracks[i][j].removeSegment(s);
+  log_printf(INFO, "Tracks and segments require %1.2E MB and the FSR maps "
+             "require %1.2E MB", _track_memory / 1.E6, _FSR_memory / 1.E6);
+}
+
+
+/**
+ * @brief Replaces a Material in all Cells, FSRs and segments which it fills.
+ * @details This allows the cross-sections to be changed between eigenvalue
+ *          calculations (e.g., for branch cases) without regenerating or
+ *          reloading the Tracks. The new Material should have the same
+ *          number of energy groups. This can be called from Python as:
+ *
+ * @code
+ *          track_generator.rebindMaterial(fuel.getId(), hot_fuel)
+ * @endcode
+ *
+ * @param material_id the ID of the Material to replace
+ * @param material a pointer to the new Material
+ */
+void TrackGenerator::rebindMaterial(int material_id, Material* material) {
+
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to rebind Material %d since tracks have not "
+               "yet been generated", material_id);
+
+  /* Find all FSRs filled by the Material */
+  std::vector<int> FSRs_to_material_IDs = _geometry->getFSRsToMaterialIDs();
+  std::vector<int> fsr_ids;
+
+  for (size_t r=0; r < FSRs_to_material_IDs.size(); r++) {
+    if (FSRs_to_material_IDs[r] == material_id)
+      fsr_ids.push_back(r);
+  }
+
+  if (fsr_ids.size() == 0) {
+    log_printf(WARNING, "Unable to rebind Material %d since it does not "
+               "fill any FSRs", material_id);
+    return;
+  }
+
+  /* Fill each Cell which contained the Material with the new Material */
+  std::map<int, Cell*> cells = _geometry->getAllMaterialCells();
+  std::map<int, Cell*>::iterator iter;
+
+  for (iter = cells.begin(); iter != cells.end(); ++iter) {
+    if (iter->second->getFillMaterial()->getId() == material_id)
+      iter->second->setFill(material);
+  }
+
+  rebindFSRMaterials(&fsr_ids[0], fsr_ids.size(), material);
+}
+
+
+/**
+ * @brief Assigns a Material to some FSRs and to all segments within them.
+ * @details The FSR-to-Material map in the Geometry and each segment's
+ *          Material pointer are updated in place. This can be called
+ *          from Python with a NumPy array of FSR IDs as follows:
+ *
+ * @code
+ *          track_generator.rebindFSRMaterials(numpy.array(fsr_ids), material)
+ * @endcode
+ *
+ * @param fsr_ids an array of FSR IDs
+ * @param num_fsr_ids the number of FSR IDs
+ * @param material a pointer to the Material to fill the FSRs
+ */
+void TrackGenerator::rebindFSRMaterials(int* fsr_ids, int num_fsr_ids,
+                                        Material* material) {
+
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to rebind FSR Materials since tracks have not "
+               "yet been generated");
+
+  if (material == NULL)
+    log_printf(ERROR, "Unable to rebind FSR Materials to a NULL Material");
+
+  int num_groups = _geometry->getNumEnergyGroups();
+
+  if (material->getNumEnergyGroups() != num_groups)
+    log_printf(ERROR, "Unable to rebind FSR Materials to Material %d with %d "
+               "energy groups since the Geometry has %d energy groups",
+               material->getId(), material->getNumEnergyGroups(), num_groups);
+
+  /* Update the Geometry's FSR-to-Material map */
+  int num_FSRs = _geometry->getNumFSRs();
+  std::vector<Material*> FSR_materials(num_FSRs, (Material*)NULL);
+
+  _geometry->setFSRMaterials(fsr_ids, num_fsr_ids, material);
+
+  for (int i=0; i < num_fsr_ids; i++)
+    FSR_materials[fsr_ids[i]] = material;
+
+  /* Update the Material of each segment in the FSRs */
+  for (int i=0; i < _num_azim; i++) {
+
+    #pragma omp parallel for schedule(guided)
+    for (int j=0; j < _num_tracks[i]; j++) {
+
+      segment* segments = _tracks[i][j].getSegments();
+
+      for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
+        if (FSR_materials[segments[s]._region_id] != NULL)
+          segments[s]._material = FSR_materials[segments[s]._region_id];
       }
     }
   }
@@ -11,17 +11,189 @@
 
 #ifdef __cplusplus
 #define _USE_MATH_DEFINES
-#include "Python.h"
 #include "Track.h"
 #include "Geometry.h"
+#include "Timer.h"
+#include "MemoryTracker.h"
+#include "checksum.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <unistd.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
 #include <omp.h>
 #endif
 
 
+/** The magic string at the start of a versioned binary Track file */
+#define TRACK_FILE_MAGIC "OMOCTRK"
+
+/** The current version of the binary Track file format */
+#define TRACK_FILE_VERSION 3
+
+/** The byte order marker of a binary Track file, which reads as
+ *  0x04030201 on a machine with the opposite byte order to the writer */
+#define TRACK_FILE_BYTE_ORDER 0x01020304
+
+/** The byte alignment for each section in the binary Track file */
+#define TRACK_FILE_ALIGNMENT 64
+
+
+/**
+ * @enum trackFileSection
+ * @brief The types of data sections stored in a binary Track file.
+ */
+enum trackFileSection {
+
+  /** The number of Tracks and quadrature weight for each azimuthal angle */
+  AZIM_DATA,
+
+  /** The start and end points and segment ranges for each Track */
+  TRACK_DATA,
+
+  /** The segments for all Tracks stored contiguously */
+  SEGMENT_DATA,
+
+  /** The FSR key, ID, centroid and Material ID for each FSR */
+  FSR_DATA,
+
+  /** The number of FSRs in each CMFD mesh cell */
+  CMFD_CELL_SIZES,
+
+  /** The FSR IDs in each CMFD mesh cell stored contiguously */
+  CMFD_CELL_FSRS
+};
+
+
+/**
+ * @struct track_file_header
+ * @brief The fixed size header at the start of a binary Track file.
+ */
+struct track_file_header {
+
+  /** The magic string identifying the file format */
+  char _magic[8];
+
+  /** The byte order marker (TRACK_FILE_BYTE_ORDER) */
+  uint32_t _byte_order;
+
+  /** The version of the file format */
+  uint32_t _version;
+
+  /** The number of entries in the section table after the header */
+  uint32_t _num_sections;
+
+  /** Padding to align the next field to 8 bytes */
+  uint32_t _padding;
+
+  /** The total size of the file in bytes */
+  uint64_t _file_size;
+
+  /** Number of azimuthal angles in \f$ [0, \pi] \f$ */
+  int32_t _num_azim;
+
+  /** The number of FSRs in the Geometry */
+  int32_t _num_FSRs;
+
+  /** The track spacing (cm) */
+  double _spacing;
+
+  /** The structural hash of the Geometry used to generate the Tracks */
+  uint64_t _geometry_hash;
+
+  /** The Material hash of the Geometry used to generate the Tracks */
+  uint64_t _material_hash;
+
+  /** The total number of Tracks */
+  uint64_t _num_tracks;
+
+  /** The total number of segments */
+  uint64_t _num_segments;
+
+  /** The checksum of the section table */
+  uint64_t _checksum;
+};
+
+
+/**
+ * @struct track_file_section
+ * @brief An entry in the section table of a binary Track file.
+ */
+struct track_file_section {
+
+  /** The type of the section (a trackFileSection) */
+  uint32_t _type;
+
+  /** The size in bytes of each record in the section */
+  uint32_t _record_size;
+
+  /** The byte offset of the section from the start of the file */
+  uint64_t _offset;
+
+  /** The number of records in the section */
+  uint64_t _num_records;
+
+  /** The size in bytes of the section including padding */
+  uint64_t _num_bytes;
+
+  /** The checksum of the section including padding */
+  uint64_t _checksum;
+};
+
+
+/**
+ * @struct track_record
+ * @brief The on-disk representation of a Track.
+ */
+struct track_record {
+  double _x0, _y0, _x1, _y1, _phi;
+  int32_t _azim_index;
+  int32_t _num_segments;
+  uint64_t _first_segment;
+};
+
+
+/**
+ * @struct segment_record
+ * @brief The on-disk representation of a segment.
+ */
+struct segment_record {
+  double _length;
+  int32_t _material_id;
+  int32_t _region_id;
+  int32_t _cmfd_surface_fwd;
+  int32_t _cmfd_surface_bwd;
+};
+
+
+/**
+ * @struct fsr_record
+ * @brief The on-disk representation of the FSR maps for one FSR.
+ */
+struct fsr_record {
+  uint64_t _key;
+  uint64_t _FSR_to_key;
+  double _x, _y;
+  int32_t _fsr_id;
+  int32_t _material_id;
+};
+
+
+/**
+ * @struct azim_record
+ * @brief The on-disk representation of the Tracks for an azimuthal angle.
+ */
+struct azim_record {
+  int32_t _num_tracks;
+  int32_t _num_x;
+  int32_t _num_y;
+  int32_t _padding;
+  double _azim_weight;
+};
+
+
 /**
  * @class TrackGenerator TrackGenerator.h "src/TrackGenerator.h"
  * @brief The TrackGenerator is dedicated to generating and storing Tracks
@@ -71,6 +243,15 @@ private:
   /** Boolean whether the Tracks have been generated (true) or not (false) */
   bool _contains_tracks;
 
+  /** A cached array of FSR volumes computed from the Track segments */
+  FP_PRECISION* _FSR_volumes;
+
+  /** The bytes of Tracks and segments recorded with the MemoryTracker */
+  size_t _track_memory;
+
+  /** The bytes of Geometry FSR maps recorded with the MemoryTracker */
+  size_t _FSR_memory;
+
   void computeEndPoint(Point* start, Point* end,  const double phi,
                        const double width, const double height);
 
@@ -81,6 +262,12 @@ private:
   void segmentize();
   void dumpTracksToFile();
   bool readTracksFromFile();
+  bool readMappedTracksFromFile();
+  bool readLegacyTracksFromFile();
+  void resetFSRMaterials();
+  void initializeFSRVolumes();
+  void clearFSRVolumes();
+  void recordMemoryUsage();
 
 public:
 
@@ -114,6 +301,8 @@ public:
   void generateTracks();
   void correctFSRVolume(int fsr_id, FP_PRECISION fsr_volume);
   void splitSegments(FP_PRECISION max_optical_length);
+  void rebindMaterial(int material_id, Material* material);
+  void rebindFSRMaterials(int* fsr_ids, int num_fsr_ids, Material* material);
 };
 
 #endif /* TRACKGENERATOR_H_ */
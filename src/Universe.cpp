@@ -818,7 +818,7 @@ double Lattice::getWidthY() const {
  * @return the minimum reachable x-coordinate
  */
 double Lattice::getMinX() {
-  return _offset.getX() - (_num_x + _width_x / 2.);
+  return _offset.getX() - (_num_x * _width_x / 2.);
 }
 
 
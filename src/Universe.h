@@ -9,7 +9,6 @@
 #define UNIVERSE_H_
 
 #ifdef __cplusplus
-#include "Python.h"
 #include "constants.h"
 #include "LocalCoords.h"
 #include "boundary_type.h"
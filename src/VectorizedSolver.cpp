@@ -142,6 +142,34 @@ void VectorizedSolver::setGeometry(Geometry* geometry) {
 }
 
 
+/**
+ * @brief Replaces a Material everywhere it fills the Geometry.
+ * @details The new Material's cross-sections are aligned for SIMD
+ *          vectorization before it is assigned to the FSRs.
+ * @param material_id the ID of the Material to replace
+ * @param material a pointer to the new Material
+ */
+void VectorizedSolver::rebindMaterial(int material_id, Material* material) {
+  material->alignData();
+  CPUSolver::rebindMaterial(material_id, material);
+}
+
+
+/**
+ * @brief Assigns a Material to some FSRs.
+ * @details The new Material's cross-sections are aligned for SIMD
+ *          vectorization before it is assigned to the FSRs.
+ * @param fsr_ids an array of FSR IDs
+ * @param num_fsr_ids the number of FSR IDs
+ * @param material a pointer to the Material to fill the FSRs
+ */
+void VectorizedSolver::rebindFSRMaterials(int* fsr_ids, int num_fsr_ids,
+                                          Material* material) {
+  material->alignData();
+  CPUSolver::rebindFSRMaterials(fsr_ids, num_fsr_ids, material);
+}
+
+
 /**
  * @brief Allocates memory for the exponential linear interpolation table.
  */
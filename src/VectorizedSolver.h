@@ -77,6 +77,8 @@ public:
   void setFixedSourceByFSR(int fsr_id, int group, 
                            FP_PRECISION source);
   void setGeometry(Geometry* geometry);
+  void rebindMaterial(int material_id, Material* material);
+  void rebindFSRMaterials(int* fsr_ids, int num_fsr_ids, Material* material);
 };
 
 
@@ -11,7 +11,6 @@
 #define GPUQUERY_H_
 
 #ifdef __cplusplus
-#include "Python.h"
 #include "../../log.h"
 #endif
 
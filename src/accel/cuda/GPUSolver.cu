@@ -854,6 +854,47 @@ void GPUSolver::setTrackGenerator(TrackGenerator* track_generator) {
 }
 
 
+/**
+ * @brief Replaces a Material everywhere it fills the Geometry.
+ * @details The Materials and Tracks are copied to the GPU again since the
+ *          segments on the device store Material indices.
+ * @param material_id the ID of the Material to replace
+ * @param material a pointer to the new Material
+ */
+void GPUSolver::rebindMaterial(int material_id, Material* material) {
+
+  Solver::rebindMaterial(material_id, material);
+
+  _num_materials = _geometry->getNumMaterials();
+  initializeMaterials();
+  initializeTracks();
+}
+
+
+/**
+ * @brief Assigns a Material to some FSRs.
+ * @details The Material must already fill some Cell in the Geometry since
+ *          the Materials on the GPU are indexed from the Geometry's Cells.
+ * @param fsr_ids an array of FSR IDs
+ * @param num_fsr_ids the number of FSR IDs
+ * @param material a pointer to the Material to fill the FSRs
+ */
+void GPUSolver::rebindFSRMaterials(int* fsr_ids, int num_fsr_ids,
+                                   Material* material) {
+
+  std::map<int, Material*> materials = _geometry->getAllMaterials();
+
+  if (materials.find(material->getId()) == materials.end())
+    log_printf(ERROR, "Unable to rebind FSRs to Material %d on the GPU since "
+               "it does not fill any Cell in the Geometry", material->getId());
+
+  Solver::rebindFSRMaterials(fsr_ids, num_fsr_ids, material);
+
+  initializeMaterials();
+  initializeTracks();
+}
+
+
 /**
  * @brief Creates a polar quadrature object for the GPUSolver on the GPU.
  */
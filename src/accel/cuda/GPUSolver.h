@@ -9,13 +9,10 @@
 #define GPUSOLVER_H_
 
 #ifdef __cplusplus
-#include "Python.h"
 #include "../../constants.h"
 #include "../../Solver.h"
 #endif
 
-#define PySys_WriteStdout printf
-
 #include <thrust/device_vector.h>
 #include <thrust/copy.h>
 #include <thrust/fill.h>
@@ -139,6 +136,8 @@ public:
                            FP_PRECISION source);
   void setGeometry(Geometry* geometry);
   void setTrackGenerator(TrackGenerator* track_generator);
+  void rebindMaterial(int material_id, Material* material);
+  void rebindFSRMaterials(int* fsr_ids, int num_fsr_ids, Material* material);
 
   void computeFSRFissionRates(double* fission_rates, int num_FSRs);
 };
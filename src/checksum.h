@@ -0,0 +1,50 @@
+/**
+ * @file checksum.h
+ * @brief Utility function for the checksums of binary Track and checkpoint
+ *        files and the Geometry hashes stored in them.
+ * @date October 18, 2026
+ */
+
+#ifndef CHECKSUM_H_
+#define CHECKSUM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/** The initial value of an FNV-1a checksum */
+#define FNV1A_OFFSET_BASIS 14695981039346656037ULL
+
+/**
+ * @brief Computes a checksum over an array of 64-bit words.
+ * @details This is a word-wise variant of the FNV-1a hash which is used to
+ *          detect corrupt or truncated binary files. It hashes one 64-bit
+ *          word at a time so that it keeps up with writing and reading
+ *          multi-GB flux arrays, and hashes any bytes after the last whole
+ *          word one at a time.
+ * @param data a pointer to the (8-byte aligned) data
+ * @param num_bytes the number of bytes to include in the checksum
+ * @param checksum the checksum of any preceding data
+ * @return the updated checksum
+ */
+inline uint64_t fnv1a_checksum(const void* data, size_t num_bytes,
+                               uint64_t checksum=FNV1A_OFFSET_BASIS) {
+
+  const uint64_t* words = (const uint64_t*) data;
+  size_t num_words = num_bytes / sizeof(uint64_t);
+
+  for (size_t i=0; i < num_words; i++) {
+    checksum ^= words[i];
+    checksum *= 1099511628211ULL;
+  }
+
+  const unsigned char* bytes = (const unsigned char*) &words[num_words];
+
+  for (size_t i=0; i < num_bytes % sizeof(uint64_t); i++) {
+    checksum ^= bytes[i];
+    checksum *= 1099511628211ULL;
+  }
+
+  return checksum;
+}
+
+#endif /* CHECKSUM_H_ */
@@ -5,6 +5,9 @@
  * @date August 26, 2014
  */
 
+#include <math.h>
+#include <algorithm>
+
 /**
  * @brief Copy a vector to another vector.
  * @param vector_from vector to be copied
@@ -21,68 +24,244 @@ inline void vector_copy(T* vector_from, T* vector_to, int length){
 
 /**
  * @brief Assign all elements in a matrix to zero.
- * @param matrix matrix to be zeroed
- * @param width width of matrix row
- * @param length length of matrix column
+ * @param vector vector to be zeroed
+ * @param length length of vector
  */
 template <typename T>
-inline void matrix_zero(T** matrix, int width, int length){
+inline void vector_zero(T* vector, int length){
 
-  for (int i = 0; i < length; i++){
-    for (int g = 0; g < width; g++)
-      matrix[i][g] = 0.0;
-  }
+  for (int i = 0; i < length; i++)
+    vector[i] = 0.0;
 }
 
 
 /**
- * @brief Assign all elements in a matrix to zero.
- * @param vector vector to be zeroed
- * @param length length of vector
+ * @brief Scale vectgor by some scalar value.
+ * @param vector vector to be scaled
+ * @param scale_value value to scale vector
+ * @param length vector length
  */
 template <typename T>
-inline void vector_zero(T* vector, int length){
+inline void vector_scale(T* vector, T scale_value, int length){
 
   for (int i = 0; i < length; i++)
-    vector[i] = 0.0;
+    vector[i] *= scale_value;
 }
 
 
 /**
- * @brief Multiply matrix by vector (i.e., y = M *x).
- * @param matrix source matrix
+ * @brief Compute the dot product of two vectors.
  * @param vector_x x vector
  * @param vector_y y vector
- * @param num_blocks number of cell blocks in M matrix.
- * @param block_width number of elements in cell blocks in M matrix.
+ * @param length vector length
+ * @return the dot product
+ */
+template <typename T>
+inline T vector_dot(T* vector_x, T* vector_y, long length){
+
+  T dot = 0.0;
+
+  #pragma omp parallel for reduction(+:dot) schedule(static)
+  for (long i = 0; i < length; i++)
+    dot += vector_x[i] * vector_y[i];
+
+  return dot;
+}
+
+
+/**
+ * @brief Compute the L2 norm of a vector.
+ * @param vector vector
+ * @param length vector length
+ * @return the L2 norm
  */
 template <typename T>
-inline void matrix_multiplication(T** matrix, T* vector_x, 
-                                  T* vector_y, int num_blocks, 
-                                  int block_width){
-
-  vector_zero(vector_y, num_blocks*block_width); 
-
-  for (int i = 0; i < num_blocks; i++){
-    for (int g = 0; g < block_width; g++){
-      for (int e = 0; e < block_width; e++){
-        vector_y[i*block_width+g] += matrix[i][g*block_width+e] 
-            * vector_x[i*block_width+e];
-      }
+inline T vector_norm(T* vector, long length){
+  return sqrt(vector_dot(vector, vector, length));
+}
+
+
+/**
+ * @brief Solve a small dense linear system in place (i.e., A x = b).
+ * @details Uses Gaussian elimination with partial pivoting. The matrix is
+ *          overwritten and the solution is stored in the right hand side.
+ * @param matrix row-major square matrix
+ * @param vector right hand side, replaced by the solution
+ * @param size number of rows in the matrix
+ * @return false if the matrix is numerically singular, true otherwise
+ */
+template <typename T>
+inline bool dense_solve(T* matrix, T* vector, int size){
+
+  for (int k = 0; k < size; k++){
+
+    /* Find the pivot row */
+    int pivot = k;
+    for (int i = k+1; i < size; i++){
+      if (fabs(matrix[i*size+k]) > fabs(matrix[pivot*size+k]))
+        pivot = i;
+    }
+
+    if (fabs(matrix[pivot*size+k]) <= 1E-14 * fabs(matrix[0]))
+      return false;
+
+    /* Swap the pivot row into place */
+    if (pivot != k){
+      for (int j = 0; j < size; j++)
+        std::swap(matrix[k*size+j], matrix[pivot*size+j]);
+      std::swap(vector[k], vector[pivot]);
+    }
+
+    /* Eliminate the column below the pivot */
+    for (int i = k+1; i < size; i++){
+      T factor = matrix[i*size+k] / matrix[k*size+k];
+      for (int j = k; j < size; j++)
+        matrix[i*size+j] -= factor * matrix[k*size+j];
+      vector[i] -= factor * vector[k];
     }
   }
+
+  /* Back substitution */
+  for (int i = size-1; i >= 0; i--){
+    for (int j = i+1; j < size; j++)
+      vector[i] -= matrix[i*size+j] * vector[j];
+    vector[i] /= matrix[i*size+i];
+  }
+
+  return true;
 }
 
 
 /**
- * @brief Scale vectgor by some scalar value.
- * @param vector vector to be scaled
- * @param scale_value value to scale vector
- * @param length vector length
+ * @brief Compute the coefficients for a step of Chebyshev extrapolation of
+ *        a power iteration (i.e., \f$ x_{n+1} = G(x_n) \f$).
+ * @details The extrapolated iterate is
+ *          \f$ x_{n+1} = x_n + \alpha (G(x_n) - x_n) + \beta (x_n - x_{n-1})
+ *          \f$, which reduces the error in each higher mode over a cycle of
+ *          p steps by the Chebyshev polynomial of degree p on the interval
+ *          from zero to the dominance ratio.
+ * @param step the step in the Chebyshev cycle (starting from 1)
+ * @param dominance_ratio the estimated dominance ratio (between 0 and 1)
+ * @param alpha the coefficient of the new iterate's residual
+ * @param beta the coefficient of the previous iterate's difference
+ */
+inline void chebyshev_coefficients(int step, double dominance_ratio,
+                                   double* alpha, double* beta){
+
+  if (step == 1){
+    *alpha = 2.0 / (2.0 - dominance_ratio);
+    *beta = 0.0;
+    return;
+  }
+
+  double gamma = acosh(2.0 / dominance_ratio - 1.0);
+  *alpha = 4.0 / dominance_ratio * cosh((step-1) * gamma) / cosh(step * gamma);
+  *beta = (1.0 - dominance_ratio / 2.0) * (*alpha) - 1.0;
+}
+
+
+/**
+ * @brief Compute the dominance ratio for which a Chebyshev cycle would
+ *        reduce the error by a given factor.
+ * @param num_steps the number of steps in the Chebyshev cycle
+ * @param reduction the ratio of the residuals after and before the cycle
+ * @return the dominance ratio (1 if the residual was not reduced)
+ */
+inline double chebyshev_dominance_ratio(int num_steps, double reduction){
+
+  if (reduction >= 1.0)
+    return 1.0;
+
+  double gamma = acosh(1.0 / reduction) / num_steps;
+  return 2.0 / (cosh(gamma) + 1.0);
+}
+
+
+/**
+ * @brief Advance Chebyshev extrapolation of a power iteration to the next
+ *        iterate.
+ * @details After a restart, power iterations are performed until two
+ *          successive ratios of residuals, which estimate the dominance
+ *          ratio, agree to within 5%. Cycles of extrapolated steps then
+ *          follow, at the end of each of which the dominance ratio is
+ *          increased if the residual was reduced by less than predicted.
+ *          Extrapolation is restarted if the residual grows to twice its
+ *          value at the start of a cycle or is not reduced over a cycle.
+ * @param step the step in the Chebyshev cycle of the previous iterate
+ *        (0 for a power iteration)
+ * @param order the number of steps in each Chebyshev cycle
+ * @param num_power_iterations the number of power iterations since the
+ *        last restart
+ * @param residual the norm of the residual of the new iterate
+ * @param last_residual the norm of the residual of the previous iterate
+ * @param cycle_residual the norm of the residual at the start of the cycle
+ * @param dominance_ratio the estimated dominance ratio
+ * @return the step in the Chebyshev cycle for the new iterate (0 for a
+ *         power iteration)
+ */
+inline int chebyshev_next_step(int step, int order, int* num_power_iterations,
+                               double residual, double* last_residual,
+                               double* cycle_residual,
+                               double* dominance_ratio){
+
+  int next_step = 0;
+
+  /* Estimate the dominance ratio from successive power iterations */
+  if (step == 0){
+    double ratio = *dominance_ratio;
+    if ((*num_power_iterations)++ > 0)
+      *dominance_ratio = residual / *last_residual;
+
+    if (*num_power_iterations > 2 && *dominance_ratio > 0.0 &&
+        *dominance_ratio < 1.0 &&
+        fabs(*dominance_ratio - ratio) < 0.05 * (*dominance_ratio)){
+      next_step = 1;
+      *cycle_residual = residual;
+    }
+  }
+
+  /* Refit the dominance ratio to the error reduction over the cycle */
+  else if (step == order && residual <= 2.0 * (*cycle_residual)){
+    double ratio = chebyshev_dominance_ratio(order,
+                                             residual / *cycle_residual);
+    if (ratio < 1.0){
+      *dominance_ratio = std::max(*dominance_ratio, ratio);
+      next_step = 1;
+      *cycle_residual = residual;
+    }
+  }
+  else if (step < order && residual <= 2.0 * (*cycle_residual))
+    next_step = step + 1;
+
+  /* Restart with power iterations */
+  if (step > 0 && next_step == 0)
+    *num_power_iterations = 0;
+
+  *last_residual = residual;
+  return next_step;
+}
+
+
+/**
+ * @brief Estimate the dominance ratio of a power iteration from the
+ *        asymptotic reduction of its residuals.
+ * @details The estimate is the geometric mean of the ratios of successive
+ *          residuals over the last five iterations (i.e.,
+ *          \f$ (r_n / r_{n-5})^{1/5} \f$), which tends to the dominance
+ *          ratio once the higher modes have decayed.
+ * @param residuals the residuals of the power iterations
+ * @param num_residuals the number of residuals
+ * @return the dominance ratio (0 if there are too few residuals)
  */
 template <typename T>
-inline void vector_scale(T* vector, T scale_value, int length){
+inline double residual_dominance_ratio(T* residuals, int num_residuals){
 
-  for (int i = 0; i < length; i++)
-    vector[i] *= scale_value;
+  int num_steps = 5;
+
+  if (num_residuals <= num_steps ||
+      residuals[num_residuals-1-num_steps] <= 0.0)
+    return 0.0;
+
+  return pow(double(residuals[num_residuals-1]) /
+             residuals[num_residuals-1-num_steps], 1.0 / num_steps);
 }
@@ -4,13 +4,16 @@
 
 #define LOG_C
 
+/* Calls in this file are not filtered by the log_printf(...) macro */
+#undef log_printf
+
 
 /**
  * @var log_level
  * @brief Minimum level of logging messages printed to the screen and log file.
  * @details The default logging level is NORMAL.
  */
-static logLevel log_level = NORMAL;
+logLevel log_level = NORMAL;
 
 
 /**
@@ -70,10 +73,66 @@ static int line_length = 67;
 
 
 /**
- * @var log_error_lock
- * @brief OpenMP mutex lock for ERROR messages which throw exceptions
+ * @var log_file
+ * @brief The output log file, which is opened when the first message is
+ *        written to it.
+ */
+static std::ofstream log_file;
+
+
+/**
+ * @var log_buffer
+ * @brief Formatted messages waiting to be written to the screen and log file.
+ * @details Each message reserves its space in the buffer with an atomic
+ *          increment of log_buffer_length, such that threads buffer messages
+ *          without locks. Messages which do not fit are dropped and counted.
+ */
+static char log_buffer[LOG_BUFFER_SIZE];
+
+
+/**
+ * @var log_buffer_length
+ * @brief The number of characters reserved in the log buffer.
+ */
+static int log_buffer_length = 0;
+
+
+/**
+ * @var log_num_dropped
+ * @brief The number of messages which did not fit in the log buffer.
+ */
+static int log_num_dropped = 0;
+
+
+/**
+ * @brief Writes log messages to stdout.
+ * @param messages the characters of the messages
+ * @param length the number of characters to write
+ */
+static void write_stdout(const char* messages, int length) {
+  fwrite(messages, sizeof(char), length, stdout);
+  fflush(stdout);
+}
+
+
+/**
+ * @var log_writer
+ * @brief The function which writes log messages to the screen.
+ */
+static logWriter log_writer = write_stdout;
+
+
+/**
+ * @brief Sets the function which writes log messages to the screen.
+ * @details This lets a program which embeds OpenMOC redirect the messages,
+ *          as the Python module does to print them through the interpreter.
+ *          Messages are still written to the log file. A NULL writer
+ *          restores the default, which writes to stdout.
+ * @param writer the function to write the log messages
  */
-static omp_lock_t log_error_lock;
+void set_log_writer(logWriter writer) {
+  log_writer = (writer != NULL) ? writer : write_stdout;
+}
 
 
 /**
@@ -92,8 +151,9 @@ void set_output_directory(char* directory) {
     mkdir((output_directory+"/log").c_str(), S_IRWXU);
   }
 
-  /* Initialize OpenMP mutex lock for ERROR messages with exceptions */
-  omp_init_lock(&log_error_lock);
+  /* Reopen the log file in the new directory */
+  if (log_file.is_open())
+    log_file.close();
 
   return;
 }
@@ -113,7 +173,12 @@ const char* get_output_directory() {
  * @param filename a character array for log filename
  */
 void set_log_filename(char* filename) {
+
   log_filename = std::string(filename);
+
+  /* Reopen the log file with the new name */
+  if (log_file.is_open())
+    log_file.close();
 }
 
 
@@ -242,6 +307,11 @@ void set_log_level(const char* new_level) {
       log_printf(INFO, "Logging level set to ERROR");
   }
 
+  if (log_level < LOG_MIN_LEVEL)
+    log_printf(WARNING, "Some log messages at this level were compiled out "
+               "of OpenMOC and will not be printed. Rebuild OpenMOC with "
+               "--debug-mode to print them.");
+
   return;
 }
 
@@ -255,10 +325,112 @@ int get_log_level(){
 }
 
 
+/**
+ * @brief Writes a message to the log file.
+ * @details The log file is opened the first time a message is written, and
+ *          the date and time are written at the top of a new log file.
+ * @param message the message to write
+ * @param length the number of characters in the message
+ */
+static void write_log_file(const char* message, int length) {
+
+  if (!log_file.is_open()) {
+
+    /* If output directory was not defined by user, then log file is
+     * written to a "log" subdirectory. Create it if it doesn't exist */
+    if (output_directory.compare(".") == 0) {
+      struct stat st;
+      if ((!stat("log", &st)) == 0)
+        mkdir("log", S_IRWXU);
+    }
+
+    log_file.open((output_directory + "/" + log_filename).c_str(),
+                  std::ios::app);
+
+    /* Append date, time to the top of log output file */
+    if (!logging) {
+      time_t rawtime;
+      struct tm * timeinfo;
+      time (&rawtime);
+      timeinfo = localtime (&rawtime);
+      log_file << "Current local time and date: " << asctime(timeinfo);
+      logging = true;
+    }
+  }
+
+  log_file.write(message, length);
+  log_file.flush();
+}
+
+
+/**
+ * @brief Adds a formatted message to the log buffer.
+ * @details The message reserves its space with an atomic increment, so that
+ *          threads may buffer messages concurrently without locks. A message
+ *          which does not fit in the buffer is dropped and counted.
+ * @param message the formatted message
+ */
+static void buffer_message(const std::string& message) {
+
+  int length = message.length();
+  int start;
+
+  #pragma omp atomic capture
+  {
+    start = log_buffer_length;
+    log_buffer_length += length;
+  }
+
+  if (start + length <= LOG_BUFFER_SIZE)
+    memcpy(&log_buffer[start], message.c_str(), length);
+  else {
+
+    /* Mark the end of the messages which fit in the buffer */
+    if (start < LOG_BUFFER_SIZE)
+      log_buffer[start] = '\0';
+
+    #pragma omp atomic
+    log_num_dropped++;
+  }
+}
+
+
+/**
+ * @brief Writes the buffered log messages to the screen and log file.
+ * @details Messages are flushed by each log_printf(...) call outside of an
+ *          OpenMP parallel region, so messages logged in a parallel region
+ *          are printed by the next message logged outside of it. This does
+ *          nothing if called from within a parallel region.
+ */
+void log_flush() {
+
+  if (omp_in_parallel())
+    return;
+
+  int length = std::min(log_buffer_length, LOG_BUFFER_SIZE);
+  length = strnlen(log_buffer, length);
+
+  if (length > 0) {
+    write_log_file(log_buffer, length);
+    log_writer(log_buffer, length);
+  }
+
+  log_buffer_length = 0;
+
+  if (log_num_dropped > 0) {
+    int num_dropped = log_num_dropped;
+    log_num_dropped = 0;
+    log_printf(WARNING, "Dropped %d log messages which did not fit in the "
+               "log buffer", num_dropped);
+  }
+}
+
+
 /**
  * @brief Print a formatted message to the console.
  * @details If the logging level is ERROR, this function will throw a
- *          runtime exception
+ *          runtime exception. Other messages are buffered without locks and
+ *          written to the screen and log file by log_flush().
  * @param level the logging level for this message
  * @param format variable list of C++ formatted arguments
  */
@@ -270,7 +442,7 @@ void log_printf(logLevel level, const char* format, ...) {
     va_list args;
 
     va_start(args, format);
-    vsprintf(message, format, args);
+    vsnprintf(message, sizeof(message), format, args);
     va_end(args);
 
     /* Append the log level to the message */
@@ -417,10 +589,6 @@ void log_printf(logLevel level, const char* format, ...) {
       }
     case (ERROR):
       {
-        /* Create message based on runtime error stack */
-        va_start(args, format);
-        vsprintf(message, format, args);
-        va_end(args);
         std::string msg = std::string(message);
         std::string level_prefix = "";
 
@@ -434,50 +602,15 @@ void log_printf(logLevel level, const char* format, ...) {
       }
     }
 
-    /* If this is our first time logging, add a header with date, time */
-    if (!logging) {
-
-      /* If output directory was not defined by user, then log file is
-       * written to a "log" subdirectory. Create it if it doesn't exist */
-      if (output_directory.compare(".") == 0) {
-        struct stat st;
-        if ((!stat("log", &st)) == 0)
-          mkdir("log", S_IRWXU);
-      }
-
-      /* Write the message to the output file */
-      std::ofstream log_file;
-      log_file.open((output_directory + "/" + log_filename).c_str(),
-                   std::ios::app);
-
-      /* Append date, time to the top of log output file */
-      time_t rawtime;
-      struct tm * timeinfo;
-      time (&rawtime);
-      timeinfo = localtime (&rawtime);
-      log_file << "Current local time and date: " << asctime(timeinfo);
-      logging = true;
-
-      log_file.close();
-    }
-
-    /* Write the log message to the log_file */
-    std::ofstream log_file;
-    log_file.open((output_directory + "/" + log_filename).c_str(),
-                  std::ios::app);
-    log_file << msg_string;
-    log_file.close();
-
-    /* Write the log message to the shell */
+    /* Write the message to the log file and throw an exception */
     if (level == ERROR) {
-      omp_set_lock(&log_error_lock);
-      {
-        throw std::logic_error(msg_string.c_str());
-      }
-      omp_unset_lock(&log_error_lock);
+      log_flush();
+      write_log_file(msg_string.c_str(), msg_string.length());
+      throw std::logic_error(msg_string.c_str());
     }
-    else 
-      printf("%s", msg_string.c_str());
+
+    buffer_message(msg_string);
+    log_flush();
   }
 }
 
@@ -493,6 +626,8 @@ void log_printf(logLevel level, const char* format, ...) {
  */
 std::string create_multiline_msg(std::string level, std::string message) {
 
+  /* Use a copy of the line length since threads may call this at once */
+  int line_length = ::line_length;
   int size = message.length();
 
   std::string substring;
@@ -536,8 +671,5 @@ std::string create_multiline_msg(std::string level, std::string message) {
     end += line_length + 1;
   }
 
-  /* Reset line length */
-  line_length += 4;
-
   return msg_string;
 }
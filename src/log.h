@@ -12,7 +12,6 @@
 #define LOG_H_
 
 #ifdef __cplusplus
-#include "Python.h"
 #include <stdio.h>
 #include <stdarg.h>
 #include <stdlib.h>
@@ -27,9 +26,29 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <omp.h>
+#include <algorithm>
 #endif
 
-#define printf PySys_WriteStdout
+
+/**
+ * @def LOG_MIN_LEVEL
+ * @brief The lowest level of log messages compiled into the C++ source.
+ * @details Calls to log_printf(...) from C++ below this level are removed by
+ *          the compiler, along with the evaluation of their arguments. The
+ *          default compiles in all messages. Release builds set this to INFO
+ *          to remove the DEBUG messages from hot loops.
+ */
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL DEBUG
+#endif
+
+
+/**
+ * @def LOG_BUFFER_SIZE
+ * @brief The number of characters of log messages which may be buffered
+ *        while in an OpenMP parallel region.
+ */
+#define LOG_BUFFER_SIZE 65536
 
 
 /**
@@ -105,7 +124,41 @@ void set_log_level(const char* new_level);
 int get_log_level();
 
 void log_printf(logLevel level, const char *format, ...);
+void log_flush();
 std::string create_multiline_msg(std::string level, std::string message);
 
 
+#ifndef SWIG
+
+/**
+ * @var logWriter
+ * @brief A function which writes log messages to the screen.
+ * @details The function is passed one or more complete lines of messages
+ *          which are not null-terminated, along with their length. The
+ *          default writes to stdout, and the Python module writes through
+ *          the interpreter's sys.stdout instead.
+ */
+typedef void (*logWriter)(const char* messages, int length);
+
+void set_log_writer(logWriter writer);
+
+/** The minimum level of log messages printed (see set_log_level(...)) */
+extern logLevel log_level;
+
+/**
+ * @brief Skips log_printf(...) calls, including the evaluation of their
+ *        arguments, for messages which would not be printed.
+ * @details Messages below LOG_MIN_LEVEL are removed at compile time and
+ *          messages below the log level are skipped at run time with a
+ *          single comparison. ERROR messages are never skipped.
+ */
+#define log_printf(level, ...) \
+  do { \
+    if ((level) >= LOG_MIN_LEVEL && (level) >= log_level) \
+      (log_printf)((level), __VA_ARGS__); \
+  } while (0)
+
+#endif
+
+
 #endif /* LOG_H_ */